@@ -15,6 +15,9 @@
 #include "context.hpp"
 #include "dispatcher.hpp"
 #include "ocl/ocl_engine.hpp"
+#include "host/host_engine.hpp"
+#include "environment.hpp"
+#include <cstdlib>
 
 namespace iclgpu
 {
@@ -24,9 +27,56 @@ std::shared_ptr<engine> context::get_engine(engine_type type)
 {
     switch (type)
     {
-    case engine_type::default_engine: return get_engine(_default_engine_type);
+    case engine_type::default_engine: return get_engine(get_default_engine_type());
     case engine_type::open_cl: return get<ocl_engine>();
+    case engine_type::host: return get<host_engine>();
     default: throw std::invalid_argument("unknown engine type");
     }
 }
+
+engine_type context::get_default_engine_type()
+{
+    const engine_type resolved = _default_engine_type;
+    if (resolved != engine_type::default_engine)
+        return resolved;
+
+    std::string name;
+    get_environment_variable("ICLGPU_ENGINE", name);
+    if (name == "opencl")
+        return _default_engine_type = engine_type::open_cl;
+    if (name == "host")
+        return _default_engine_type = engine_type::host;
+    if (!name.empty() && name != "auto")
+        throw std::invalid_argument("unknown ICLGPU_ENGINE value: " + name);
+
+    engine_type type = engine_type::open_cl;
+    try
+    {
+        get<ocl_engine>();
+    }
+    catch (const std::exception&)
+    {
+        // No OpenCL platform or device, e.g. CPU-only machine
+        type = engine_type::host;
+    }
+    return _default_engine_type = type;
+}
+
+size_t context::get_device()
+{
+    const size_t resolved = _device;
+    if (resolved != default_device)
+        return resolved;
+
+    std::string value;
+    size_t device = 0;
+    if (get_environment_variable("ICLGPU_DEVICE", value) && !value.empty())
+    {
+        char* end = nullptr;
+        device = std::strtoul(value.c_str(), &end, 10);
+        if (*end != '\0')
+            throw std::invalid_argument("ICLGPU_DEVICE should be device index: " + value);
+    }
+    return _device = device;
+}
 }
@@ -0,0 +1,152 @@
+// Copyright (c) 2017-2018 Intel Corporation
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//      http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "device_group.hpp"
+#include "ocl/ocl_engine.hpp"
+#include "environment.hpp"
+#include <cstdlib>
+#include <sstream>
+#include <stdexcept>
+
+namespace iclgpu
+{
+device_group::device_group(const std::shared_ptr<iclgpu::context>& ctx)
+    : element(ctx)
+{
+    std::string devices;
+    if (!get_environment_variable("ICLGPU_DEVICES", devices) || devices.empty())
+        return;
+
+    std::vector<size_t> indices;
+    if (devices == "all")
+    {
+        const auto count = ocl_engine::get_device_names().size();
+        for (size_t device = 0; device < count; ++device)
+            indices.push_back(device);
+    }
+    else
+    {
+        std::istringstream stream(devices);
+        std::string device;
+        while (std::getline(stream, device, ','))
+        {
+            char* end = nullptr;
+            auto index = std::strtoul(device.c_str(), &end, 10);
+            if (device.empty() || *end != '\0')
+                throw std::invalid_argument("ICLGPU_DEVICES should be 'all' or list of device indices: " + devices);
+            indices.push_back(index);
+        }
+    }
+    set_devices(indices);
+}
+
+void device_group::set_devices(const std::vector<size_t>& devices)
+{
+    // The first occurrence of the context device is the context itself
+    const auto own_device = context()->get_device();
+    std::vector<size_t> others;
+    bool own_found = false;
+    for (auto device : devices)
+    {
+        if (device == own_device && !own_found)
+            own_found = true;
+        else
+            others.push_back(device);
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _devices = others;
+    _contexts.clear();
+    _weights.clear();
+}
+
+size_t device_group::size()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _devices.size() + 1;
+}
+
+std::shared_ptr<iclgpu::context> device_group::get_context(size_t index)
+{
+    if (index == 0)
+        return context();
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (index > _devices.size())
+        throw std::invalid_argument("Device group member " + std::to_string(index) + " does not exist");
+
+    _contexts.resize(_devices.size());
+    auto& child = _contexts[index - 1];
+    if (!child)
+    {
+        child = context::create(_devices[index - 1]);
+        // Children work alone, the parent distributes work
+        child->get<device_group>()->set_devices({ child->get_device() });
+        if (_initializer)
+            _initializer(child);
+    }
+    return child;
+}
+
+void device_group::set_context_initializer(const initializer_type& initializer)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _initializer = initializer;
+}
+
+float device_group::get_weight(size_t index)
+{
+    auto ocl = std::dynamic_pointer_cast<ocl_engine>(get_context(index)->get_engine());
+    return ocl ? ocl->get_device_weight() : 1.f;
+}
+
+std::vector<size_t> device_group::split(size_t count, size_t granularity)
+{
+    const auto members = size();
+    std::vector<float> weights;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        weights = _weights;
+    }
+    if (weights.size() != members)
+    {
+        weights.clear();
+        for (size_t i = 0; i < members; ++i)
+            weights.push_back(get_weight(i));
+        std::lock_guard<std::mutex> lock(_mutex);
+        _weights = weights;
+    }
+
+    double total = 0;
+    for (auto weight : weights)
+        total += weight;
+
+    // Part boundaries are rounded to the granularity, so the last non-empty part gets the remainder
+    std::vector<size_t> parts(members, 0);
+    const size_t units = (count + granularity - 1) / granularity;
+    double accumulated = 0;
+    size_t begin = 0;
+    for (size_t i = 0; i < members; ++i)
+    {
+        accumulated += weights[i];
+        auto end = i + 1 == members ? count
+                 : std::min(count, static_cast<size_t>(units * accumulated / total + 0.5) * granularity);
+        end = std::max(end, begin);
+        parts[i] = end - begin;
+        begin = end;
+    }
+    return parts;
+}
+
+} // namespace iclgpu
@@ -0,0 +1,127 @@
+// Copyright (c) 2017-2018 Intel Corporation
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//      http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "engine.hpp"
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <new>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace iclgpu
+{
+
+namespace
+{
+struct device_memory_entry
+{
+    size_t                  reserved_size;
+    std::shared_ptr<buffer> buf;
+    const void*             owner;
+};
+
+struct device_memory_registry
+{
+    std::mutex                                 mutex;
+    std::map<uintptr_t, device_memory_entry>   entries;
+    // Checked without the lock: host pointers are looked up on every call
+    std::atomic<size_t>                        count{0};
+};
+
+// Never destroyed: buffers left in the registry at exit must not be released after OpenCL runtime unload
+device_memory_registry& registry()
+{
+    static auto instance = new device_memory_registry;
+    return *instance;
+}
+
+// Address space is only reserved: opaque pointers never point to accessible memory
+void* reserve_address_range(size_t size)
+{
+#ifdef _WIN32
+    auto result = VirtualAlloc(nullptr, size, MEM_RESERVE, PAGE_NOACCESS);
+    if (result == nullptr)
+        throw std::bad_alloc();
+#else
+    auto result = mmap(nullptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (result == MAP_FAILED)
+        throw std::bad_alloc();
+#endif
+    return result;
+}
+
+void release_address_range(void* ptr, size_t size)
+{
+#ifdef _WIN32
+    (void)size;
+    VirtualFree(ptr, 0, MEM_RELEASE);
+#else
+    munmap(ptr, size);
+#endif
+}
+}
+
+void* device_memory::add(const std::shared_ptr<buffer>& buffer, const void* owner)
+{
+    auto size = buffer->size();
+    auto ptr = reserve_address_range(size);
+
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.entries[reinterpret_cast<uintptr_t>(ptr)] = { size, buffer, owner };
+    ++reg.count;
+    return ptr;
+}
+
+bool device_memory::remove(void* ptr, const void* owner)
+{
+    auto& reg = registry();
+    size_t size;
+    {
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        auto it = reg.entries.find(reinterpret_cast<uintptr_t>(ptr));
+        if (it == reg.entries.end() || it->second.owner != owner)
+            return false;
+        size = it->second.reserved_size;
+        reg.entries.erase(it);
+        --reg.count;
+    }
+    release_address_range(ptr, size);
+    return true;
+}
+
+std::pair<std::shared_ptr<buffer>, size_t> device_memory::find(const void* ptr)
+{
+    auto& reg = registry();
+    if (reg.count == 0 || ptr == nullptr)
+        return { nullptr, 0 };
+
+    auto address = reinterpret_cast<uintptr_t>(ptr);
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    auto it = reg.entries.upper_bound(address);
+    if (it == reg.entries.begin())
+        return { nullptr, 0 };
+    --it;
+    auto offset = address - it->first;
+    if (offset >= it->second.reserved_size)
+        return { nullptr, 0 };
+    return { it->second.buf, offset };
+}
+
+}
@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include "engine.hpp"
+#include <algorithm>
+#include <atomic>
 
 namespace iclgpu
 {
@@ -60,11 +62,72 @@ std::shared_ptr<buffer> buffer_binding::get_buffer(const std::shared_ptr<engine>
     if (it != _buffers.end())
         return it->second;
 
-    auto buffer = engine->create_buffer(_capacity, get_host_ptr());
+    auto buffer = engine->get_registered_buffer(get_host_ptr(), _capacity);
+    if (!buffer)
+        buffer = engine->create_buffer(_capacity, get_host_ptr());
     _buffers.insert({engine, buffer});
     return buffer;
 }
 
+void buffer_binding::rebind(void* ptr)
+{
+    if (_owning_engine)
+        throw std::logic_error("Blob: engine buffer cannot be rebound to host data");
+    if (ptr == nullptr)
+        throw std::invalid_argument("ptr");
+    _host_ptr = ptr;
+    _buffers.clear();
+}
+
+event_group::event_group(const std::shared_ptr<engine>& engine, const std::vector<std::shared_ptr<event>>& events)
+    : event(engine)
+    , _events(events) {}
+
+void event_group::wait()
+{
+    for (auto& evt : _events)
+    {
+        if (evt)
+            evt->wait();
+    }
+}
+
+std::chrono::nanoseconds event_group::duration()
+{
+    std::chrono::nanoseconds result(0);
+    for (auto& evt : _events)
+    {
+        if (evt)
+            result = std::max(result, evt->duration());
+    }
+    return result;
+}
+
+void event_group::on_completion(const std::function<void()>& callback)
+{
+    std::vector<std::shared_ptr<event>> events;
+    for (auto& evt : _events)
+    {
+        if (evt)
+            events.push_back(evt);
+    }
+    if (events.empty())
+    {
+        callback();
+        return;
+    }
+
+    auto remaining = std::make_shared<std::atomic<size_t>>(events.size());
+    for (auto& evt : events)
+    {
+        evt->on_completion([remaining, callback]()
+        {
+            if (--*remaining == 0)
+                callback();
+        });
+    }
+}
+
 void commands_sequence::push_back(const std::shared_ptr<command>& command)
 {
     if (auto seq = std::dynamic_pointer_cast<commands_sequence>(command))
@@ -0,0 +1,80 @@
+// Copyright (c) 2017-2018 Intel Corporation
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//      http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "host_buffer.hpp"
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+namespace iclgpu
+{
+
+host_buffer::host_buffer(const std::shared_ptr<engine>& engine, size_t size, void* ptr, buffer_init init)
+    : buffer(engine)
+    , _data(static_cast<char*>(ptr))
+    , _size(size)
+{
+    if (size == 0)
+        throw std::invalid_argument("size should not be zero.");
+    if (_data)
+        return;
+
+    _storage.reset(new char[size + alignment - 1], std::default_delete<char[]>());
+    auto address = reinterpret_cast<std::uintptr_t>(_storage.get());
+    _data = _storage.get() + (alignment - address % alignment) % alignment;
+    if (init == buffer_init::zero)
+        std::memset(_data, 0, size);
+}
+
+host_buffer::host_buffer(const std::shared_ptr<engine>& engine, const std::shared_ptr<host_buffer>& parent,
+                         size_t offset, size_t size)
+    : buffer(engine)
+    , _storage(parent->_storage)
+    , _data(parent->_data + offset)
+    , _size(size) {}
+
+void host_buffer::check_rect(size_t offset, size_t pitch, size_t row_size, size_t rows) const
+{
+    if (rows != 0 && (row_size > pitch || offset + pitch * (rows - 1) + row_size > _size))
+        throw std::invalid_argument("rectangle is out of buffer");
+}
+
+void host_buffer::write_rect(size_t offset, size_t pitch, const void* host_ptr, size_t host_pitch,
+                             size_t row_size, size_t rows)
+{
+    check_rect(offset, pitch, row_size, rows);
+    auto src = static_cast<const char*>(host_ptr);
+    for (size_t row = 0; row < rows; ++row)
+        std::memcpy(_data + offset + row * pitch, src + row * host_pitch, row_size);
+}
+
+void host_buffer::read_rect(size_t offset, size_t pitch, void* host_ptr, size_t host_pitch,
+                            size_t row_size, size_t rows)
+{
+    check_rect(offset, pitch, row_size, rows);
+    auto dst = static_cast<char*>(host_ptr);
+    for (size_t row = 0; row < rows; ++row)
+        std::memcpy(dst + row * host_pitch, _data + offset + row * pitch, row_size);
+}
+
+std::shared_ptr<buffer> host_buffer::get_sub_buffer(size_t offset, size_t size)
+{
+    if (offset + size > _size)
+        throw std::invalid_argument("sub-buffer is out of buffer");
+    return std::make_shared<host_buffer>(get_engine(), down_pointer_cast<host_buffer>(shared_from_this()),
+                                         offset, size);
+}
+
+}
@@ -0,0 +1,53 @@
+// Copyright (c) 2017-2018 Intel Corporation
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//      http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+#include "engine.hpp"
+#include <memory>
+
+namespace iclgpu
+{
+
+/// @brief Host memory buffer
+/// @details Buffer created for host data refers to the data, other buffers own aligned memory.
+class host_buffer : public buffer
+{
+public:
+    /// @brief Alignment of owned memory, enough for any SIMD load
+    static const size_t alignment = 64;
+
+    host_buffer(const std::shared_ptr<engine>& engine, size_t size, void* ptr, buffer_init init);
+
+    /// @brief Creates buffer sharing @p size bytes of @p parent memory at @p offset
+    host_buffer(const std::shared_ptr<engine>& engine, const std::shared_ptr<host_buffer>& parent, size_t offset,
+                size_t size);
+
+    size_t size() const override { return _size; }
+    void* get_host_ptr() override { return _data; }
+    void write_rect(size_t offset, size_t pitch, const void* host_ptr, size_t host_pitch,
+                    size_t row_size, size_t rows) override;
+    void read_rect(size_t offset, size_t pitch, void* host_ptr, size_t host_pitch,
+                   size_t row_size, size_t rows) override;
+    std::shared_ptr<buffer> get_sub_buffer(size_t offset, size_t size) override;
+
+private:
+    std::shared_ptr<char> _storage;
+    char*                 _data;
+    size_t                _size;
+
+    void check_rect(size_t offset, size_t pitch, size_t row_size, size_t rows) const;
+};
+
+}
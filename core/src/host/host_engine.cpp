@@ -0,0 +1,234 @@
+// Copyright (c) 2017-2018 Intel Corporation
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//      http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "host/host_engine.hpp"
+#include "host_buffer.hpp"
+#include "host_kernel.hpp"
+#include "work_stealing_pool.hpp"
+#include "environment.hpp"
+#include "errors.hpp"
+#include "tracer.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <thread>
+
+namespace iclgpu
+{
+
+namespace
+{
+size_t get_host_threads()
+{
+    std::string value;
+    if (get_environment_variable("ICLGPU_HOST_THREADS", value))
+    {
+        auto threads = std::strtoul(value.c_str(), nullptr, 10);
+        if (threads > 0)
+            return threads;
+    }
+    return std::max<size_t>(std::thread::hardware_concurrency(), 1);
+}
+
+struct host_raise_event_command : raise_event_command
+{
+    using raise_event_command::raise_event_command;
+    std::shared_ptr<event> submit(const std::vector<std::shared_ptr<event>>& dependencies = {},
+                                  const command_queue&                                    = default_queue) override
+    {
+        wait_events(dependencies);
+        return std::make_shared<host_event>(get_engine(), std::chrono::nanoseconds(0),
+                                            get_engine()->is_profiling_enabled());
+    }
+};
+}
+
+host_engine::host_engine(const std::shared_ptr<iclgpu::context>& ctx)
+    : element(ctx)
+    , _pool(new work_stealing_pool(get_host_threads()))
+{
+    tracer::configure_from_environment();
+    std::string profiling;
+    if (get_environment_variable("ICLGPU_PROFILING", profiling))
+        _profiling = profiling != "0";
+    else
+        _profiling = tracer::enabled();
+}
+
+host_engine::~host_engine() = default;
+
+primitive_db* host_engine::get_primitive_db()
+{
+    return &_primitive_db;
+}
+
+std::shared_ptr<kernel_command> host_engine::get_kernel(const std::string& name, const std::string&,
+                                                        const kernel_defines&)
+{
+    throw error_unsupported("Host engine does not compile kernel modules, kernel " + name + " is not available");
+}
+
+std::shared_ptr<kernel_command> host_engine::get_specialized_kernel(const std::string& name, const std::string& module,
+                                                                    const kernel_defines& defines)
+{
+    return get_kernel(name, module, defines);
+}
+
+std::shared_ptr<kernel_command> host_engine::get_kernel(const std::string& name, const host_kernel_function& function)
+{
+    return std::make_shared<host_kernel>(shared_from_this(), name, function);
+}
+
+std::shared_ptr<buffer> host_engine::create_buffer(size_t size, void* ptr, buffer_init init)
+{
+    if (ptr == nullptr && init == buffer_init::zero && is_capturing())
+    {
+        auto result = std::make_shared<host_buffer>(shared_from_this(), size, nullptr, buffer_init::uninitialized);
+        if (capture(std::make_shared<host_zero_fill_command>(shared_from_this(), result)))
+            return result;
+    }
+    return std::make_shared<host_buffer>(shared_from_this(), size, ptr, init);
+}
+
+std::shared_ptr<raise_event_command> host_engine::get_raise_event_command()
+{
+    return std::make_shared<host_raise_event_command>(shared_from_this());
+}
+
+std::shared_ptr<commands_sequence>
+host_engine::get_commands_sequence(const std::vector<std::shared_ptr<command>>& commands)
+{
+    auto result = std::make_shared<commands_sequence>(shared_from_this());
+    for (const auto& cmd : commands)
+    {
+        result->push_back(cmd);
+    }
+    return result;
+}
+
+std::shared_ptr<commands_parallel>
+host_engine::get_commands_parallel(const std::vector<std::shared_ptr<command>>& commands)
+{
+    // Every kernel uses all engine threads, so the commands are executed one by one
+    auto result = std::make_shared<commands_parallel>(shared_from_this());
+    for (const auto& cmd : commands)
+    {
+        result->add(cmd);
+    }
+    return result;
+}
+
+void host_engine::warmup(const std::vector<std::string>&) {}
+
+void host_engine::wait_warmup() {}
+
+std::vector<module_build_info> host_engine::get_build_info()
+{
+    return {};
+}
+
+buffer_pool_stats host_engine::get_buffer_pool_stats()
+{
+    return {};
+}
+
+void host_engine::trim_buffer_pool() {}
+
+// Kernels use host data in place, so registration is not needed
+void host_engine::register_host_memory(void*, size_t) {}
+
+void host_engine::unregister_host_memory(void*) {}
+
+void host_engine::sync_host_memory(void*, size_t) {}
+
+std::shared_ptr<buffer> host_engine::get_registered_buffer(void*, size_t)
+{
+    return nullptr;
+}
+
+void host_engine::begin_capture()
+{
+    std::lock_guard<std::mutex> lock(_capture_mutex);
+    if (_capturing)
+        throw std::logic_error("Commands capture is already started");
+    _capture.sequence = get_commands_sequence({});
+    _capture.bindings.clear();
+    _capturing = true;
+}
+
+captured_commands host_engine::end_capture()
+{
+    std::lock_guard<std::mutex> lock(_capture_mutex);
+    if (!_capturing)
+        throw std::logic_error("Commands capture is not started");
+    _capturing = false;
+    captured_commands result;
+    std::swap(result, _capture);
+    return result;
+}
+
+bool host_engine::is_capturing()
+{
+    return _capturing;
+}
+
+bool host_engine::capture(const std::shared_ptr<command>& cmd)
+{
+    if (!_capturing)
+        return false;
+    std::lock_guard<std::mutex> lock(_capture_mutex);
+    if (!_capturing)
+        return false;
+    _capture.sequence->push_back(cmd);
+    return true;
+}
+
+void host_engine::capture_binding(const std::shared_ptr<buffer_binding>& binding)
+{
+    if (!_capturing)
+        return;
+    std::lock_guard<std::mutex> lock(_capture_mutex);
+    auto& bindings = _capture.bindings;
+    if (_capturing && std::find(bindings.begin(), bindings.end(), binding) == bindings.end())
+        bindings.push_back(binding);
+}
+
+void host_engine::set_profiling(bool enabled)
+{
+    _profiling = enabled;
+}
+
+bool host_engine::is_profiling_enabled()
+{
+    return _profiling;
+}
+
+bool host_engine::load_device_data(const std::string&, std::string&)
+{
+    return false;
+}
+
+void host_engine::store_device_data(const std::string&, const std::string&) {}
+
+void host_engine::parallel_for(size_t begin, size_t end, size_t grain, const std::function<void(size_t, size_t)>& body)
+{
+    _pool->parallel_for(begin, end, grain, body);
+}
+
+size_t host_engine::concurrency() const
+{
+    return _pool->concurrency();
+}
+
+}
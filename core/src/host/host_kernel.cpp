@@ -0,0 +1,159 @@
+// Copyright (c) 2017-2018 Intel Corporation
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//      http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "host_kernel.hpp"
+#include "errors.hpp"
+#include "tracer.hpp"
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+namespace iclgpu
+{
+
+void host_kernel_args::set_scalar(unsigned idx, const void* ptr, size_t size)
+{
+    if (size > max_scalar_size)
+        throw std::invalid_argument("scalar argument is too large");
+    if (idx >= _args.size())
+        _args.resize(idx + 1);
+    std::memcpy(_args[idx].value, ptr, size);
+    _args[idx].size = size;
+    _args[idx].ptr = nullptr;
+}
+
+void host_kernel_args::set_buffer(unsigned idx, void* ptr)
+{
+    if (idx >= _args.size())
+        _args.resize(idx + 1);
+    _args[idx].size = 0;
+    _args[idx].ptr = ptr;
+}
+
+void host_kernel_args::get_scalar(unsigned idx, void* ptr, size_t size) const
+{
+    if (idx >= _args.size() || _args[idx].size != size)
+        throw std::invalid_argument("kernel argument " + std::to_string(idx) + " is not a scalar of requested size");
+    std::memcpy(ptr, _args[idx].value, size);
+}
+
+void* host_kernel_args::get_buffer(unsigned idx) const
+{
+    if (idx >= _args.size() || _args[idx].ptr == nullptr)
+        throw std::invalid_argument("kernel argument " + std::to_string(idx) + " is not a buffer");
+    return _args[idx].ptr;
+}
+
+std::chrono::nanoseconds host_event::duration()
+{
+    if (!_profiled)
+        throw error_unsupported("Profiling was not enabled when the command was submitted");
+    return _duration;
+}
+
+void wait_events(const std::vector<std::shared_ptr<event>>& dependencies)
+{
+    for (auto& evt : dependencies)
+    {
+        if (evt)
+            evt->wait();
+    }
+}
+
+host_kernel::host_kernel(const std::shared_ptr<host_engine>& engine, const std::string& name,
+                         const host_kernel_function& function)
+    : kernel_command(engine)
+    , _name(name)
+    , _function(function) {}
+
+void host_kernel::set_buffer_arg(unsigned idx, const std::shared_ptr<buffer_binding>& binding)
+{
+    if (!binding->is_defined())
+        throw std::invalid_argument("blob is not defined");
+    _buffers[idx] = binding;
+    get_engine<host_engine>()->capture_binding(binding);
+}
+
+void host_kernel::set_options(const kernel_options& params)
+{
+    _work_size = params.work_size();
+    _parallel_size = params.parallel_size();
+}
+
+void host_kernel::trace(const command_queue& queue, std::chrono::steady_clock::time_point start,
+                        std::chrono::steady_clock::time_point end)
+{
+    auto ns = [](std::chrono::steady_clock::time_point time)
+    {
+        return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count());
+    };
+
+    tracer::command_info info;
+    info.name = _name;
+    info.work_size = _work_size;
+    info.parallel_size = _parallel_size;
+    info.queue = queue.id();
+    command_timestamps timestamps = { ns(start), ns(start), ns(start), ns(end) };
+    info.query = [timestamps](bool, command_timestamps& result)
+    {
+        result = timestamps;
+        return true;
+    };
+    tracer::add_command(std::move(info));
+}
+
+std::shared_ptr<event> host_kernel::submit(const std::vector<std::shared_ptr<event>>& dependencies,
+                                           const command_queue&                       queue)
+{
+    auto engine = get_engine<host_engine>();
+    if (engine->capture(down_pointer_cast<command>(shared_from_this())))
+        return engine->get_raise_event_command()->submit({}, queue);
+
+    if (_work_size.dimensions() == 0)
+        throw std::logic_error("kernel options are not set");
+
+    wait_events(dependencies);
+
+    // Bindings may be rebound to other host data since the previous submission
+    for (auto& pair : _buffers)
+        _args.set_buffer(pair.first, pair.second->get_buffer(engine)->get_host_ptr());
+
+    const auto profiled = engine->is_profiling_enabled();
+    const auto start = std::chrono::steady_clock::now();
+    const auto grain = _parallel_size.dimensions() != 0 ? _parallel_size[0] : 0;
+    auto& args = _args;
+    auto& function = _function;
+    engine->parallel_for(0, _work_size[0], grain, [&args, &function](size_t begin, size_t end)
+    {
+        function(args, begin, end);
+    });
+    const auto end = std::chrono::steady_clock::now();
+
+    if (profiled && tracer::enabled())
+        trace(queue, start, end);
+    return std::make_shared<host_event>(engine, end - start, profiled);
+}
+
+std::shared_ptr<event> host_zero_fill_command::submit(const std::vector<std::shared_ptr<event>>& dependencies,
+                                                      const command_queue&)
+{
+    wait_events(dependencies);
+    std::memset(_buffer->get_host_ptr(), 0, _buffer->size());
+    return std::make_shared<host_event>(get_engine(), std::chrono::nanoseconds(0),
+                                        get_engine()->is_profiling_enabled());
+}
+
+}
@@ -0,0 +1,92 @@
+// Copyright (c) 2017-2018 Intel Corporation
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//      http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+#include "host/host_engine.hpp"
+#include <chrono>
+#include <map>
+#include <string>
+
+namespace iclgpu
+{
+
+/// @brief Completed host command event
+class host_event : public event
+{
+public:
+    /// @param profiled false if the engine did not collect the command execution time
+    host_event(const std::shared_ptr<engine>& engine, std::chrono::nanoseconds duration, bool profiled)
+        : event(engine)
+        , _duration(duration)
+        , _profiled(profiled) {}
+
+    void wait() override {}
+    std::chrono::nanoseconds duration() override;
+
+private:
+    std::chrono::nanoseconds _duration;
+    bool                     _profiled;
+};
+
+/// @brief Waits for events of @p dependencies, they may come from other engines
+void wait_events(const std::vector<std::shared_ptr<event>>& dependencies);
+
+class host_kernel : public kernel_command
+{
+public:
+    host_kernel(const std::shared_ptr<host_engine>& engine, const std::string& name,
+                const host_kernel_function& function);
+
+    void set_scalar_arg(unsigned idx, const void* ptr, size_t size) override
+    {
+        _args.set_scalar(idx, ptr, size);
+    }
+
+    void set_buffer_arg(unsigned idx, const std::shared_ptr<buffer_binding>& binding) override;
+
+    void set_options(const kernel_options& params) override;
+
+    std::shared_ptr<event> submit(const std::vector<std::shared_ptr<event>>& dependencies = {},
+                                  const command_queue&                       queue        = default_queue) override;
+
+private:
+    std::string          _name;
+    host_kernel_function _function;
+    host_kernel_args     _args;
+    nd_range             _work_size;
+    nd_range             _parallel_size;
+    std::map<unsigned, std::shared_ptr<buffer_binding>> _buffers;
+
+    /// @brief Records the kernel execution in the tracer
+    void trace(const command_queue& queue, std::chrono::steady_clock::time_point start,
+               std::chrono::steady_clock::time_point end);
+};
+
+/// @brief Fills buffer with zeros on every submission, records zero-initialization of buffers during capture
+class host_zero_fill_command : public command
+{
+public:
+    host_zero_fill_command(const std::shared_ptr<host_engine>& engine, const std::shared_ptr<buffer>& buffer)
+        : command(engine)
+        , _buffer(buffer) {}
+
+    std::shared_ptr<event> submit(const std::vector<std::shared_ptr<event>>& dependencies = {},
+                                  const command_queue&                       queue        = default_queue) override;
+
+private:
+    std::shared_ptr<buffer> _buffer;
+};
+
+}
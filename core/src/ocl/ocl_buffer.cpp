@@ -13,6 +13,9 @@
 // limitations under the License.
 
 #include "ocl_buffer.hpp"
+#include "errors.hpp"
+#include <algorithm>
+#include <string>
 
 // cache size
 #define ZERO_COPY_ALIGN 0x40
@@ -41,30 +44,86 @@ cl_mem_flags make_buffer_flags(size_t size, void* ptr)
     return flags;
 }
 
-ocl_buffer::ocl_buffer(const std::shared_ptr<ocl_engine>& engine, size_t size, void* ptr)
+ocl_buffer::ocl_buffer(const std::shared_ptr<ocl_engine>& engine, size_t size, void* ptr, buffer_init init)
     : buffer(engine)
     , _size(size)
     , _mapped_ptr(nullptr)
     , _cl_mem_flags(make_buffer_flags(size, ptr))
-    , _buffer(engine->toolkit().get_cl_context(), _cl_mem_flags, size, ptr)
+    , _buffer(create_handle(engine->toolkit(), ptr))
+    , _pooled(!use_host_pointer())
+    , _registered(false)
+    , _parent(nullptr)
 {
-    //zero init
-    //TODO redesign this area to avoid enqueue
-    if (ptr == nullptr)
+    if (ptr != nullptr && _pooled)
+    {
+        upload(engine->toolkit(), ptr);
+    }
+    else if (ptr == nullptr && init == buffer_init::zero)
     {
         const uint8_t zero = 0;
         engine->toolkit().get_cl_queue().enqueueFillBuffer(_buffer, zero, 0, size);
     }
 }
 
+ocl_buffer::ocl_buffer(const std::shared_ptr<ocl_engine>& engine, const cl::Buffer& handle, size_t size, cl_mem_flags flags,
+                       const std::shared_ptr<ocl_buffer>& parent)
+    : buffer(engine)
+    , _size(size)
+    , _mapped_ptr(nullptr)
+    , _cl_mem_flags(flags)
+    , _buffer(handle)
+    , _pooled(false)
+    , _registered(true)
+    , _parent(parent) {}
+
+ocl_buffer::~ocl_buffer()
+{
+    try
+    {
+        auto& toolkit = get_engine<ocl_engine>()->toolkit();
+        // Mapped memory object is not freed until it is unmapped, sub-buffers of device memory are mapped too
+        if (_mapped_ptr != nullptr)
+        {
+            auto evt = enqueue_unmap(toolkit.get_cl_queue(), get_fences());
+            set_last_use(default_queue, evt);
+        }
+        if (_pooled)
+            toolkit.get_buffer_pool().release(_buffer, get_fences());
+    }
+    catch (...)
+    {
+        // the buffer is freed instead of being cached
+    }
+}
+
+cl::Buffer ocl_buffer::create_handle(ocl_toolkit& toolkit, void* ptr) const
+{
+    if (use_host_pointer())
+        return cl::Buffer(toolkit.get_cl_context(), _cl_mem_flags, _size, ptr);
+
+    return toolkit.get_buffer_pool().acquire(_size);
+}
+
+void ocl_buffer::upload(ocl_toolkit& toolkit, void* ptr)
+{
+    // Not waited here: host data stays alive until commands using the buffer are completed (end of a synchronous
+    // call or synchronization of the stream). Results of earlier calls read into the same host memory come first.
+    auto reads = toolkit.get_host_reads(ptr, _size);
+    toolkit.get_cl_queue().enqueueWriteBuffer(_buffer, false, 0, _size, ptr, &reads, &_upload);
+    set_last_use(default_queue, _upload);
+}
+
 cl::Event ocl_buffer::read(const command_queue& queue, const std::vector<cl::Event>& dependencies, void* ptr) const
 {
     auto engine = get_engine<ocl_engine>();
     if (!use_host_pointer() && ptr != nullptr)
     {
         cl::Event result;
+        // Not waited here: the data is available when the event of the command is completed
         engine->toolkit().get_cl_queue(queue).enqueueReadBuffer(get_handle(), false, 0, _size, ptr, &dependencies, &result);
-        result.wait();
+        engine->toolkit().add_host_read(ptr, _size, result);
+        if (!_registered)
+            engine->toolkit().get_host_registry().host_written(ptr, _size);
         return result;
     }
 
@@ -87,9 +146,23 @@ cl::Event ocl_buffer::read(const command_queue& queue, const std::vector<cl::Eve
     }
 }
 
+cl::Event ocl_buffer::write(const command_queue& queue, const std::vector<cl::Event>& dependencies, void* ptr)
+{
+    cl::Event result;
+    if (use_host_pointer() || _registered || ptr == nullptr)
+        return result;
+
+    auto& toolkit = get_engine<ocl_engine>()->toolkit();
+    auto wait_events = dependencies;
+    auto reads = toolkit.get_host_reads(ptr, _size);
+    wait_events.insert(wait_events.end(), reads.begin(), reads.end());
+    toolkit.get_cl_queue(queue).enqueueWriteBuffer(_buffer, false, 0, _size, ptr, &wait_events, &result);
+    return result;
+}
+
 void* ocl_buffer::get_host_ptr()
 {
-    if (_mapped_ptr != nullptr)
+    if (_mapped_ptr == nullptr)
     {
         _mapped_ptr = get_engine<ocl_engine>()
                         ->toolkit()
@@ -99,6 +172,90 @@ void* ocl_buffer::get_host_ptr()
     return _mapped_ptr;
 }
 
+void ocl_buffer::check_rect(size_t offset, size_t pitch, size_t row_size, size_t rows) const
+{
+    if (rows == 0 || row_size == 0)
+        throw std::invalid_argument("empty region");
+    if (pitch < row_size || offset + pitch * (rows - 1) + row_size > _size)
+        throw std::invalid_argument("region is out of buffer");
+}
+
+void ocl_buffer::write_rect(size_t offset, size_t pitch, const void* host_ptr, size_t host_pitch,
+                            size_t row_size, size_t rows)
+{
+    check_rect(offset, pitch, row_size, rows);
+    auto& queue = get_engine<ocl_engine>()->toolkit().get_cl_queue();
+    auto ptr = const_cast<void*>(host_ptr);
+    if ((pitch == row_size && host_pitch == row_size) || rows == 1)
+    {
+        queue.enqueueWriteBuffer(_buffer, true, offset, row_size * rows, ptr);
+        return;
+    }
+    queue.enqueueWriteBufferRect(_buffer, true, {offset, 0, 0}, {0, 0, 0}, {row_size, rows, 1},
+                                 pitch, 0, host_pitch, 0, ptr);
+}
+
+void ocl_buffer::read_rect(size_t offset, size_t pitch, void* host_ptr, size_t host_pitch,
+                           size_t row_size, size_t rows)
+{
+    check_rect(offset, pitch, row_size, rows);
+    auto& queue = get_engine<ocl_engine>()->toolkit().get_cl_queue();
+    if ((pitch == row_size && host_pitch == row_size) || rows == 1)
+    {
+        queue.enqueueReadBuffer(_buffer, true, offset, row_size * rows, host_ptr);
+        return;
+    }
+    queue.enqueueReadBufferRect(_buffer, true, {offset, 0, 0}, {0, 0, 0}, {row_size, rows, 1},
+                                pitch, 0, host_pitch, 0, host_ptr);
+}
+
+std::shared_ptr<buffer> ocl_buffer::get_sub_buffer(size_t offset, size_t size)
+{
+    if (offset + size > _size)
+        throw std::invalid_argument("sub-buffer is out of buffer");
+
+    auto engine = get_engine<ocl_engine>();
+    auto align = engine->toolkit().get_base_address_align();
+    if (offset % align != 0)
+        throw error_unsupported("buffer offset is not aligned to " + std::to_string(align) + " bytes");
+
+    cl_buffer_region region = { offset, size };
+    auto handle = _buffer.createSubBuffer(CL_MEM_READ_WRITE, CL_BUFFER_CREATE_TYPE_REGION, &region);
+    return std::make_shared<ocl_buffer>(engine, handle, size, _cl_mem_flags,
+                                        down_pointer_cast<ocl_buffer>(shared_from_this()));
+}
+
+void ocl_buffer::set_last_use(const command_queue& queue, const cl::Event& evt)
+{
+    if (_parent)
+        _parent->set_last_use(queue, evt);
+
+    auto& toolkit = get_engine<ocl_engine>()->toolkit();
+    // Later users of the memory are submitted to the default queue or depend on its commands,
+    // unless threads have own default queues
+    if (queue.id() == default_queue.id() && !toolkit.has_thread_queues())
+        return;
+
+    // Queues are in-order: the command replaces only the fence of its own queue
+    auto ocl_queue = toolkit.get_cl_queue(queue)();
+    std::lock_guard<std::mutex> lock(_last_use_mutex);
+    auto it = std::find_if(_last_use.begin(), _last_use.end(),
+                           [&](const queue_fence& fence) { return fence.first == ocl_queue; });
+    if (it != _last_use.end())
+        it->second = evt;
+    else
+        _last_use.emplace_back(ocl_queue, evt);
+}
+
+std::vector<cl::Event> ocl_buffer::get_fences() const
+{
+    std::lock_guard<std::mutex> lock(_last_use_mutex);
+    std::vector<cl::Event> result;
+    for (auto& fence : _last_use)
+        result.push_back(fence.second);
+    return result;
+}
+
 cl::Event ocl_buffer::enqueue_unmap(const cl::CommandQueue& ocl_queue, const std::vector<cl::Event>& dependencies)
 {
     cl::Event result;
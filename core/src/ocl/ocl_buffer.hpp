@@ -15,32 +15,75 @@
 #pragma once
 #include "ocl/ocl_engine.hpp"
 #include "ocl_toolkit.hpp"
+#include <mutex>
+#include <utility>
 #include <vector>
 
 namespace iclgpu
 {
 
+/// @brief Returns memory flags of buffer for host data: CL_MEM_USE_HOST_PTR if it can be used in place
+cl_mem_flags make_buffer_flags(size_t size, void* ptr);
+
 class ocl_buffer : public buffer
 {
 public:
 
-    ocl_buffer(const std::shared_ptr<ocl_engine>& engine, size_t size, void* ptr = nullptr);
+    /// @brief Creates buffer. Device-owned memory (no @p ptr or unaligned @p ptr which is copied) is taken from
+    /// the engine buffer pool and returned there on destruction.
+    /// Buffer without @p ptr is filled with zeros only if @p init is buffer_init::zero.
+    ocl_buffer(const std::shared_ptr<ocl_engine>& engine, size_t size, void* ptr = nullptr,
+               buffer_init init = buffer_init::zero);
+    /// @brief Creates buffer for registered host memory or part of @p parent buffer
+    ocl_buffer(const std::shared_ptr<ocl_engine>& engine, const cl::Buffer& handle, size_t size, cl_mem_flags flags,
+               const std::shared_ptr<ocl_buffer>& parent = nullptr);
+    ~ocl_buffer() override;
 
     size_t size() const override { return _size; }
     void* get_host_ptr() override;
+    void write_rect(size_t offset, size_t pitch, const void* host_ptr, size_t host_pitch,
+                    size_t row_size, size_t rows) override;
+    void read_rect(size_t offset, size_t pitch, void* host_ptr, size_t host_pitch,
+                   size_t row_size, size_t rows) override;
+    std::shared_ptr<buffer> get_sub_buffer(size_t offset, size_t size) override;
 
     cl::Event read(const command_queue& queue, const std::vector<cl::Event>& dependencies, void* ptr) const;
+    /// @brief Enqueues copy of host data at @p ptr to the buffer
+    /// @returns NULL event if the buffer uses host or registered memory directly, so no copy is needed
+    cl::Event write(const command_queue& queue, const std::vector<cl::Event>& dependencies, void* ptr);
     cl::Event enqueue_unmap(const cl::CommandQueue& ocl_queue, const std::vector<cl::Event>& dependencies);
 
     const cl::Buffer& get_handle() const { return _buffer; }
 
+    /// @brief Returns completion of the copy of host data passed to constructor, NULL event if there was no copy.
+    /// @details The copy is enqueued to the default queue, commands of other queues must wait for it.
+    const cl::Event& get_upload_event() const { return _upload; }
+
+    /// @brief Records the last command using the buffer, pooled memory is not reused until it is completed
+    /// @details One command is kept per queue, so uses on other queues are not forgotten.
+    void set_last_use(const command_queue& queue, const cl::Event& evt);
+
 private:
+    using queue_fence = std::pair<::cl_command_queue, cl::Event>;
+
     size_t       _size;
     void*        _mapped_ptr;
     cl_mem_flags _cl_mem_flags;
     cl::Buffer   _buffer;
+    bool         _pooled;
+    bool         _registered;
+    // Sub-buffer keeps parent memory alive
+    std::shared_ptr<ocl_buffer> _parent;
+    // Last command using the buffer per queue
+    mutable std::mutex       _last_use_mutex;
+    std::vector<queue_fence> _last_use;
+    cl::Event                _upload;
 
     bool use_host_pointer() const { return (_cl_mem_flags & CL_MEM_USE_HOST_PTR) != 0; }
+    cl::Buffer create_handle(ocl_toolkit& toolkit, void* ptr) const;
+    void upload(ocl_toolkit& toolkit, void* ptr);
+    std::vector<cl::Event> get_fences() const;
+    void check_rect(size_t offset, size_t pitch, size_t row_size, size_t rows) const;
 };
 
 }
@@ -0,0 +1,124 @@
+// Copyright (c) 2017-2018 Intel Corporation
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//      http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ocl_buffer_pool.hpp"
+#include "environment.hpp"
+#include <algorithm>
+
+namespace iclgpu
+{
+
+namespace
+{
+bool is_completed(const std::vector<cl::Event>& fences)
+{
+    // Negative status means the command is terminated by an error, it does not use the buffer anymore
+    return std::all_of(fences.begin(), fences.end(), [](const cl::Event& fence)
+    {
+        return fence.get() == nullptr || fence.getInfo<CL_EVENT_COMMAND_EXECUTION_STATUS>() <= CL_COMPLETE;
+    });
+}
+}
+
+ocl_buffer_pool::ocl_buffer_pool(const cl::Context& context, size_t max_alloc_size)
+    : _context(context)
+    , _max_alloc_size(max_alloc_size)
+    , _stats()
+{
+    _stats.high_water_mark = default_high_water_mark;
+    std::string pool_size;
+    if (get_environment_variable("ICLGPU_BUFFER_POOL_SIZE", pool_size))
+        _stats.high_water_mark = static_cast<size_t>(parse_size_value(pool_size, default_high_water_mark));
+}
+
+size_t ocl_buffer_pool::size_class(size_t size) const
+{
+    size_t result = min_size_class;
+    while (result < size && result <= _max_alloc_size / 2)
+        result <<= 1;
+    // Rounding up must not exceed device allocation limit
+    return result < size ? size : result;
+}
+
+cl::Buffer ocl_buffer_pool::acquire(size_t size)
+{
+    auto alloc_size = size_class(size);
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        ++_stats.requests;
+        auto it = _free_buffers.find(alloc_size);
+        if (it != _free_buffers.end())
+        {
+            auto& buffers = it->second;
+            // Oldest first: the most recently released buffers are the most likely to be still in use by other queues
+            for (auto entry = buffers.begin(); entry != buffers.end(); ++entry)
+            {
+                if (!is_completed(entry->fences))
+                    continue;
+                auto result = std::move(entry->buffer);
+                buffers.erase(entry);
+                ++_stats.hits;
+                --_stats.cached_buffers;
+                _stats.cached_bytes -= alloc_size;
+                return result;
+            }
+        }
+        ++_stats.allocations;
+    }
+    return cl::Buffer(_context, CL_MEM_READ_WRITE, alloc_size);
+}
+
+void ocl_buffer_pool::release(const cl::Buffer& buffer, const std::vector<cl::Event>& fences)
+{
+    auto size = buffer.getInfo<CL_MEM_SIZE>();
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (size > _stats.high_water_mark)
+        return;
+
+    _free_buffers[size].push_back({buffer, fences});
+    ++_stats.cached_buffers;
+    _stats.cached_bytes += size;
+    trim_locked(_stats.high_water_mark);
+}
+
+void ocl_buffer_pool::trim(size_t max_cached_bytes)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    trim_locked(max_cached_bytes);
+}
+
+void ocl_buffer_pool::trim_locked(size_t max_cached_bytes)
+{
+    // Large buffers are freed first: it releases the most memory with the fewest reallocations later
+    auto it = _free_buffers.rbegin();
+    while (_stats.cached_bytes > max_cached_bytes && it != _free_buffers.rend())
+    {
+        auto& buffers = it->second;
+        while (_stats.cached_bytes > max_cached_bytes && !buffers.empty())
+        {
+            buffers.pop_back();
+            --_stats.cached_buffers;
+            _stats.cached_bytes -= it->first;
+        }
+        ++it;
+    }
+}
+
+buffer_pool_stats ocl_buffer_pool::get_stats() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _stats;
+}
+
+}
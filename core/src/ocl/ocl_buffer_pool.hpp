@@ -0,0 +1,79 @@
+// Copyright (c) 2017-2018 Intel Corporation
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//      http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <map>
+#include <mutex>
+#include <vector>
+
+#define CL_HPP_ENABLE_EXCEPTIONS
+#define CL_HPP_MINIMUM_OPENCL_VERSION 120
+#define CL_HPP_TARGET_OPENCL_VERSION 120
+#include <cl2_wrapper.h>
+
+#include "engine.hpp"
+
+namespace iclgpu
+{
+
+/// @brief Caching allocator of device buffers with power-of-two size classes.
+/// @details Released buffers are kept for reuse until the total size of cached buffers exceeds
+/// the high-water mark, then the largest cached buffers are freed.
+/// Buffers are reused in submission order of the default in-order queue, so no extra synchronization is needed
+/// unless threads have own default queues, see ocl_toolkit::has_thread_queues().
+class ocl_buffer_pool
+{
+public:
+    /// @brief The smallest size class (page size)
+    static const size_t min_size_class = 0x1000;
+    static const size_t default_high_water_mark = 256 * 1024 * 1024;
+
+    /// @brief Creates the pool. The high-water mark is read from @b ICLGPU_BUFFER_POOL_SIZE environment variable,
+    /// zero disables caching.
+    ocl_buffer_pool(const cl::Context& context, size_t max_alloc_size);
+
+    /// @brief Returns read-write buffer of at least @p size bytes
+    cl::Buffer acquire(size_t size);
+
+    /// @brief Returns buffer obtained by acquire() to the pool
+    /// @param fences Completions of the last commands using the buffer, one per queue other than the default one.
+    /// The buffer is not reused until all fences are completed. Commands of the default queue are ordered
+    /// with all later users of the buffer, so they do not need a fence.
+    void release(const cl::Buffer& buffer, const std::vector<cl::Event>& fences = {});
+
+    /// @brief Frees cached buffers until their total size is not greater than @p max_cached_bytes
+    void trim(size_t max_cached_bytes = 0);
+
+    buffer_pool_stats get_stats() const;
+
+    /// @brief Returns size of buffer allocated for the request of @p size bytes
+    size_t size_class(size_t size) const;
+
+private:
+    struct cached_buffer
+    {
+        cl::Buffer             buffer;
+        std::vector<cl::Event> fences;
+    };
+
+    mutable std::mutex                        _mutex;
+    cl::Context                               _context;
+    size_t                                    _max_alloc_size;
+    std::map<size_t, std::vector<cached_buffer>> _free_buffers;
+    buffer_pool_stats                         _stats;
+
+    void trim_locked(size_t max_cached_bytes);
+};
+
+}
@@ -0,0 +1,454 @@
+// Copyright (c) 2017-2018 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ocl_device.hpp"
+#include "primitive_db.hpp"
+#include "environment.hpp"
+#include <algorithm>
+#include <thread>
+#include <cassert>
+
+namespace iclgpu
+{
+
+class ocl_primitive_db : public primitive_db
+{
+public:
+    ocl_primitive_db(const cl::Context& context)
+        : _context(context)
+    {
+        const value_type core_kernels[] = {
+            #include CORE_OCL_KERNELS_DB
+        };
+        for (auto& value : core_kernels)
+            primitive_db::insert(value);
+        update_headers_hash();
+    }
+
+    /// @brief Header programs with their include names, the programs are retained by the copy
+    struct headers_ret
+    {
+        std::vector<std::string> names;
+        std::vector<cl::Program> programs;
+    };
+
+    headers_ret headers() const
+    {
+        std::lock_guard<std::mutex> lock(_headers_mutex);
+        return{ _names, _programs };
+    }
+
+    void insert(const value_type& value) override
+    {
+        // Contexts of the device insert the same sources, unchanged ones keep programs built from them
+        auto result = store(value);
+        if (result == insert_result::unchanged)
+            return;
+
+        auto& name = value.first;
+        auto& code = value.second;
+        const auto name_len = name.length();
+        if (name_len > 2 && name.compare(name_len - 2, 2, ".h") == 0)
+        {
+            std::lock_guard<std::mutex> lock(_headers_mutex);
+            insert_header(name, code);
+            update_headers_hash();
+        }
+        if (result == insert_result::replaced)
+            ++_version;
+    }
+
+    /// @brief Returns hash of all header names and sources. Any header change invalidates cached programs.
+    std::string headers_hash() const
+    {
+        std::lock_guard<std::mutex> lock(_headers_mutex);
+        return _headers_hash;
+    }
+
+    /// @brief Returns number of replaced sources
+    uint64_t version() const { return _version; }
+
+private:
+    cl::Context _context;
+    mutable std::mutex _headers_mutex;
+    std::vector<std::string> _names;
+    std::vector<cl::Program> _programs;
+    std::string _headers_hash;
+    std::atomic<uint64_t> _version{0};
+
+    void update_headers_hash()
+    {
+        auto names = _names;
+        std::sort(names.begin(), names.end());
+
+        hash_builder hash;
+        for (auto& name : names)
+            hash.add(name).add(get(name));
+        _headers_hash = hash.str();
+    }
+
+    void insert_header(const std::string& name, const std::string& code)
+    {
+        assert(_names.size() == _programs.size());
+
+        cl::Program prog(_context, code, false);
+        auto it = std::find(_names.begin(), _names.end(), name);
+        if (it != _names.end())
+        {
+            // replace
+            _programs[it - _names.begin()] = prog;
+            return;
+        }
+
+        _names.push_back(name);
+        _programs.push_back(prog);
+    }
+};
+
+std::shared_ptr<ocl_device> ocl_device::acquire(const cl::Device& device)
+{
+    // Weak references: the state is released with the last context, so no OpenCL objects outlive the library users
+    static std::mutex registry_mutex;
+    static std::unordered_map<cl_device_id, std::weak_ptr<ocl_device>> registry;
+
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    auto& entry = registry[device()];
+    auto result = entry.lock();
+    if (!result)
+    {
+        result = std::make_shared<ocl_device>(device);
+        entry = result;
+    }
+    return result;
+}
+
+ocl_device::ocl_device(const cl::Device& device)
+    : _device(device)
+    , _ocl_context(_device)
+    , _primitive_db(std::make_unique<ocl_primitive_db>(_ocl_context))
+{
+    _base_address_align = std::max<size_t>(_device.getInfo<CL_DEVICE_MEM_BASE_ADDR_ALIGN>() / 8, 1);
+
+    auto platform = cl::Platform(_device.getInfo<CL_DEVICE_PLATFORM>());
+    _device_hash = hash_builder()
+        .add(platform.getInfo<CL_PLATFORM_NAME>())
+        .add(platform.getInfo<CL_PLATFORM_VERSION>())
+        .add(_device.getInfo<CL_DEVICE_NAME>())
+        .add(_device.getInfo<CL_DEVICE_VERSION>())
+        .add(_device.getInfo<CL_DRIVER_VERSION>())
+        .str();
+
+    size_t il_version_size = 0;
+    if (::clGetDeviceInfo(_device(), CL_DEVICE_IL_VERSION, 0, nullptr, &il_version_size) == CL_SUCCESS && il_version_size > 1)
+    {
+        std::string il_version(il_version_size, '\0');
+        ::clGetDeviceInfo(_device(), CL_DEVICE_IL_VERSION, il_version_size, &il_version[0], nullptr);
+        _il_supported = il_version.find("SPIR-V") != std::string::npos;
+    }
+}
+
+ocl_device::~ocl_device() = default;
+
+primitive_db* ocl_device::get_primitive_db() const { return _primitive_db.get(); }
+
+uint64_t ocl_device::get_sources_version() const { return _primitive_db->version(); }
+
+bool ocl_device::load_device_data(const std::string& name, std::string& data) const
+{
+    return _program_cache.load_file(name + "_" + _device_hash + ".txt", data);
+}
+
+void ocl_device::store_device_data(const std::string& name, const std::string& data)
+{
+    _program_cache.store_file(name + "_" + _device_hash + ".txt", data);
+}
+
+std::string ocl_device::get_program_cache_key(const std::string& module_name, const std::string& options)
+{
+    return hash_builder()
+        .add(ocl_program_cache::format_version)
+        .add(_device_hash)
+        .add(_primitive_db->headers_hash())
+        .add(_primitive_db->get(module_name))
+        .add(options)
+        .str();
+}
+
+cl::Program ocl_device::build_program(const std::string& module_name, const std::string& options,
+                                      module_build_info::origin_type& origin)
+{
+    std::string cache_key;
+    if (_program_cache.enabled())
+    {
+        cache_key = get_program_cache_key(module_name, options);
+        cl::Program::Binaries binaries(1);
+        if (_program_cache.load(cache_key, binaries[0]))
+        {
+            try
+            {
+                cl::Program program(_ocl_context, {_device}, binaries);
+                program.build({_device});
+                origin = module_build_info::cached;
+                return program;
+            }
+            catch (const cl::Error&)
+            {
+                // Driver rejected the binary - rebuild and overwrite the entry
+            }
+        }
+    }
+
+    origin = module_build_info::precompiled;
+    // Precompiled modules are already preprocessed with default definitions
+    auto program = options.empty() ? build_program_from_il(module_name, options) : cl::Program();
+    if (!program())
+    {
+        origin = module_build_info::source;
+        program = build_program_from_source(module_name, options);
+    }
+
+    if (!cache_key.empty())
+    {
+        auto binaries = program.getInfo<CL_PROGRAM_BINARIES>();
+        if (binaries.size() == 1)
+            _program_cache.store(cache_key, binaries[0]);
+    }
+
+    return program;
+}
+
+cl::Program ocl_device::build_program_from_il(const std::string& module_name, const std::string& options)
+{
+    auto binary = _il_supported ? _primitive_db->get_binary(module_name) : nullptr;
+    if (binary == nullptr)
+        return cl::Program();
+
+    cl_int error = CL_SUCCESS;
+    auto prog = ::clCreateProgramWithIL(_ocl_context(), binary->data, binary->size, &error);
+    if (error != CL_SUCCESS)
+        return cl::Program();
+
+    cl::Program program(prog, false);
+    try
+    {
+        program.build({_device}, options.c_str());
+    }
+    catch (const cl::Error&)
+    {
+        // Precompiled module is not accepted by the driver - fall back to sources
+        return cl::Program();
+    }
+    return program;
+}
+
+cl::Program ocl_device::build_program_from_source(const std::string& module_name, const std::string& options)
+{
+    cl::Program program(_ocl_context, cl::Program::Sources{_primitive_db->get("complex.h"), _primitive_db->get(module_name)});
+
+    // Copies stay valid while headers are replaced by other threads
+    auto headers = _primitive_db->headers();
+    std::vector<const char*> header_names;
+    std::vector<::cl_program> header_programs;
+    for (size_t i = 0; i < headers.names.size(); ++i)
+    {
+        header_names.push_back(headers.names[i].c_str());
+        header_programs.push_back(headers.programs[i]());
+    }
+
+    auto error = ::clCompileProgram(
+            program(),              // cl_program program
+            1,                      // cl_uint num_devices
+            &_device(),             // const cl_device_id* devices
+            options.c_str(),        // const char* compiler_options
+            (cl_uint)header_names.size(), // cl_uint num_input_headers
+            header_programs.data(), // const cl_program *input_headers
+            header_names.data(),    // const char **header_include_names
+            NULL,                   // void (CL_CALLBACK *pfn_notify)(cl_program program, void *user_data)
+            NULL);                  // void *user_data
+
+    cl::detail::buildErrHandler(error, "clCompileProgram", program.getBuildInfo<CL_PROGRAM_BUILD_LOG>());
+
+    auto prog = ::clLinkProgram(
+            _ocl_context(),   // cl_context context
+            1,              // cl_uint num_devices
+            &_device(),     // const cl_device_id *device_list
+            NULL,           // const char *options
+            1,              // cl_uint num_input_programs
+            &program(),     // const cl_program *input_programs
+            NULL,           // void (CL_CALLBACK *pfn_notify)(cl_program program, void *user_data)
+            NULL,           // void *user_data
+            &error);        // cl_int *errcode_ret
+
+    cl::detail::errHandler(error, "clLinkProgram");
+
+    return cl::Program(prog, false);
+}
+
+namespace
+{
+/// @brief Identifies variant of the module built with the options, reported as module name by get_build_info()
+std::string module_key(const std::string& module_name, const std::string& options)
+{
+    return options.empty() ? module_name : module_name + ' ' + options;
+}
+}
+
+std::string ocl_device::program_key(const std::string& module_name, const std::string& options) const
+{
+    return module_key(module_name, options) + '#' + std::to_string(get_sources_version());
+}
+
+ocl_device::module_entry ocl_device::acquire_module(const std::string& key, size_t requester)
+{
+    std::lock_guard<std::mutex> lock(_programs_mutex);
+    auto it = _programs.find(key);
+    if (it != _programs.end())
+        return it->second;
+
+    module_entry entry;
+    entry.task = std::make_shared<module_build_task>();
+    entry.task->requester = requester;
+    entry.program = entry.task->promise.get_future().share();
+    _programs.emplace(key, entry);
+    return entry;
+}
+
+void ocl_device::build_module(const std::string& key, const std::string& module_name, const std::string& options,
+                              module_build_task& task, bool background)
+{
+    try
+    {
+        auto start = std::chrono::steady_clock::now();
+        module_build_info::origin_type origin;
+        auto program = build_program(module_name, options, origin);
+        auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+        {
+            std::lock_guard<std::mutex> lock(_programs_mutex);
+            _build_records[key] = {task.requester, {module_key(module_name, options), origin, background, duration}};
+        }
+        task.promise.set_value(program);
+    }
+    catch (...)
+    {
+        {
+            // Next get_module() will try to build the module again
+            std::lock_guard<std::mutex> lock(_programs_mutex);
+            _programs.erase(key);
+            _failed_programs.insert(key);
+        }
+        task.promise.set_exception(std::current_exception());
+    }
+}
+
+const cl::Program& ocl_device::get_module(const std::string& module_name, const std::string& options,
+                                          size_t requester)
+{
+    auto key = program_key(module_name, options);
+    if (auto program = _built_programs.find(key))
+        return *program;
+
+    auto entry = acquire_module(key, requester);
+    // Do not wait in the warm-up queue if the build is not started yet
+    if (!entry.task->claimed.exchange(true))
+        build_module(key, module_name, options, *entry.task, false);
+    return _built_programs.insert(key, entry.program.get());
+}
+
+bool ocl_device::prepare_module(const std::string& module_name, const std::string& options, size_t requester)
+{
+    auto key = program_key(module_name, options);
+    if (_built_programs.find(key))
+        return true;
+
+    {
+        std::lock_guard<std::mutex> lock(_programs_mutex);
+        if (_failed_programs.count(key))
+            return false;
+    }
+
+    auto entry = acquire_module(key, requester);
+    if (entry.program.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+    {
+        schedule_build(key, module_name, options, entry.task);
+        return false;
+    }
+
+    try
+    {
+        _built_programs.insert(key, entry.program.get());
+        return true;
+    }
+    catch (...)
+    {
+        // Failed build is remembered by build_module(), next calls do not schedule it
+        return false;
+    }
+}
+
+void ocl_device::warmup(const std::vector<std::string>& modules, size_t requester)
+{
+    for (auto& module_name : modules)
+    {
+        auto key = program_key(module_name, std::string());
+        schedule_build(key, module_name, std::string(), acquire_module(key, requester).task);
+    }
+}
+
+void ocl_device::schedule_build(const std::string& key, const std::string& module_name, const std::string& options,
+                                const std::shared_ptr<module_build_task>& task)
+{
+    if (task->claimed || task->scheduled.exchange(true))
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(_programs_mutex);
+        if (!_warmup_pool)
+        {
+            size_t threads = std::thread::hardware_concurrency();
+            std::string threads_str;
+            if (get_environment_variable("ICLGPU_WARMUP_THREADS", threads_str))
+                threads = static_cast<size_t>(parse_size_value(threads_str, threads));
+            _warmup_pool = std::make_unique<thread_pool>(threads);
+        }
+    }
+
+    _warmup_pool->enqueue([this, key, module_name, options, task]()
+    {
+        if (!task->claimed.exchange(true))
+            build_module(key, module_name, options, *task, true);
+    });
+}
+
+void ocl_device::wait_warmup()
+{
+    thread_pool* pool;
+    {
+        std::lock_guard<std::mutex> lock(_programs_mutex);
+        pool = _warmup_pool.get();
+    }
+    if (pool)
+        pool->wait_idle();
+}
+
+bool ocl_device::get_build_record(const std::string& module_name, const std::string& options, build_record& record)
+{
+    auto key = program_key(module_name, options);
+    std::lock_guard<std::mutex> lock(_programs_mutex);
+    auto it = _build_records.find(key);
+    if (it == _build_records.end())
+        return false;
+    record = it->second;
+    return true;
+}
+}
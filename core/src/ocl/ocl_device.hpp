@@ -0,0 +1,140 @@
+// Copyright (c) 2017-2018 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <string>
+#include <atomic>
+#include <future>
+#include <memory>
+#include <mutex>
+
+#define CL_HPP_ENABLE_EXCEPTIONS
+#define CL_HPP_MINIMUM_OPENCL_VERSION 120
+#define CL_HPP_TARGET_OPENCL_VERSION 120
+#include <cl2_wrapper.h>
+
+#include "append_only_map.hpp"
+#include "engine.hpp"
+#include "ocl_program_cache.hpp"
+#include "thread_pool.hpp"
+
+namespace iclgpu
+{
+class primitive_db;
+class ocl_primitive_db;
+
+/// @brief Device state shared by all contexts using the same OpenCL device in the process
+/// @details Holds OpenCL context, kernel sources and built programs, so the second context of the device
+/// neither creates OpenCL context nor builds modules. Queues, kernel objects and memory stay in ocl_toolkit.
+/// The object is destroyed with the last context using it.
+class ocl_device
+{
+public:
+    /// @brief Returns state of the @p device, creates it if the device is not used by any context
+    static std::shared_ptr<ocl_device> acquire(const cl::Device& device);
+
+    explicit ocl_device(const cl::Device& device);
+    ~ocl_device(); // -required because ocl_primitive_db is incomplete type
+
+    const cl::Context& get_cl_context() const { return _ocl_context; }
+    const cl::Device& get_cl_device() const { return _device; }
+    /// @brief Returns alignment of sub-buffer origin in bytes
+    size_t get_base_address_align() const { return _base_address_align; }
+    primitive_db* get_primitive_db() const;
+    /// @brief Returns counter of replaced sources, programs built before the replacement are not used anymore
+    uint64_t get_sources_version() const;
+
+    /// @brief Builds program for the module.
+    /// @details Uses on-disk binary cache if it is enabled, then precompiled SPIR-V module if the device accepts IL
+    /// and no @p options are set, otherwise compiles primitive DB sources.
+    cl::Program build_program(const std::string& module_name, const std::string& options,
+                              module_build_info::origin_type& origin);
+
+    /// @brief Returns module program built with @p options. Thread-safe, each variant of module is built once.
+    /// @param requester Identifier of the context, reported by get_build_info() if the module is built by the call
+    const cl::Program& get_module(const std::string& module_name, const std::string& options, size_t requester);
+
+    /// @brief Returns true if the module variant is built, otherwise schedules its build on background threads.
+    /// @details Variant which failed to build is not scheduled again, the call keeps returning false.
+    bool prepare_module(const std::string& module_name, const std::string& options, size_t requester);
+
+    /// @brief Schedules building of modules on background threads.
+    void warmup(const std::vector<std::string>& modules, size_t requester);
+    void wait_warmup();
+
+    /// @brief Build statistics of the module and identifier of the context which requested the build
+    struct build_record
+    {
+        size_t            requester;
+        module_build_info info;
+    };
+    /// @brief Returns statistics of the module variant built from current sources
+    /// @returns false if the module is not built yet
+    bool get_build_record(const std::string& module_name, const std::string& options, build_record& record);
+
+    /// @brief Device-specific data files are kept in the program cache directory, see engine::load_device_data()
+    bool load_device_data(const std::string& name, std::string& data) const;
+    void store_device_data(const std::string& name, const std::string& data);
+
+private:
+    /// @brief Module build claimed either by warm-up thread or by the first get_module() caller
+    struct module_build_task
+    {
+        std::atomic<bool>         claimed{false};
+        // Set once the build is queued to the warm-up pool
+        std::atomic<bool>         scheduled{false};
+        std::promise<cl::Program> promise;
+        size_t                    requester = 0;
+    };
+
+    struct module_entry
+    {
+        std::shared_future<cl::Program>    program;
+        std::shared_ptr<module_build_task> task;
+    };
+
+    cl::Device                                    _device;
+    cl::Context                                   _ocl_context;
+    std::unique_ptr<ocl_primitive_db>             _primitive_db;
+    std::mutex                                    _programs_mutex;
+    // Keyed by module name, build options and sources version, see program_key()
+    std::unordered_map<std::string, module_entry> _programs;
+    // Successfully built programs looked up without locks
+    append_only_map<std::string, cl::Program>     _built_programs;
+    std::unordered_map<std::string, build_record> _build_records;
+    // Keys of programs which failed to build, prepare_module() does not retry them
+    std::unordered_set<std::string>               _failed_programs;
+    ocl_program_cache                             _program_cache;
+    std::string                                   _device_hash;
+    bool                                          _il_supported = false;
+    size_t                                        _base_address_align = 1;
+    // Destroyed first: background builds use other members
+    std::unique_ptr<thread_pool>                  _warmup_pool;
+
+    std::string program_key(const std::string& module_name, const std::string& options) const;
+    module_entry acquire_module(const std::string& key, size_t requester);
+    void build_module(const std::string& key, const std::string& module_name, const std::string& options,
+                      module_build_task& task, bool background);
+    void schedule_build(const std::string& key, const std::string& module_name, const std::string& options,
+                        const std::shared_ptr<module_build_task>& task);
+
+    std::string get_program_cache_key(const std::string& module_name, const std::string& options);
+    cl::Program build_program_from_il(const std::string& module_name, const std::string& options);
+    cl::Program build_program_from_source(const std::string& module_name, const std::string& options);
+};
+
+}
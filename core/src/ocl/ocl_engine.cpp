@@ -29,21 +29,84 @@ ocl_engine::ocl_engine(const std::shared_ptr<iclgpu::context>& ctx)
 
 ocl_engine::~ocl_engine() = default;
 
+float ocl_engine::get_device_weight() const
+{
+    return _ocl_toolkit->get_device_weight();
+}
+
+bool ocl_engine::is_host_memory_shared() const
+{
+    return _ocl_toolkit->is_host_memory_shared();
+}
+
+std::vector<std::string> ocl_engine::get_device_names()
+{
+    std::vector<std::string> names;
+    for (auto& device : ocl_toolkit::get_devices())
+        names.push_back(device.getInfo<CL_DEVICE_NAME>());
+    return names;
+}
+
 primitive_db* ocl_engine::get_primitive_db()
 {
     return _ocl_toolkit->get_primitive_db();
 }
 
-std::shared_ptr<kernel_command> ocl_engine::get_kernel(const std::string& name, const std::string& module)
+std::shared_ptr<kernel_command> ocl_engine::get_kernel(const std::string& name, const std::string& module,
+                                                       const kernel_defines& defines)
 {
     auto module_name = module.empty() ? name : module;
-    return std::make_shared<ocl_kernel>(shared_from_this(), cl::Kernel(toolkit().get_module(module_name), name.c_str()));
+    return std::make_shared<ocl_kernel>(shared_from_this(), module_name, name, ocl_toolkit::build_options(defines));
 }
 
-std::shared_ptr<buffer> ocl_engine::create_buffer(size_t size, void* ptr)
+std::shared_ptr<kernel_command> ocl_engine::get_specialized_kernel(const std::string& name, const std::string& module,
+                                                                   const kernel_defines& defines)
+{
+    auto module_name = module.empty() ? name : module;
+    auto options = ocl_toolkit::build_options(defines);
+    // Do not wait for compilation of the variant, the default module may be precompiled or already built
+    if (!options.empty() && !_ocl_toolkit->prepare_module(module_name, options))
+        options.clear();
+    return std::make_shared<ocl_kernel>(shared_from_this(), module_name, name, options);
+}
+
+namespace
+{
+/// @brief Fills buffer with zeros, recorded instead of the fill done by buffer creation during capture
+struct ocl_zero_fill_command : command
+{
+    ocl_zero_fill_command(const std::shared_ptr<ocl_engine>& engine, const std::shared_ptr<ocl_buffer>& buffer)
+        : command(engine)
+        , _buffer(buffer) {}
+
+    std::shared_ptr<event> submit(const std::vector<std::shared_ptr<event>>& dependencies = {},
+                                  const command_queue&                       queue        = default_queue) override
+    {
+        auto engine    = get_engine<ocl_engine>();
+        auto cl_events = make_cl_events(dependencies, engine);
+        const uint8_t zero = 0;
+        cl::Event evt;
+        engine->toolkit().get_cl_queue(queue).enqueueFillBuffer(_buffer->get_handle(), zero, 0, _buffer->size(),
+                                                                &cl_events, &evt);
+        _buffer->set_last_use(queue, evt);
+        return std::make_shared<ocl_event>(shared_from_this(), evt, evt);
+    }
+
+private:
+    std::shared_ptr<ocl_buffer> _buffer;
+};
+}
+
+std::shared_ptr<buffer> ocl_engine::create_buffer(size_t size, void* ptr, buffer_init init)
 {
     if (size == 0) throw std::invalid_argument("size should not be zero.");
-    return std::make_shared<ocl_buffer>(shared_from_this(), size, ptr);
+    if (ptr == nullptr && init == buffer_init::zero && toolkit().is_capturing())
+    {
+        auto result = std::make_shared<ocl_buffer>(shared_from_this(), size, nullptr, buffer_init::uninitialized);
+        if (toolkit().capture(std::make_shared<ocl_zero_fill_command>(shared_from_this(), result)))
+            return result;
+    }
+    return std::make_shared<ocl_buffer>(shared_from_this(), size, ptr, init);
 }
 
 namespace
@@ -55,7 +118,7 @@ struct ocl_raise_event_command : raise_event_command
                                   const command_queue&                       queue        = default_queue) override
     {
         auto engine    = get_engine<ocl_engine>();
-        auto cl_events = make_cl_events(dependencies);
+        auto cl_events = make_cl_events(dependencies, engine);
         auto ocl_queue = engine->toolkit().get_cl_queue(queue);
 
         cl::Event evt;
@@ -117,10 +180,52 @@ ocl_engine::get_commands_sequence(const std::vector<std::shared_ptr<command>>& c
     return result;
 }
 
+namespace
+{
+/// @brief Spreads commands across engine queues, so they may run concurrently
+class ocl_commands_parallel : public commands_parallel
+{
+public:
+    using commands_parallel::commands_parallel;
+
+    std::shared_ptr<event> submit(const std::vector<std::shared_ptr<event>>& dependencies,
+                                  const command_queue&                       queue) override
+    {
+        auto  engine = get_engine<ocl_engine>();
+        auto& toolkit = engine->toolkit();
+        const auto queues_count = toolkit.get_queues_count();
+        if (queues_count < 2 || _commands.size() < 2)
+            return commands_parallel::submit(dependencies, queue);
+
+        // Buffers of the commands are written or filled on the default queue when arguments are set
+        cl::Event init_evt;
+        toolkit.get_cl_queue().enqueueMarkerWithWaitList(nullptr, &init_evt);
+        auto deps = dependencies;
+        deps.push_back(std::make_shared<ocl_event>(shared_from_this(), init_evt, init_evt));
+
+        std::vector<std::shared_ptr<event>> events;
+        cl::Event start_evt;
+        for (size_t i = 0; i < _commands.size(); ++i)
+        {
+            const command_queue cmd_queue((queue.id() + i) % queues_count);
+            const auto evt = _commands[i]->submit(deps, cmd_queue);
+            if (const auto ocl_evt = std::dynamic_pointer_cast<ocl_event>(evt))
+                start_evt = start_evt.get() ? start_evt : ocl_evt->get_start_handle();
+            events.push_back(evt);
+        }
+
+        auto cl_events = make_cl_events(events, engine);
+        cl::Event end_evt;
+        toolkit.get_cl_queue(queue).enqueueMarkerWithWaitList(&cl_events, &end_evt);
+        return std::make_shared<ocl_event>(shared_from_this(), start_evt.get() ? start_evt : end_evt, end_evt);
+    }
+};
+}
+
 std::shared_ptr<commands_parallel>
 ocl_engine::get_commands_parallel(const std::vector<std::shared_ptr<command>>& commands)
 {
-    auto result = std::make_shared<commands_parallel>(shared_from_this());
+    auto result = std::make_shared<ocl_commands_parallel>(shared_from_this());
     for (const auto& cmd : commands)
     {
         result->add(cmd);
@@ -128,4 +233,84 @@ ocl_engine::get_commands_parallel(const std::vector<std::shared_ptr<command>>& c
     return result;
 }
 
+void ocl_engine::warmup(const std::vector<std::string>& modules)
+{
+    toolkit().warmup(modules);
+}
+
+void ocl_engine::wait_warmup()
+{
+    toolkit().wait_warmup();
+}
+
+std::vector<module_build_info> ocl_engine::get_build_info()
+{
+    return toolkit().get_build_info();
+}
+
+buffer_pool_stats ocl_engine::get_buffer_pool_stats()
+{
+    return toolkit().get_buffer_pool().get_stats();
+}
+
+void ocl_engine::trim_buffer_pool()
+{
+    toolkit().get_buffer_pool().trim();
+}
+
+void ocl_engine::register_host_memory(void* ptr, size_t size)
+{
+    toolkit().get_host_registry().add(ptr, size);
+}
+
+void ocl_engine::unregister_host_memory(void* ptr)
+{
+    toolkit().get_host_registry().remove(ptr);
+}
+
+void ocl_engine::sync_host_memory(void* ptr, size_t size)
+{
+    toolkit().get_host_registry().sync(ptr, size);
+}
+
+std::shared_ptr<buffer> ocl_engine::get_registered_buffer(void* ptr, size_t size)
+{
+    return toolkit().get_host_registry().find(shared_from_this(), ptr, size);
+}
+
+void ocl_engine::begin_capture()
+{
+    toolkit().begin_capture();
+}
+
+captured_commands ocl_engine::end_capture()
+{
+    return toolkit().end_capture();
+}
+
+bool ocl_engine::is_capturing()
+{
+    return toolkit().is_capturing();
+}
+
+void ocl_engine::set_profiling(bool enabled)
+{
+    toolkit().set_profiling(enabled);
+}
+
+bool ocl_engine::is_profiling_enabled()
+{
+    return toolkit().is_profiling_enabled();
+}
+
+bool ocl_engine::load_device_data(const std::string& name, std::string& data)
+{
+    return toolkit().load_device_data(name, data);
+}
+
+void ocl_engine::store_device_data(const std::string& name, const std::string& data)
+{
+    toolkit().store_device_data(name, data);
+}
+
 }
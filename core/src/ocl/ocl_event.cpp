@@ -14,6 +14,7 @@
 
 #include "ocl/ocl_engine.hpp"
 #include "ocl_event.hpp"
+#include "errors.hpp"
 
 namespace iclgpu
 {
@@ -24,24 +25,69 @@ ocl_event::ocl_event(const std::shared_ptr<engine_object>& obj, const cl::Event&
     , _start_event(start_event)
     , _end_event(end_event) {}
 
-std::chrono::nanoseconds ocl_event::wait()
+void ocl_event::wait()
+{
+    _end_event.wait();
+}
+
+std::chrono::nanoseconds ocl_event::duration()
 {
     _end_event.wait();
     cl_ulong start;
-    _start_event.getProfilingInfo(CL_PROFILING_COMMAND_SUBMIT, &start);
     cl_ulong end;
-    _start_event.getProfilingInfo(CL_PROFILING_COMMAND_END, &end);
+    try
+    {
+        _start_event.getProfilingInfo(CL_PROFILING_COMMAND_SUBMIT, &start);
+        _start_event.getProfilingInfo(CL_PROFILING_COMMAND_END, &end);
+    }
+    catch (const cl::Error& err)
+    {
+        if (err.err() == CL_PROFILING_INFO_NOT_AVAILABLE)
+            throw error_unsupported("Profiling is not enabled");
+        throw;
+    }
     return std::chrono::nanoseconds(static_cast<long long>(end - start));
 }
 
-std::vector<cl::Event> make_cl_events(const std::vector<std::shared_ptr<event>>& dependencies)
+static void CL_CALLBACK call_completion(cl_event, cl_int, void* user_data)
 {
-    std::vector<cl::Event> result;
-    result.reserve(dependencies.size());
+    std::unique_ptr<std::function<void()>> callback(static_cast<std::function<void()>*>(user_data));
+    try
+    {
+        (*callback)();
+    }
+    catch (...)
+    {
+        // Exceptions must not reach the OpenCL runtime
+    }
+}
 
+void ocl_event::on_completion(const std::function<void()>& callback)
+{
+    if (_end_event() == nullptr)
+    {
+        callback();
+        return;
+    }
+    // Owned by call_completion(), which the runtime calls exactly once
+    std::unique_ptr<std::function<void()>> pending(new std::function<void()>(callback));
+    _end_event.setCallback(CL_COMPLETE, call_completion, pending.get());
+    pending.release();
+}
+
+static void append_cl_events(std::vector<cl::Event>& result, const std::vector<std::shared_ptr<event>>& dependencies,
+                             const std::shared_ptr<engine>& engine)
+{
     for (auto& evt : dependencies)
     {
-        if (auto clEvt = std::dynamic_pointer_cast<ocl_event>(evt))
+        if (auto group = std::dynamic_pointer_cast<event_group>(evt))
+        {
+            append_cl_events(result, group->events(), engine);
+            continue;
+        }
+        // Handles of other engines belong to other OpenCL contexts
+        auto clEvt = std::dynamic_pointer_cast<ocl_event>(evt);
+        if (clEvt && clEvt->get_engine() == engine)
         {
             result.push_back(clEvt->get_end_handle());
         }
@@ -51,6 +97,14 @@ std::vector<cl::Event> make_cl_events(const std::vector<std::shared_ptr<event>>&
             evt->wait();
         }
     }
+}
+
+std::vector<cl::Event> make_cl_events(const std::vector<std::shared_ptr<event>>& dependencies,
+                                      const std::shared_ptr<engine>& engine)
+{
+    std::vector<cl::Event> result;
+    result.reserve(dependencies.size());
+    append_cl_events(result, dependencies, engine);
     return result;
 }
 
@@ -25,7 +25,10 @@ class ocl_event : public event
 public:
     ocl_event(const std::shared_ptr<engine_object>& obj, const cl::Event& start_event, const cl::Event& end_event);
 
-    std::chrono::nanoseconds wait() override;
+    void wait() override;
+    std::chrono::nanoseconds duration() override;
+    /// @brief Calls @p callback from OpenCL runtime thread when the command is completed or failed
+    void on_completion(const std::function<void()>& callback) override;
 
     const cl::Event& get_start_handle() const { return _start_event; }
     const cl::Event& get_end_handle() const { return _end_event; }
@@ -36,6 +39,9 @@ private:
     cl::Event                      _end_event;
 };
 
-std::vector<cl::Event> make_cl_events(const std::vector<std::shared_ptr<event>>& dependencies);
+/// @brief Returns handles of @p dependencies to wait for on queues of @p engine
+/// @details Events of other engines are waited on the host.
+std::vector<cl::Event> make_cl_events(const std::vector<std::shared_ptr<event>>& dependencies,
+                                      const std::shared_ptr<engine>& engine);
 
 }
@@ -0,0 +1,162 @@
+// Copyright (c) 2017-2018 Intel Corporation
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//      http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ocl_host_registry.hpp"
+#include "ocl_buffer.hpp"
+#include "ocl_toolkit.hpp"
+#include <stdexcept>
+
+namespace iclgpu
+{
+
+ocl_host_registry::ocl_host_registry(ocl_toolkit& toolkit)
+    : _toolkit(toolkit) {}
+
+void ocl_host_registry::add(void* ptr, size_t size)
+{
+    if (ptr == nullptr || size == 0)
+        throw std::invalid_argument("host memory range is empty");
+
+    auto address = reinterpret_cast<uintptr_t>(ptr);
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto next = _ranges.lower_bound(address);
+    if (next != _ranges.end() && next->first < address + size)
+        throw std::invalid_argument("host memory range is already registered");
+    if (next != _ranges.begin() && std::prev(next)->first + std::prev(next)->second.size > address)
+        throw std::invalid_argument("host memory range is already registered");
+
+    registration reg;
+    reg.size = size;
+    reg.flags = make_buffer_flags(size, ptr);
+    reg.buffer = cl::Buffer(_toolkit.get_cl_context(), reg.flags, size, ptr);
+    reg.stale = false;
+    _ranges.emplace(address, std::move(reg));
+    ++_count;
+}
+
+void ocl_host_registry::remove(void* ptr)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_ranges.erase(reinterpret_cast<uintptr_t>(ptr)) == 0)
+        throw std::invalid_argument("host memory is not registered");
+    --_count;
+}
+
+std::map<uintptr_t, ocl_host_registry::registration>::iterator
+ocl_host_registry::find_range(uintptr_t address, size_t size)
+{
+    auto it = _ranges.upper_bound(address);
+    if (it == _ranges.begin())
+        return _ranges.end();
+    --it;
+    if (address + size > it->first + it->second.size)
+        return _ranges.end();
+    return it;
+}
+
+void ocl_host_registry::sync(void* ptr, size_t size)
+{
+    auto address = reinterpret_cast<uintptr_t>(ptr);
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = find_range(address, size == 0 ? 1 : size);
+    if (it == _ranges.end())
+        throw std::invalid_argument("host memory is not registered");
+
+    auto& reg = it->second;
+    auto offset = address - it->first;
+    if (size == 0)
+        size = reg.size - offset;
+
+    auto& queue = _toolkit.get_cl_queue();
+    if (reg.use_host_pointer())
+    {
+        // Map/unmap pair is the portable way to publish host writes to the device
+        auto mapped = queue.enqueueMapBuffer(reg.buffer, true, CL_MAP_WRITE, offset, size);
+        cl::Event evt;
+        queue.enqueueUnmapMemObject(reg.buffer, mapped, nullptr, &evt);
+        evt.wait();
+    }
+    else if (reg.stale)
+    {
+        queue.enqueueWriteBuffer(reg.buffer, true, 0, reg.size, reinterpret_cast<void*>(it->first));
+        reg.stale = false;
+    }
+    else
+    {
+        queue.enqueueWriteBuffer(reg.buffer, true, offset, size, ptr);
+    }
+}
+
+std::shared_ptr<ocl_buffer> ocl_host_registry::find(const std::shared_ptr<ocl_engine>& engine, void* ptr, size_t size)
+{
+    if (_count == 0)
+        return nullptr;
+
+    auto address = reinterpret_cast<uintptr_t>(ptr);
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = find_range(address, size);
+    if (it == _ranges.end())
+        return nullptr;
+
+    auto& reg = it->second;
+    auto& queue = _toolkit.get_cl_queue();
+    if (reg.stale)
+    {
+        queue.enqueueWriteBuffer(reg.buffer, true, 0, reg.size, reinterpret_cast<void*>(it->first));
+        reg.stale = false;
+    }
+
+    auto offset = address - it->first;
+    if (offset == 0 && size == reg.size)
+        return std::make_shared<ocl_buffer>(engine, reg.buffer, size, reg.flags);
+
+    if (offset % _toolkit.get_base_address_align() == 0)
+    {
+        auto& sub_buffer = reg.sub_buffers[{offset, size}];
+        if (!sub_buffer())
+        {
+            cl_buffer_region region = { offset, size };
+            sub_buffer = reg.buffer.createSubBuffer(CL_MEM_READ_WRITE, CL_BUFFER_CREATE_TYPE_REGION, &region);
+        }
+        return std::make_shared<ocl_buffer>(engine, sub_buffer, size, reg.flags);
+    }
+
+    // Host data of aligned ranges is used in place, regular buffer is not slower here
+    if (reg.use_host_pointer())
+        return nullptr;
+
+    // Device-side copy is cheaper than host upload. Outputs are written back to the host and mark the range stale.
+    auto result = std::make_shared<ocl_buffer>(engine, size, nullptr, buffer_init::uninitialized);
+    queue.enqueueCopyBuffer(reg.buffer, result->get_handle(), offset, 0, size);
+    return result;
+}
+
+void ocl_host_registry::host_written(const void* ptr, size_t size)
+{
+    if (_count == 0)
+        return;
+
+    auto address = reinterpret_cast<uintptr_t>(ptr);
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _ranges.upper_bound(address);
+    if (it != _ranges.begin())
+        --it;
+    for (; it != _ranges.end() && it->first < address + size; ++it)
+    {
+        if (it->first + it->second.size > address && !it->second.use_host_pointer())
+            it->second.stale = true;
+    }
+}
+
+}
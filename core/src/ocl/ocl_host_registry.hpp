@@ -0,0 +1,81 @@
+// Copyright (c) 2017-2018 Intel Corporation
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//      http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#define CL_HPP_ENABLE_EXCEPTIONS
+#define CL_HPP_MINIMUM_OPENCL_VERSION 120
+#define CL_HPP_TARGET_OPENCL_VERSION 120
+#include <cl2_wrapper.h>
+
+namespace iclgpu
+{
+class ocl_engine;
+class ocl_buffer;
+class ocl_toolkit;
+
+/// @brief Host memory ranges registered by user with OpenCL buffers created once for them.
+/// @details Aligned ranges are used by the device in place (CL_MEM_USE_HOST_PTR),
+/// other ranges get a device copy which is updated by sync() and after the library writes the host data.
+class ocl_host_registry
+{
+public:
+    explicit ocl_host_registry(ocl_toolkit& toolkit);
+
+    /// @brief Registers host range. Throws std::invalid_argument if it overlaps already registered range.
+    void add(void* ptr, size_t size);
+
+    /// @brief Unregisters range started at @p ptr. Throws std::invalid_argument if it is not registered.
+    void remove(void* ptr);
+
+    /// @brief Makes host changes of the registered data visible to the device
+    /// @param size Number of bytes starting at @p ptr, zero means up to the end of the registered range
+    void sync(void* ptr, size_t size);
+
+    /// @brief Returns buffer for the host range lying inside a registered range, or null if there is no such range
+    /// @details Interior pointers are resolved to sub-buffers when the offset meets the device alignment,
+    /// otherwise the data is copied from the device copy of the registered range.
+    std::shared_ptr<ocl_buffer> find(const std::shared_ptr<ocl_engine>& engine, void* ptr, size_t size);
+
+    /// @brief Marks device copies of the host range outdated. Called after the library wrote the host data.
+    void host_written(const void* ptr, size_t size);
+
+private:
+    struct registration
+    {
+        size_t       size;
+        cl_mem_flags flags;
+        cl::Buffer   buffer;
+        bool         stale;
+        std::map<std::pair<size_t, size_t>, cl::Buffer> sub_buffers;
+
+        bool use_host_pointer() const { return (flags & CL_MEM_USE_HOST_PTR) != 0; }
+    };
+
+    ocl_toolkit&                        _toolkit;
+    std::mutex                          _mutex;
+    std::map<uintptr_t, registration>   _ranges;
+    // Checked without the lock: most of applications do not register memory at all
+    std::atomic<size_t>                 _count{0};
+
+    std::map<uintptr_t, registration>::iterator find_range(uintptr_t address, size_t size);
+};
+
+}
@@ -16,6 +16,7 @@
 #include "ocl_kernel.hpp"
 #include "ocl_buffer.hpp"
 #include "ocl_event.hpp"
+#include "tracer.hpp"
 #include <algorithm>
 #include <utility>
 #include <cassert>
@@ -28,6 +29,20 @@ ocl_kernel::ocl_kernel(const std::shared_ptr<ocl_engine>& engine, const cl::Kern
     : kernel_command(engine)
     , _kernel(handle) {}
 
+ocl_kernel::ocl_kernel(const std::shared_ptr<ocl_engine>& engine, const std::string& module_name, const std::string& kernel_name,
+                       const std::string& options)
+    : kernel_command(engine)
+    , _module_name(module_name)
+    , _kernel_name(kernel_name)
+    , _options(options)
+    , _kernel(engine->toolkit().acquire_kernel(module_name, kernel_name, options)) {}
+
+ocl_kernel::~ocl_kernel()
+{
+    if (!_kernel_name.empty())
+        get_engine<ocl_engine>()->toolkit().release_kernel(_module_name, _kernel_name, _options, _kernel);
+}
+
 void ocl_kernel::set_buffer_arg(unsigned idx, const std::shared_ptr<buffer_binding>& binding)
 {
     if(!binding->is_defined())
@@ -40,6 +55,29 @@ void ocl_kernel::set_buffer_arg(unsigned idx, const std::shared_ptr<buffer_bindi
 
     auto oclBuffer = down_pointer_cast<ocl_buffer>(buffer);
     _kernel.setArg(idx, oclBuffer->get_handle());
+    get_engine<ocl_engine>()->toolkit().capture_binding(binding);
+}
+
+std::vector<cl::Event> ocl_kernel::refresh_buffers(const command_queue& queue, const std::vector<cl::Event>& dependencies)
+{
+    auto engine = get_engine<ocl_engine>();
+    std::vector<cl::Event> result;
+    for (auto& pair : _buffers)
+    {
+        auto& binding = pair.second;
+        if (binding->get_owning_engine() == engine)
+            continue;
+
+        // Binding may be rebound to other host data since the previous submission
+        auto buf = down_pointer_cast<ocl_buffer>(binding->get_buffer(engine));
+        _kernel.setArg(pair.first, buf->get_handle());
+        if (!binding->is_input())
+            continue;
+        auto evt = buf->write(queue, dependencies, binding->get_host_ptr());
+        if (evt())
+            result.push_back(evt);
+    }
+    return result;
 }
 
 void ocl_kernel::set_options(const kernel_options& params)
@@ -54,15 +92,59 @@ void ocl_kernel::set_options(const kernel_options& params)
 
     _gws = gws;
     _lws = lws;
+    _work_size = params.work_size();
+    _parallel_size = params.parallel_size();
+}
+
+void ocl_kernel::trace(const command_queue& queue, const cl::Event& evt)
+{
+    tracer::command_info info;
+    info.name = _kernel_name.empty() ? _kernel.getInfo<CL_KERNEL_FUNCTION_NAME>() : _kernel_name;
+    info.work_size = _work_size;
+    info.parallel_size = _parallel_size;
+    info.queue = queue.id();
+    info.query = [evt](bool wait, command_timestamps& timestamps)
+    {
+        if (wait)
+            evt.wait();
+        else if (evt.getInfo<CL_EVENT_COMMAND_EXECUTION_STATUS>() != CL_COMPLETE)
+            return false;
+        evt.getProfilingInfo(CL_PROFILING_COMMAND_QUEUED, &timestamps.queued);
+        evt.getProfilingInfo(CL_PROFILING_COMMAND_SUBMIT, &timestamps.submit);
+        evt.getProfilingInfo(CL_PROFILING_COMMAND_START, &timestamps.start);
+        evt.getProfilingInfo(CL_PROFILING_COMMAND_END, &timestamps.end);
+        return true;
+    };
+    tracer::add_command(std::move(info));
 }
 
 std::shared_ptr<event> ocl_kernel::submit(const std::vector<std::shared_ptr<event>>& dependencies,
                                           const command_queue&                       queue)
 {
     auto engine     = get_engine<ocl_engine>();
-    auto dep_events = make_cl_events(dependencies);
+    if (engine->toolkit().capture(down_pointer_cast<command>(shared_from_this())))
+    {
+        _refresh_buffers = true;
+        return engine->get_raise_event_command()->submit({}, queue);
+    }
+
+    auto dep_events = make_cl_events(dependencies, engine);
     auto ocl_queue  = engine->toolkit().get_cl_queue(queue);
 
+    for (auto& pair : _buffers)
+    {
+        auto& upload = down_pointer_cast<ocl_buffer>(pair.second->get_buffer(engine))->get_upload_event();
+        if (upload.get() != nullptr)
+            dep_events.push_back(upload);
+    }
+
+    if (_refresh_buffers)
+    {
+        auto write_events = refresh_buffers(queue, dep_events);
+        dep_events.insert(dep_events.end(), write_events.begin(), write_events.end());
+    }
+    _refresh_buffers = true;
+
     std::vector<cl::Event> unmap_events;
     for (auto& pair : _buffers)
     {
@@ -80,6 +162,10 @@ std::shared_ptr<event> ocl_kernel::submit(const std::vector<std::shared_ptr<even
 
     cl::Event krnl_evt;
     ocl_queue.enqueueNDRangeKernel(_kernel, cl::NullRange, _gws, _lws, krnl_wait_events, &krnl_evt);
+    // Device times are available only with profiling, host spans are recorded regardless.
+    // Profiling may be switched meanwhile, so the queue of the kernel is checked.
+    if (tracer::enabled() && (ocl_queue.getInfo<CL_QUEUE_PROPERTIES>() & CL_QUEUE_PROFILING_ENABLE) != 0)
+        trace(queue, krnl_evt);
     std::vector<cl::Event> buf_events;
     for (auto& pair : _buffers)
     {
@@ -107,6 +193,11 @@ std::shared_ptr<event> ocl_kernel::submit(const std::vector<std::shared_ptr<even
     default:
         ocl_queue.enqueueMarkerWithWaitList(&buf_events, &result_evt);
     }
+
+    for (auto& pair : _buffers)
+    {
+        down_pointer_cast<ocl_buffer>(pair.second->get_buffer(engine))->set_last_use(queue, result_evt);
+    }
     return std::make_shared<ocl_event>(shared_from_this(), krnl_evt, result_evt);
 }
 
@@ -24,6 +24,11 @@ class ocl_kernel : public kernel_command
 {
 public:
     ocl_kernel(const std::shared_ptr<ocl_engine>& engine, const cl::Kernel& handle);
+    /// @brief Creates command for pooled kernel object which is returned to the engine pool on destruction
+    /// @param options Build options of the module variant, see ocl_toolkit::build_options()
+    ocl_kernel(const std::shared_ptr<ocl_engine>& engine, const std::string& module_name, const std::string& kernel_name,
+               const std::string& options = std::string());
+    ~ocl_kernel() override;
 
     void set_scalar_arg(unsigned idx, const void* ptr, size_t size) override
     {
@@ -38,10 +43,22 @@ public:
                                   const command_queue&                       queue        = default_queue) override;
 
 private:
+    std::string _module_name;
+    std::string _kernel_name;
+    std::string _options;
     cl::Kernel  _kernel;
     cl::NDRange _gws;
     cl::NDRange _lws;
+    nd_range    _work_size;
+    nd_range    _parallel_size;
     std::map<unsigned, std::shared_ptr<buffer_binding>> _buffers;
+    // Host data is copied to buffers when they are created, so only later submissions copy it again
+    bool        _refresh_buffers = false;
+
+    /// @brief Records the kernel execution in the tracer
+    void trace(const command_queue& queue, const cl::Event& evt);
+
+    std::vector<cl::Event> refresh_buffers(const command_queue& queue, const std::vector<cl::Event>& dependencies);
 
     static cl::NDRange ocl_range(const nd_range& v)
     {
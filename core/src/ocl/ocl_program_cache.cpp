@@ -0,0 +1,435 @@
+// Copyright (c) 2017-2018 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ocl_program_cache.hpp"
+#include "environment.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iterator>
+#include <tuple>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <direct.h>
+#include <process.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/utime.h>
+#else
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#include <utime.h>
+#endif
+
+namespace iclgpu
+{
+
+namespace
+{
+const char entry_magic[8] = { 'I', 'C', 'L', 'G', 'P', 'U', 'P', 'B' };
+const char entry_ext[] = ".bin";
+const char temp_ext[] = ".tmp";
+// Temporary files older than this are leftovers of crashed writers
+const time_t stale_temp_age = 60 * 60;
+
+#ifdef _WIN32
+const char path_separator = '\\';
+#else
+const char path_separator = '/';
+#endif
+
+bool ends_with(const std::string& str, const char* suffix)
+{
+    auto len = std::strlen(suffix);
+    return str.size() >= len && str.compare(str.size() - len, len, suffix) == 0;
+}
+
+bool is_directory(const std::string& path)
+{
+#ifdef _WIN32
+    auto attr = GetFileAttributesA(path.c_str());
+    return attr != INVALID_FILE_ATTRIBUTES && (attr & FILE_ATTRIBUTE_DIRECTORY);
+#else
+    struct stat st;
+    return stat(path.c_str(), &st) == 0 && S_ISDIR(st.st_mode);
+#endif
+}
+
+bool make_directories(const std::string& path)
+{
+    for (size_t pos = 1; pos <= path.size(); ++pos)
+    {
+        if (pos != path.size() && path[pos] != '/' && path[pos] != path_separator)
+            continue;
+        auto sub_path = path.substr(0, pos);
+        if (is_directory(sub_path))
+            continue;
+#ifdef _WIN32
+        _mkdir(sub_path.c_str());
+#else
+        mkdir(sub_path.c_str(), 0755);
+#endif
+    }
+    return is_directory(path);
+}
+
+struct file_entry
+{
+    std::string path;
+    uint64_t size;
+    time_t mtime;
+};
+
+std::vector<file_entry> list_files(const std::string& directory)
+{
+    std::vector<file_entry> result;
+#ifdef _WIN32
+    WIN32_FIND_DATAA data;
+    auto handle = FindFirstFileA((directory + "\\*").c_str(), &data);
+    if (handle == INVALID_HANDLE_VALUE)
+        return result;
+    do
+    {
+        if (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+            continue;
+        ULARGE_INTEGER time;
+        time.LowPart = data.ftLastWriteTime.dwLowDateTime;
+        time.HighPart = data.ftLastWriteTime.dwHighDateTime;
+        // FILETIME is in 100ns intervals since 1601-01-01
+        auto mtime = static_cast<time_t>(time.QuadPart / 10000000ULL - 11644473600ULL);
+        auto size = (static_cast<uint64_t>(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+        result.push_back({ directory + path_separator + data.cFileName, size, mtime });
+    } while (FindNextFileA(handle, &data));
+    FindClose(handle);
+#else
+    auto dir = opendir(directory.c_str());
+    if (dir == nullptr)
+        return result;
+    while (auto entry = readdir(dir))
+    {
+        auto path = directory + path_separator + entry->d_name;
+        struct stat st;
+        if (stat(path.c_str(), &st) != 0 || !S_ISREG(st.st_mode))
+            continue;
+        result.push_back({ path, static_cast<uint64_t>(st.st_size), st.st_mtime });
+    }
+    closedir(dir);
+#endif
+    return result;
+}
+
+bool rename_file(const std::string& from, const std::string& to)
+{
+#ifdef _WIN32
+    return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    return std::rename(from.c_str(), to.c_str()) == 0;
+#endif
+}
+
+void touch_file(const std::string& path)
+{
+#ifdef _WIN32
+    _utime(path.c_str(), nullptr);
+#else
+    utime(path.c_str(), nullptr);
+#endif
+}
+
+int process_id()
+{
+#ifdef _WIN32
+    return _getpid();
+#else
+    return static_cast<int>(getpid());
+#endif
+}
+
+// Unique among threads and processes writing to the same directory
+std::string make_temp_path(const std::string& path)
+{
+    static std::atomic<unsigned> counter{0};
+    return path + "." + std::to_string(process_id()) + "." + std::to_string(counter++) + temp_ext;
+}
+
+std::string default_cache_directory()
+{
+    std::string base;
+#ifdef _WIN32
+    if (!get_environment_variable("LOCALAPPDATA", base) || base.empty())
+        return std::string();
+    return base + "\\iclgpu\\cache";
+#else
+    if (get_environment_variable("XDG_CACHE_HOME", base) && !base.empty())
+        return base + "/iclgpu";
+    if (get_environment_variable("HOME", base) && !base.empty())
+        return base + "/.cache/iclgpu";
+    return std::string();
+#endif
+}
+
+uint64_t checksum(const std::vector<unsigned char>& data)
+{
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (auto c : data)
+    {
+        hash ^= c;
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+template <typename T>
+void write_value(std::ostream& os, T value)
+{
+    os.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename T>
+bool read_value(std::istream& is, T& value)
+{
+    return static_cast<bool>(is.read(reinterpret_cast<char*>(&value), sizeof(value)));
+}
+} // namespace
+
+hash_builder& hash_builder::add(const void* data, size_t size)
+{
+    auto bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i)
+    {
+        _lo ^= bytes[i];
+        _lo *= 0x100000001b3ULL;
+        _hi ^= bytes[i];
+        _hi *= 0x100000001b3ULL;
+        _hi ^= _hi >> 29;
+    }
+    return *this;
+}
+
+hash_builder& hash_builder::add(const std::string& str)
+{
+    add(static_cast<uint64_t>(str.size()));
+    return add(str.data(), str.size());
+}
+
+hash_builder& hash_builder::add(uint64_t value)
+{
+    return add(&value, sizeof(value));
+}
+
+std::string hash_builder::str() const
+{
+    char buf[33];
+    std::snprintf(buf, sizeof(buf), "%016llx%016llx",
+                  static_cast<unsigned long long>(_hi), static_cast<unsigned long long>(_lo));
+    return buf;
+}
+
+ocl_program_cache::ocl_program_cache()
+{
+    std::string directory;
+    if (!get_environment_variable("ICLGPU_CACHE_DIR", directory))
+        directory = default_cache_directory();
+
+    uint64_t max_size = default_max_size;
+    std::string size_str;
+    if (get_environment_variable("ICLGPU_CACHE_MAX_SIZE", size_str))
+        max_size = parse_size_value(size_str, default_max_size);
+
+    init(directory, max_size);
+}
+
+ocl_program_cache::ocl_program_cache(const std::string& directory, uint64_t max_size)
+{
+    init(directory, max_size);
+}
+
+void ocl_program_cache::init(const std::string& directory, uint64_t max_size)
+{
+    _max_size = max_size;
+    if (directory.empty() || max_size == 0)
+        return;
+
+    // Entries of different format versions never meet each other
+    auto path = directory + path_separator + "v" + std::to_string(format_version);
+    if (make_directories(path))
+        _directory = path;
+}
+
+std::string ocl_program_cache::entry_path(const std::string& key) const
+{
+    return _directory + path_separator + key + entry_ext;
+}
+
+bool ocl_program_cache::load(const std::string& key, std::vector<unsigned char>& binary) const
+{
+    if (!enabled())
+        return false;
+
+    auto path = entry_path(key);
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+        return false;
+
+    char magic[sizeof(entry_magic)];
+    uint32_t version = 0;
+    uint32_t key_size = 0;
+    uint64_t size = 0;
+    uint64_t sum = 0;
+    if (!file.read(magic, sizeof(magic)) || std::memcmp(magic, entry_magic, sizeof(magic)) != 0)
+        return false;
+    if (!read_value(file, version) || version != format_version)
+        return false;
+    if (!read_value(file, key_size) || key_size != key.size())
+        return false;
+    std::string stored_key(key_size, '\0');
+    if (!file.read(&stored_key[0], key_size) || stored_key != key)
+        return false;
+    if (!read_value(file, size) || !read_value(file, sum) || size == 0 || size > _max_size)
+        return false;
+
+    std::vector<unsigned char> data(static_cast<size_t>(size));
+    if (!file.read(reinterpret_cast<char*>(data.data()), data.size()) || checksum(data) != sum)
+        return false;
+    file.close();
+
+    // Keep recently used entries from eviction
+    touch_file(path);
+    binary = std::move(data);
+    return true;
+}
+
+void ocl_program_cache::store(const std::string& key, const std::vector<unsigned char>& binary)
+{
+    if (!enabled() || binary.empty() || binary.size() > _max_size)
+        return;
+
+    auto path = entry_path(key);
+    auto temp_path = make_temp_path(path);
+
+    {
+        std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+        if (!file)
+            return;
+        file.write(entry_magic, sizeof(entry_magic));
+        write_value(file, format_version);
+        write_value(file, static_cast<uint32_t>(key.size()));
+        file.write(key.data(), key.size());
+        write_value(file, static_cast<uint64_t>(binary.size()));
+        write_value(file, checksum(binary));
+        file.write(reinterpret_cast<const char*>(binary.data()), binary.size());
+        file.close();
+        if (!file)
+        {
+            std::remove(temp_path.c_str());
+            return;
+        }
+    }
+
+    // Readers see either the old entry or the complete new one
+    if (!rename_file(temp_path, path))
+    {
+        std::remove(temp_path.c_str());
+        return;
+    }
+
+    evict(path);
+}
+
+bool ocl_program_cache::load_file(const std::string& name, std::string& content) const
+{
+    if (!enabled())
+        return false;
+
+    std::ifstream file(_directory + path_separator + name, std::ios::binary);
+    if (!file)
+        return false;
+    content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return !file.bad();
+}
+
+void ocl_program_cache::store_file(const std::string& name, const std::string& content)
+{
+    if (!enabled())
+        return;
+
+    auto path = _directory + path_separator + name;
+    auto temp_path = make_temp_path(path);
+    {
+        std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+        if (!file)
+            return;
+        file.write(content.data(), content.size());
+        file.close();
+        if (!file)
+        {
+            std::remove(temp_path.c_str());
+            return;
+        }
+    }
+
+    if (!rename_file(temp_path, path))
+        std::remove(temp_path.c_str());
+}
+
+void ocl_program_cache::evict(const std::string& keep_path)
+{
+    auto files = list_files(_directory);
+    auto now = std::time(nullptr);
+
+    std::vector<file_entry> entries;
+    uint64_t total_size = 0;
+    for (auto& f : files)
+    {
+        if (ends_with(f.path, entry_ext))
+        {
+            total_size += f.size;
+            entries.push_back(f);
+        }
+        else if (ends_with(f.path, temp_ext) && now - f.mtime > stale_temp_age)
+        {
+            std::remove(f.path.c_str());
+        }
+    }
+
+    if (total_size <= _max_size)
+        return;
+
+    std::sort(entries.begin(), entries.end(), [](const file_entry& l, const file_entry& r)
+    {
+        return std::tie(l.mtime, l.path) < std::tie(r.mtime, r.path);
+    });
+
+    for (auto& e : entries)
+    {
+        if (total_size <= _max_size)
+            break;
+        if (e.path == keep_path)
+            continue;
+        // The file can be already removed by another process
+        std::remove(e.path.c_str());
+        total_size -= e.size;
+    }
+}
+
+}
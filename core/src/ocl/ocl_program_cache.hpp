@@ -0,0 +1,83 @@
+// Copyright (c) 2017-2018 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <vector>
+#include <string>
+#include <cstdint>
+
+namespace iclgpu
+{
+
+/// @brief Incremental 128-bit hash (two FNV-1a lanes) used to build cache keys.
+class hash_builder
+{
+public:
+    hash_builder& add(const void* data, size_t size);
+    /// @brief Adds string together with its length, so concatenations of different strings produce different hashes.
+    hash_builder& add(const std::string& str);
+    hash_builder& add(uint64_t value);
+
+    /// @brief Returns hash as 32 characters hex string.
+    std::string str() const;
+
+private:
+    uint64_t _lo = 0xcbf29ce484222325ULL;
+    uint64_t _hi = 0x84222325cbf29ce4ULL;
+};
+
+/// @brief Persistent on-disk cache of OpenCL program binaries.
+/// @details Each entry is a separate file named by the key.
+/// Entries are written to a temporary file and atomically renamed, so several processes can share the cache directory.
+/// Total size of the cache is bounded, least recently used entries are evicted.
+/// I/O failures are never reported: the cache just behaves as empty.
+class ocl_program_cache
+{
+public:
+    /// @brief Version of the entry layout and key composition. Increment on incompatible changes.
+    static const uint32_t format_version = 1;
+    static const uint64_t default_max_size = 256ULL << 20;
+
+    /// @brief Creates cache configured by ICLGPU_CACHE_DIR and ICLGPU_CACHE_MAX_SIZE environment variables.
+    /// @details Empty ICLGPU_CACHE_DIR or zero ICLGPU_CACHE_MAX_SIZE disables the cache.
+    ocl_program_cache();
+    ocl_program_cache(const std::string& directory, uint64_t max_size);
+
+    bool enabled() const { return !_directory.empty(); }
+    const std::string& directory() const { return _directory; }
+
+    /// @brief Reads cached binary by key.
+    /// @returns false if there is no valid entry for the key.
+    bool load(const std::string& key, std::vector<unsigned char>& binary) const;
+
+    /// @brief Stores binary, evicts old entries if the cache size limit is exceeded.
+    void store(const std::string& key, const std::vector<unsigned char>& binary);
+
+    /// @brief Reads auxiliary file stored by store_file().
+    /// @returns false if the cache is disabled or the file does not exist.
+    bool load_file(const std::string& name, std::string& content) const;
+
+    /// @brief Atomically replaces auxiliary file in the cache directory. Auxiliary files are never evicted.
+    void store_file(const std::string& name, const std::string& content);
+
+private:
+    std::string _directory;
+    uint64_t _max_size;
+
+    void init(const std::string& directory, uint64_t max_size);
+    std::string entry_path(const std::string& key) const;
+    void evict(const std::string& keep_path);
+};
+
+}
@@ -15,96 +15,134 @@
 #include "ocl/ocl_engine.hpp"
 #include "ocl_toolkit.hpp"
 #include "primitive_db.hpp"
+#include "environment.hpp"
+#include "tracer.hpp"
+#include <algorithm>
+#include <thread>
 #include <utility>
 #include <cassert>
 
 namespace iclgpu
 {
 
-class ocl_primitive_db : public primitive_db
+namespace
 {
-public:
-    ocl_primitive_db(ocl_toolkit* toolkit)
-        : _toolkit(toolkit)
-    {
-        _db.insert({
-            #include CORE_OCL_KERNELS_DB
-        });
-    }
+size_t next_requester_id()
+{
+    static std::atomic<size_t> next_id(0);
+    return next_id++;
+}
+}
 
-    struct headers_ret { size_t size; const char* const* names; const ::cl_program* headers; };
-    headers_ret headers() const
-    {
-        return{ _names.size(), _names.data(), _programs.data() };
-    }
+ocl_toolkit::ocl_toolkit(ocl_engine* engine)
+    : _engine(engine)
+    , _shared(ocl_device::acquire(get_device(engine->context()->get_device())))
+    , _requester_id(next_requester_id())
+    , _buffer_pool(std::make_unique<ocl_buffer_pool>(get_cl_context(),
+                                                     get_cl_device().getInfo<CL_DEVICE_MAX_MEM_ALLOC_SIZE>()))
+    , _host_registry(std::make_unique<ocl_host_registry>(*this))
+{
+    assert(_engine);
+    auto& device = get_cl_device();
+    auto& ocl_context = get_cl_context();
 
-    void insert(const value_type& value) override
-    {
-        primitive_db::insert(value);
-        auto& name = value.first;
-        auto& code = value.second;
-        const auto name_len = name.length();
-        if (name_len > 2 && name.compare(name_len - 2, 2, ".h") == 0)
-        {
+    // Profiling adds overhead to every enqueue on some drivers, so it is enabled only on request or for tracing
+    tracer::configure_from_environment();
+    std::string profiling;
+    if (get_environment_variable("ICLGPU_PROFILING", profiling))
+        _profiling = profiling != "0";
+    else
+        _profiling = tracer::enabled();
 
-            insert_header(name, code);
-        }
+    // Queue 0 is the default one, others run independent commands of commands_parallel
+    size_t queues_count = default_queues_count;
+    queues_count = std::min<size_t>(queues_count, device.getInfo<CL_DEVICE_MAX_COMPUTE_UNITS>());
+    std::string queues_str;
+    if (get_environment_variable("ICLGPU_QUEUES", queues_str))
+        queues_count = static_cast<size_t>(parse_size_value(queues_str, queues_count));
+    queues_count = std::max<size_t>(queues_count, 1);
+    while (_queues.size() < queues_count)
+    {
+        _queues.emplace_back(ocl_context, device, 0);
+        _profiling_queues.emplace_back(ocl_context, device, CL_QUEUE_PROFILING_ENABLE);
     }
 
-private:
-    ocl_toolkit* _toolkit;
-    std::vector<const char*> _names;
-    std::vector<std::unique_ptr<std::string>> _names_store;
-    std::vector<::cl_program> _programs;
-    std::vector<std::unique_ptr<cl::Program>> _programs_store;
-
-    void insert_header(const std::string& name, const std::string& code)
-    {
-        assert(_names.size() * 4 == _names.size() + _names_store.size() + _programs.size() + _programs_store.size() );
+    // Threads sharing the engine get own default queues and kernel objects, extra queues are created on first use
+    _thread_slots_count = default_thread_queues_count;
+    _thread_slots_count = std::min<size_t>(_thread_slots_count, std::max(std::thread::hardware_concurrency(), 1u));
+    std::string thread_queues;
+    if (get_environment_variable("ICLGPU_THREAD_QUEUES", thread_queues))
+        _thread_slots_count = static_cast<size_t>(parse_size_value(thread_queues, _thread_slots_count));
+    _thread_slots_count = std::max<size_t>(_thread_slots_count, 1);
+    _thread_slots.reset(new thread_slot_state[_thread_slots_count]);
 
-        auto prog = std::make_unique<cl::Program>(_toolkit->get_cl_context(), code, false);
+    std::string kernel_pool;
+    if (get_environment_variable("ICLGPU_KERNEL_POOL", kernel_pool))
+        _kernel_pool_enabled = kernel_pool != "0";
+}
 
-        for (size_t i = 0; i < _names_store.size(); ++i)
-        {
-            if (name == *_names_store[i])
-            {
-                // replace
-                _programs[i] = prog->get();
-                _programs_store[i] = std::move(prog);
-                assert(_programs_store[i]->get() == _programs[i]);
-                return;
-            }
-        }
+ocl_toolkit::~ocl_toolkit()
+{
+    // Traced commands must not outlive the queues
+    tracer::flush();
+}
 
-        auto new_name = std::make_unique<std::string>(name);
-        _names.push_back(new_name->c_str());
-        _names_store.push_back(std::move(new_name));
+void ocl_toolkit::begin_capture()
+{
+    std::lock_guard<std::mutex> lock(_capture_mutex);
+    if (_capturing)
+        throw std::logic_error("Commands capture is already started");
+    _capture.sequence = _engine->get_commands_sequence({});
+    _capture.bindings.clear();
+    _capturing = true;
+}
 
-        _programs.push_back(prog->get());
-        _programs_store.push_back(std::move(prog));
+captured_commands ocl_toolkit::end_capture()
+{
+    std::lock_guard<std::mutex> lock(_capture_mutex);
+    if (!_capturing)
+        throw std::logic_error("Commands capture is not started");
+    _capturing = false;
+    captured_commands result;
+    std::swap(result, _capture);
+    return result;
+}
 
-        assert(_names_store.back()->c_str() == _names.back());
-        assert(_programs_store.back()->get() == _programs.back());
-        assert(_names.size() * 4 == _names.size() + _names_store.size() + _programs.size() + _programs_store.size() );
-    }
-};
+bool ocl_toolkit::capture(const std::shared_ptr<command>& cmd)
+{
+    if (!_capturing)
+        return false;
+    std::lock_guard<std::mutex> lock(_capture_mutex);
+    if (!_capturing)
+        return false;
+    _capture.sequence->push_back(cmd);
+    return true;
+}
 
-ocl_toolkit::ocl_toolkit(ocl_engine* engine)
-    : _engine(engine)
-    , _device(get_gpu_device())
-    , _ocl_context(_device)
-    , _queues{cl::CommandQueue{_ocl_context, _device, CL_QUEUE_PROFILING_ENABLE}}
-    , _primitive_db(std::make_unique<ocl_primitive_db>(this))
+void ocl_toolkit::capture_binding(const std::shared_ptr<buffer_binding>& binding)
 {
-    assert(_engine);
+    if (!_capturing)
+        return;
+    std::lock_guard<std::mutex> lock(_capture_mutex);
+    auto& bindings = _capture.bindings;
+    if (_capturing && std::find(bindings.begin(), bindings.end(), binding) == bindings.end())
+        bindings.push_back(binding);
 }
 
-ocl_toolkit::~ocl_toolkit() = default;
+namespace
+{
+/// @brief Index of the calling thread, threads get consecutive indices on first use
+size_t thread_index()
+{
+    static std::atomic<size_t> next_index(0);
+    thread_local const size_t index = next_index++;
+    return index;
+}
+}
 
-const cl::Context& ocl_toolkit::get_cl_context() const
+ocl_toolkit::thread_slot_state& ocl_toolkit::get_thread_slot()
 {
-    assert(_ocl_context());
-    return _ocl_context;
+    return _thread_slots[thread_index() % _thread_slots_count];
 }
 
 cl::CommandQueue& ocl_toolkit::get_cl_queue(const command_queue& queue)
@@ -112,83 +150,255 @@ cl::CommandQueue& ocl_toolkit::get_cl_queue(const command_queue& queue)
     assert(!_queues.empty() && _queues[0]());
     if (queue.id() >= _queues.size())
         throw std::invalid_argument("Queue id " + std::to_string(queue.id()) + " does not exist");
-    return _queues[queue.id()];
+    const bool profiling = _profiling.load();
+    if (queue.id() != default_queue.id())
+        return profiling ? _profiling_queues[queue.id()] : _queues[queue.id()];
+
+    auto& slot = get_thread_slot();
+    if (&slot == &_thread_slots[0])
+        return profiling ? _profiling_queues[0] : _queues[0];
+    if (!slot.queue_ready.load(std::memory_order_acquire))
+    {
+        std::lock_guard<std::mutex> lock(_thread_queues_mutex);
+        if (!slot.queue_ready.load(std::memory_order_relaxed))
+        {
+            slot.queue = cl::CommandQueue(get_cl_context(), get_cl_device(), 0);
+            slot.profiling_queue = cl::CommandQueue(get_cl_context(), get_cl_device(), CL_QUEUE_PROFILING_ENABLE);
+            slot.queue_ready.store(true, std::memory_order_release);
+        }
+    }
+    return profiling ? slot.profiling_queue : slot.queue;
+}
+
+void ocl_toolkit::set_profiling(bool enabled)
+{
+    std::lock_guard<std::mutex> lock(_thread_queues_mutex);
+    if (_profiling.exchange(enabled) == enabled)
+        return;
+
+    // Commands keep order of the default queue: the switched queues start after everything submitted so far
+    for (auto& queue : enabled ? _queues : _profiling_queues)
+        queue.finish();
+    for (size_t i = 1; i < _thread_slots_count; ++i)
+    {
+        auto& slot = _thread_slots[i];
+        if (slot.queue_ready)
+            (enabled ? slot.queue : slot.profiling_queue).finish();
+    }
+}
+
+void ocl_toolkit::prune_host_reads()
+{
+    _host_reads.erase(std::remove_if(_host_reads.begin(), _host_reads.end(), [](const host_read& read)
+    {
+        // Failed commands have negative status, they do not write the host memory anymore either
+        return read.event.getInfo<CL_EVENT_COMMAND_EXECUTION_STATUS>() <= CL_COMPLETE;
+    }), _host_reads.end());
+}
+
+void ocl_toolkit::add_host_read(const void* ptr, size_t size, const cl::Event& evt)
+{
+    auto begin = reinterpret_cast<uintptr_t>(ptr);
+    std::lock_guard<std::mutex> lock(_host_reads_mutex);
+    prune_host_reads();
+    _host_reads.push_back({begin, begin + size, evt});
+}
+
+std::vector<cl::Event> ocl_toolkit::get_host_reads(const void* ptr, size_t size)
+{
+    auto begin = reinterpret_cast<uintptr_t>(ptr);
+    auto end = begin + size;
+    std::vector<cl::Event> result;
+    std::lock_guard<std::mutex> lock(_host_reads_mutex);
+    prune_host_reads();
+    for (auto& read : _host_reads)
+    {
+        if (read.begin < end && begin < read.end)
+            result.push_back(read.event);
+    }
+    return result;
 }
 
-cl::Device ocl_toolkit::get_gpu_device()
+std::vector<cl::Device> ocl_toolkit::get_devices()
 {
+    // ICLGPU_DEVICE_TYPE=cpu|all allows to run on any OpenCL implementation (e.g. PoCL for testing)
+    std::string device_type;
+    get_environment_variable("ICLGPU_DEVICE_TYPE", device_type);
+
     std::vector<cl::Platform> platforms;
-    cl::Platform::get(&platforms);
-    cl::Device default_device;
+    std::vector<cl::Device> result;
+    try
+    {
+        cl::Platform::get(&platforms);
+    }
+    catch (const cl::Error&)
+    {
+        // No OpenCL platform installed
+        return result;
+    }
     for (auto& p : platforms)
     {
         std::vector<cl::Device> devices;
         p.getDevices(CL_DEVICE_TYPE_ALL, &devices);
         for (auto& d : devices)
         {
-            if (d.getInfo<CL_DEVICE_TYPE>() == CL_DEVICE_TYPE_GPU)
+            const auto type = d.getInfo<CL_DEVICE_TYPE>();
+            if (device_type == "all" || (device_type == "cpu" && type == CL_DEVICE_TYPE_CPU))
+            {
+                result.push_back(d);
+            }
+            //Intel GPU devices by default
+            else if (device_type.empty() && type == CL_DEVICE_TYPE_GPU && d.getInfo<CL_DEVICE_VENDOR_ID>() == 0x8086)
             {
-                auto vendor_id = d.getInfo<CL_DEVICE_VENDOR_ID>();
-                //set Intel GPU device default
-                if (vendor_id == 0x8086)
-                {
-                    return d;
-                }
+                result.push_back(d);
             }
         }
     }
-    throw std::runtime_error("No OpenCL GPU device found.");
+    return result;
 }
 
-cl::Program ocl_toolkit::build_program(const std::string& module_name)
+cl::Device ocl_toolkit::get_device(size_t index)
 {
-    cl::Program program(_ocl_context, cl::Program::Sources{_primitive_db->get("complex.h"), _primitive_db->get(module_name)});
+    auto devices = get_devices();
+    if (devices.empty())
+        throw std::runtime_error("No OpenCL GPU device found.");
+    if (index >= devices.size())
+        throw std::invalid_argument("OpenCL device " + std::to_string(index) + " does not exist, "
+                                    + std::to_string(devices.size()) + " devices found.");
+    return devices[index];
+}
+
+float ocl_toolkit::get_device_weight() const
+{
+    auto& device = get_cl_device();
+    return static_cast<float>(device.getInfo<CL_DEVICE_MAX_COMPUTE_UNITS>())
+         * static_cast<float>(std::max<cl_uint>(device.getInfo<CL_DEVICE_MAX_CLOCK_FREQUENCY>(), 1));
+}
+
+bool ocl_toolkit::is_host_memory_shared() const
+{
+    // Query is deprecated in OpenCL 2.0, so cl2.hpp does not always declare it, drivers still report it
+    cl_bool unified = CL_FALSE;
+    if (::clGetDeviceInfo(get_cl_device()(), CL_DEVICE_HOST_UNIFIED_MEMORY, sizeof(unified), &unified, nullptr) != CL_SUCCESS)
+        return false;
+    return unified == CL_TRUE;
+}
 
-    auto headers = _primitive_db->headers();
+std::string ocl_toolkit::build_options(const kernel_defines& defines)
+{
+    std::string options;
+    for (auto& define : defines)
+    {
+        if (!options.empty())
+            options += ' ';
+        options += "-D" + define.first;
+        if (!define.second.empty())
+            options += "=" + define.second;
+    }
+    return options;
+}
+
+namespace
+{
+/// @brief Identifies variant of the module built with the options, reported as module name by get_build_info()
+std::string module_key(const std::string& module_name, const std::string& options)
+{
+    return options.empty() ? module_name : module_name + ' ' + options;
+}
 
-    // This is WA for bad signature, because Khronos committee does not understand how the C/C++ const keyword actually works
-    auto header_names = const_cast<const char**>(headers.names);
+std::string kernel_key(const std::string& module_name, const std::string& kernel_name, const std::string& options)
+{
+    return module_key(module_name, options) + ':' + kernel_name;
+}
+}
 
-    auto error = ::clCompileProgram(
-            program(),              // cl_program program
-            1,                      // cl_uint num_devices
-            &_device(),             // const cl_device_id* devices
-            NULL,                   // const char* compiler_options
-            (cl_uint)headers.size,  // cl_uint num_input_headers
-            headers.headers,        // const cl_program *input_headers
-            header_names,           // const char **header_include_names
-            NULL,                   // void (CL_CALLBACK *pfn_notify)(cl_program program, void *user_data)
-            NULL);                  // void *user_data
+bool ocl_toolkit::add_request(const std::string& module_name, const std::string& options, bool background)
+{
+    std::lock_guard<std::mutex> lock(_requests_mutex);
+    for (auto& request : _requests)
+    {
+        if (request.module_name == module_name && request.options == options)
+            return false;
+    }
+    _requests.push_back({module_name, options, background});
+    return true;
+}
 
-    cl::detail::buildErrHandler(error, "clCompileProgram", program.getBuildInfo<CL_PROGRAM_BUILD_LOG>());
+const cl::Program& ocl_toolkit::get_module(const std::string& module_name, const std::string& options)
+{
+    auto key = module_key(module_name, options);
+    if (auto program = _programs.find(key))
+        return *program;
 
-    auto prog = ::clLinkProgram(
-            _ocl_context(),   // cl_context context
-            1,              // cl_uint num_devices
-            &_device(),     // const cl_device_id *device_list
-            NULL,           // const char *options
-            1,              // cl_uint num_input_programs
-            &program(),     // const cl_program *input_programs
-            NULL,           // void (CL_CALLBACK *pfn_notify)(cl_program program, void *user_data)
-            NULL,           // void *user_data
-            &error);        // cl_int *errcode_ret
+    add_request(module_name, options, false);
+    return _programs.insert(key, _shared->get_module(module_name, options, _requester_id));
+}
 
-    cl::detail::errHandler(error, "clLinkProgram");
+cl::Kernel ocl_toolkit::acquire_kernel(const std::string& module_name, const std::string& kernel_name,
+                                       const std::string& options)
+{
+    if (_kernel_pool_enabled)
+    {
+        // Pools of thread slots are rarely contended, kernels released by other threads migrate between slots
+        auto& slot = get_thread_slot();
+        std::lock_guard<std::mutex> lock(slot.kernels_mutex);
+        auto it = slot.kernels.find(kernel_key(module_name, kernel_name, options));
+        if (it != slot.kernels.end() && !it->second.empty())
+        {
+            auto kernel = std::move(it->second.back());
+            it->second.pop_back();
+            return kernel;
+        }
+    }
+    return cl::Kernel(get_module(module_name, options), kernel_name.c_str());
+}
 
-    return cl::Program(prog, false);
+void ocl_toolkit::release_kernel(const std::string& module_name, const std::string& kernel_name,
+                                 const std::string& options, const cl::Kernel& kernel)
+{
+    if (!_kernel_pool_enabled)
+        return;
+    auto& slot = get_thread_slot();
+    std::lock_guard<std::mutex> lock(slot.kernels_mutex);
+    slot.kernels[kernel_key(module_name, kernel_name, options)].push_back(kernel);
 }
 
-const cl::Program& ocl_toolkit::get_module(const std::string& module_name)
+bool ocl_toolkit::prepare_module(const std::string& module_name, const std::string& options)
 {
-    auto it = _programs.find(module_name);
-    if (it != _programs.end())
-        return it->second;
+    if (_programs.find(module_key(module_name, options)))
+        return true;
+    if (_shared->prepare_module(module_name, options, _requester_id))
+        return true;
+    add_request(module_name, options, true);
+    return false;
+}
 
-    auto program = build_program(module_name);
-    auto inserted = _programs.emplace(module_name, program);
-    assert(inserted.second);
-    return inserted.first->second;
+void ocl_toolkit::warmup(const std::vector<std::string>& modules)
+{
+    for (auto& module_name : modules)
+        add_request(module_name, std::string(), true);
+    _shared->warmup(modules, _requester_id);
 }
 
-primitive_db* ocl_toolkit::get_primitive_db() const { return _primitive_db.get(); }
+std::vector<module_build_info> ocl_toolkit::get_build_info()
+{
+    std::vector<module_request> requests;
+    {
+        std::lock_guard<std::mutex> lock(_requests_mutex);
+        requests = _requests;
+    }
+
+    std::vector<module_build_info> result;
+    for (auto& request : requests)
+    {
+        // Modules being built or failed to build are not reported
+        ocl_device::build_record record;
+        if (!_shared->get_build_record(request.module_name, request.options, record))
+            continue;
+        if (record.requester != _requester_id)
+            record.info = {record.info.module, module_build_info::shared, request.background, std::chrono::nanoseconds(0)};
+        result.push_back(record.info);
+    }
+    return result;
+}
 }
@@ -16,37 +16,176 @@
 #include <vector>
 #include <unordered_map>
 #include <string>
+#include <atomic>
+#include <mutex>
 
 #define CL_HPP_ENABLE_EXCEPTIONS
 #define CL_HPP_MINIMUM_OPENCL_VERSION 120
 #define CL_HPP_TARGET_OPENCL_VERSION 120
 #include <cl2_wrapper.h>
 
+#include "append_only_map.hpp"
+#include "engine.hpp"
+#include "ocl_buffer_pool.hpp"
+#include "ocl_device.hpp"
+#include "ocl_host_registry.hpp"
+
 namespace iclgpu
 {
 class ocl_engine;
 class primitive_db;
-class ocl_primitive_db;
 
+/// @brief OpenCL objects of the context
+/// @details Device, OpenCL context and programs are shared with other contexts using the device, see ocl_device.
 class ocl_toolkit
 {
 public:
+    /// @brief Number of command queues if @b ICLGPU_QUEUES environment variable is not set
+    static const size_t default_queues_count = 4;
+    /// @brief Maximum number of default queues if @b ICLGPU_THREAD_QUEUES environment variable is not set
+    static const size_t default_thread_queues_count = 8;
+
     ocl_toolkit(ocl_engine* engine);
-    ~ocl_toolkit(); // -required because ocl_primitive_db is incomplete type
-    const cl::Context& get_cl_context() const;
+    ~ocl_toolkit();
+    const cl::Context& get_cl_context() const { return _shared->get_cl_context(); }
+    const cl::Device& get_cl_device() const { return _shared->get_cl_device(); }
+    /// @brief Returns alignment of sub-buffer origin in bytes
+    size_t get_base_address_align() const { return _shared->get_base_address_align(); }
+    /// @brief Returns OpenCL queue of the @p queue
+    /// @details The default queue is selected by the calling thread, so threads sharing the engine do not
+    /// serialize their commands. Commands of one thread are submitted in order.
     cl::CommandQueue& get_cl_queue(const command_queue& queue = default_queue);
-    static cl::Device get_gpu_device();
-    cl::Program build_program(const std::string& module_name);
-    const cl::Program& get_module(const std::string& module_name);
-    primitive_db* get_primitive_db() const;
+    /// @brief Returns number of in-order queues. Commands submitted to different queues may run concurrently.
+    size_t get_queues_count() const { return _queues.size(); }
+    /// @brief Returns true if threads use different default queues, commands of different threads are not ordered
+    bool has_thread_queues() const { return _thread_slots_count > 1; }
+    /// @brief Switches to queues with or without profiling after completion of submitted commands
+    void set_profiling(bool enabled);
+    bool is_profiling_enabled() const { return _profiling.load(); }
+    /// @brief Returns OpenCL devices usable by the library in platform order
+    /// @details Intel GPUs by default, @b ICLGPU_DEVICE_TYPE=cpu|all allows other devices (e.g. PoCL for testing).
+    static std::vector<cl::Device> get_devices();
+    /// @brief Returns device @p index of get_devices()
+    static cl::Device get_device(size_t index);
+    /// @brief Returns relative throughput of the device: compute units multiplied by clock frequency
+    float get_device_weight() const;
+    /// @brief Returns true if the device reports memory unified with the host
+    bool is_host_memory_shared() const;
+    /// @brief Returns compiler options with the preprocessor definitions, e.g. "-DTILE_M=16 -DTILE_N=8"
+    static std::string build_options(const kernel_defines& defines);
+
+    /// @brief Returns module program built with @p options. Thread-safe, each variant of module is built once
+    /// per device in the process.
+    const cl::Program& get_module(const std::string& module_name, const std::string& options = std::string());
+    primitive_db* get_primitive_db() const { return _shared->get_primitive_db(); }
+
+    /// @brief Returns kernel object not used by anybody else. Creates new one if the pool is empty.
+    cl::Kernel acquire_kernel(const std::string& module_name, const std::string& kernel_name,
+                              const std::string& options = std::string());
+    /// @brief Returns kernel object to the pool.
+    void release_kernel(const std::string& module_name, const std::string& kernel_name, const std::string& options,
+                        const cl::Kernel& kernel);
+
+    ocl_buffer_pool& get_buffer_pool() { return *_buffer_pool; }
+    ocl_host_registry& get_host_registry() { return *_host_registry; }
+
+    /// @brief Remembers non-blocking read of device data into the host range
+    void add_host_read(const void* ptr, size_t size, const cl::Event& evt);
+    /// @brief Returns reads into the host range which are not completed yet
+    /// @details Uploads of the host data wait for them, so they do not copy data older than results of earlier calls.
+    std::vector<cl::Event> get_host_reads(const void* ptr, size_t size);
+
+    /// @brief Starts recording of commands, see engine::begin_capture()
+    void begin_capture();
+    captured_commands end_capture();
+    bool is_capturing() const { return _capturing; }
+    /// @brief Records the command if capture is active
+    /// @returns false if the command should be executed
+    bool capture(const std::shared_ptr<command>& cmd);
+    /// @brief Records data binding used by a command being captured
+    void capture_binding(const std::shared_ptr<buffer_binding>& binding);
+
+    /// @brief Returns true if the module variant is built, otherwise schedules its build on background threads.
+    bool prepare_module(const std::string& module_name, const std::string& options);
+
+    /// @brief Schedules building of modules on background threads.
+    void warmup(const std::vector<std::string>& modules);
+    void wait_warmup() { _shared->wait_warmup(); }
+    /// @brief Returns statistics of modules requested by this context.
+    /// @details Modules built for another context of the device are reported with module_build_info::shared origin.
+    std::vector<module_build_info> get_build_info();
+
+    /// @brief Device-specific data files are kept in the program cache directory, see engine::load_device_data()
+    bool load_device_data(const std::string& name, std::string& data) const
+    {
+        return _shared->load_device_data(name, data);
+    }
+    void store_device_data(const std::string& name, const std::string& data)
+    {
+        _shared->store_device_data(name, data);
+    }
 
 private:
+    /// @brief Module variant requested by this context
+    struct module_request
+    {
+        std::string module_name;
+        std::string options;
+        bool        background;
+    };
+
+    /// @brief Pending read into host memory, see add_host_read()
+    struct host_read
+    {
+        uintptr_t begin;
+        uintptr_t end;
+        cl::Event event;
+    };
+
+    /// @brief State used by threads of the same slot, see thread_slot()
+    struct thread_slot_state
+    {
+        // Default queue of the slot 0 is the queue 0
+        std::atomic<bool>                                        queue_ready{false};
+        cl::CommandQueue                                         queue;
+        cl::CommandQueue                                         profiling_queue;
+        // Kernel objects carry arguments state, so each one is owned by single ocl_kernel at a time
+        std::mutex                                               kernels_mutex;
+        std::unordered_map<std::string, std::vector<cl::Kernel>> kernels;
+    };
+
     ocl_engine*                                  _engine;
-    cl::Device                                   _device;
-    cl::Context                                  _ocl_context;
+    std::shared_ptr<ocl_device>                  _shared;
+    // Identifies this context in build statistics of the shared device
+    size_t                                       _requester_id;
+    // Queues are never replaced, references returned by get_cl_queue() stay valid while profiling is switched
     std::vector<cl::CommandQueue>                _queues;
-    std::unordered_map<std::string, cl::Program> _programs;
-    std::unique_ptr<ocl_primitive_db>            _primitive_db;
+    std::vector<cl::CommandQueue>                _profiling_queues;
+    std::atomic<bool>                            _profiling{false};
+    std::mutex                                   _requests_mutex;
+    std::vector<module_request>                  _requests;
+    // Programs used by this context keyed by module name and build options, see module_key()
+    append_only_map<std::string, cl::Program>    _programs;
+    size_t                                       _thread_slots_count = 1;
+    std::unique_ptr<thread_slot_state[]>         _thread_slots;
+    std::mutex                                   _thread_queues_mutex;
+    bool                                         _kernel_pool_enabled = true;
+    std::unique_ptr<ocl_buffer_pool>             _buffer_pool;
+    std::unique_ptr<ocl_host_registry>           _host_registry;
+    std::mutex                                   _host_reads_mutex;
+    std::vector<host_read>                       _host_reads;
+    std::atomic<bool>                            _capturing{false};
+    std::mutex                                   _capture_mutex;
+    captured_commands                            _capture;
+
+    /// @brief Forgets completed host reads, called with _host_reads_mutex locked
+    void prune_host_reads();
+
+    /// @brief Returns state of the calling thread slot
+    thread_slot_state& get_thread_slot();
+
+    /// @brief Remembers the module variant for get_build_info(), returns false if it is already requested
+    bool add_request(const std::string& module_name, const std::string& options, bool background);
 };
 
 }
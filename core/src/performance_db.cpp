@@ -0,0 +1,159 @@
+// Copyright (c) 2017-2018 Intel Corporation
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//      http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "performance_db.hpp"
+#include "engine.hpp"
+#include "environment.hpp"
+#include <algorithm>
+#include <limits>
+#include <sstream>
+
+namespace iclgpu
+{
+
+namespace
+{
+const char data_header[] = "iclgpu-perfdb 1";
+}
+
+performance_db::performance_db(const std::shared_ptr<iclgpu::context>& ctx)
+    : element(ctx)
+{
+    std::string tuning;
+    if (get_environment_variable("ICLGPU_TUNING", tuning) && !tuning.empty() && tuning != "0")
+        set_enabled(true);
+}
+
+performance_db::~performance_db()
+{
+    try
+    {
+        save();
+    }
+    catch (...)
+    {
+        // Measurements are lost, calls results are not affected
+    }
+}
+
+void performance_db::set_enabled(bool enabled)
+{
+    if (enabled)
+    {
+        std::shared_ptr<engine> engine;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (!_engine)
+                engine = _engine = context()->get_engine();
+        }
+        std::string data;
+        if (engine && engine->load_device_data(data_name(), data))
+            deserialize(data);
+    }
+    _enabled.store(enabled, std::memory_order_relaxed);
+}
+
+size_t performance_db::select(const std::string& key, const std::vector<const char*>& impls, bool& measure)
+{
+    measure = false;
+    if (impls.size() < 2)
+        return 0;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto& bucket = _entries[key];
+    size_t best = 0;
+    auto best_time = std::numeric_limits<uint64_t>::max();
+    for (size_t i = 0; i < impls.size(); ++i)
+    {
+        auto it = bucket.find(impls[i]);
+        // Implementations are measured in the order of their static score
+        if (it == bucket.end() || it->second.samples < samples_count)
+        {
+            measure = true;
+            return i;
+        }
+        if (it->second.best < best_time)
+        {
+            best = i;
+            best_time = it->second.best;
+        }
+    }
+    return best;
+}
+
+void performance_db::record(const std::string& key, const std::string& impl, std::chrono::nanoseconds duration)
+{
+    auto time = static_cast<uint64_t>(std::max<int64_t>(duration.count(), 0));
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto result = _entries[key].insert({ impl, { 0, time } });
+    auto& e = result.first->second;
+    // The best time filters out first call costs (e.g. kernel build) and other noise
+    e.best = std::min(e.best, time);
+    ++e.samples;
+    _modified = true;
+}
+
+std::string performance_db::serialize() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    std::ostringstream stream;
+    stream << data_header << '\n';
+    for (auto& bucket : _entries)
+        for (auto& e : bucket.second)
+            stream << bucket.first << ' ' << e.first << ' ' << e.second.samples << ' ' << e.second.best << '\n';
+    return stream.str();
+}
+
+bool performance_db::deserialize(const std::string& data)
+{
+    std::istringstream stream(data);
+    std::string line;
+    if (!std::getline(stream, line) || line != data_header)
+        return false;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    while (std::getline(stream, line))
+    {
+        std::istringstream fields(line);
+        std::string key, impl;
+        entry e;
+        if (!(fields >> key >> impl >> e.samples >> e.best))
+            continue;
+        auto result = _entries[key].insert({ impl, e });
+        if (!result.second)
+        {
+            auto& existing = result.first->second;
+            existing.samples = std::max(existing.samples, e.samples);
+            existing.best = std::min(existing.best, e.best);
+        }
+    }
+    return true;
+}
+
+void performance_db::save()
+{
+    std::shared_ptr<engine> engine;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_engine || !_modified)
+            return;
+        engine = _engine;
+        _modified = false;
+    }
+    engine->store_device_data(data_name(), serialize());
+}
+
+}
@@ -19,11 +19,73 @@ namespace iclgpu
 
 std::string primitive_db::get(const std::string& id)
 {
+    std::lock_guard<std::mutex> lock(_mutex);
     return _db.at(id);
 }
 
+std::vector<std::string> primitive_db::module_names() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    std::vector<std::string> result;
+    for (auto& entry : _db)
+    {
+        auto& name = entry.first;
+        const auto name_len = name.length();
+        if (name_len > 2 && name.compare(name_len - 2, 2, ".h") == 0)
+            continue;
+        result.push_back(name);
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
 void primitive_db::insert(const value_type& value)
 {
-    _db[value.first] = value.second;
+    store(value);
+}
+
+primitive_db::insert_result primitive_db::store(const value_type& value)
+{
+    auto& name = value.first;
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _db.find(name);
+    if (it != _db.end() && it->second == value.second)
+        return insert_result::unchanged;
+
+    // Precompiled code does not match the sources anymore
+    const auto name_len = name.length();
+    if (name_len > 2 && name.compare(name_len - 2, 2, ".h") == 0)
+    {
+        if (it != _db.end())
+            _binaries.clear();
+    }
+    else
+    {
+        _binaries.erase(name);
+    }
+
+    if (it != _db.end())
+    {
+        it->second = value.second;
+        return insert_result::replaced;
+    }
+    _db.emplace(name, value.second);
+    return insert_result::added;
+}
+
+void primitive_db::insert_binaries(const binary_value_type* values)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (; values->name != nullptr; ++values)
+    {
+        _binaries[values->name] = values;
+    }
+}
+
+const primitive_db::binary_value_type* primitive_db::get_binary(const std::string& id) const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _binaries.find(id);
+    return it == _binaries.end() ? nullptr : it->second;
 }
 }
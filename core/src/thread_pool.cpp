@@ -0,0 +1,82 @@
+// Copyright (c) 2017-2018 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "thread_pool.hpp"
+#include <algorithm>
+
+namespace iclgpu
+{
+
+thread_pool::thread_pool(size_t threads)
+{
+    threads = std::max<size_t>(threads, 1);
+    for (size_t i = 0; i < threads; ++i)
+    {
+        _threads.emplace_back(&thread_pool::worker, this);
+    }
+}
+
+thread_pool::~thread_pool()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+        _tasks.clear();
+    }
+    _task_cv.notify_all();
+    for (auto& t : _threads)
+    {
+        t.join();
+    }
+}
+
+void thread_pool::enqueue(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _tasks.push_back(std::move(task));
+    }
+    _task_cv.notify_one();
+}
+
+void thread_pool::wait_idle()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    _idle_cv.wait(lock, [this] { return _tasks.empty() && _running == 0; });
+}
+
+void thread_pool::worker()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (true)
+    {
+        _task_cv.wait(lock, [this] { return _stop || !_tasks.empty(); });
+        if (_stop)
+            return;
+
+        auto task = std::move(_tasks.front());
+        _tasks.pop_front();
+        ++_running;
+        lock.unlock();
+
+        task();
+
+        lock.lock();
+        --_running;
+        if (_tasks.empty() && _running == 0)
+            _idle_cv.notify_all();
+    }
+}
+
+}
@@ -0,0 +1,57 @@
+// Copyright (c) 2017-2018 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace iclgpu
+{
+
+/// @brief Fixed-size pool of worker threads executing tasks in FIFO order.
+class thread_pool
+{
+public:
+    explicit thread_pool(size_t threads);
+
+    /// @brief Drops pending tasks and waits for the running ones.
+    ~thread_pool();
+
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    void enqueue(std::function<void()> task);
+
+    /// @brief Waits until there are no pending or running tasks.
+    void wait_idle();
+
+    size_t size() const { return _threads.size(); }
+
+private:
+    std::vector<std::thread>          _threads;
+    std::deque<std::function<void()>> _tasks;
+    std::mutex                        _mutex;
+    std::condition_variable           _task_cv;
+    std::condition_variable           _idle_cv;
+    size_t                            _running = 0;
+    bool                              _stop = false;
+
+    void worker();
+};
+
+}
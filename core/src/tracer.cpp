@@ -0,0 +1,319 @@
+// Copyright (c) 2017-2018 Intel Corporation
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//      http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "tracer.hpp"
+#include "environment.hpp"
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <vector>
+
+namespace iclgpu
+{
+
+std::atomic<bool> tracer::_enabled{false};
+
+namespace
+{
+using clock_type = std::chrono::steady_clock;
+
+struct span_record
+{
+    const char* category;
+    const char* name;
+    const char* detail;
+    int         thread;
+    int64_t     start;
+    int64_t     duration;
+};
+
+struct command_record
+{
+    std::string                name;
+    const char*                function;
+    const char*                detail;
+    nd_range                   work_size;
+    nd_range                   parallel_size;
+    size_t                     queue;
+    int                        thread;
+    // Host time of the submission, device times are shifted so the queued timestamp matches it
+    int64_t                    submitted;
+    tracer::timestamps_query   query;
+    command_timestamps         timestamps;
+    bool                       valid;
+};
+
+struct trace_state
+{
+    std::mutex                 mutex;
+    clock_type::time_point     origin = clock_type::now();
+    std::vector<span_record>   spans;
+    std::deque<command_record> commands;
+    // Commands before this index have their timestamps read
+    size_t                     first_pending = 0;
+    std::string                exit_file;
+};
+
+// Never destroyed: the trace is written by atexit handler which may run after static destructors
+trace_state& state()
+{
+    static auto instance = new trace_state;
+    return *instance;
+}
+
+std::atomic<int> threads_count{0};
+thread_local int thread_index = -1;
+thread_local tracer::span* current_span = nullptr;
+
+int get_thread_index()
+{
+    if (thread_index < 0)
+        thread_index = threads_count++;
+    return thread_index;
+}
+
+int64_t since_origin(const trace_state& s, clock_type::time_point time)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time - s.origin).count();
+}
+
+bool resolve(command_record& cmd, bool wait)
+{
+    try
+    {
+        if (!cmd.query(wait, cmd.timestamps))
+            return false;
+        cmd.valid = true;
+    }
+    catch (...)
+    {
+        // Failed command or released device, the record is skipped
+        cmd.valid = false;
+    }
+    cmd.query = nullptr;
+    return true;
+}
+
+void resolve_pending(trace_state& s, bool wait)
+{
+    while (s.first_pending < s.commands.size() && resolve(s.commands[s.first_pending], wait))
+        ++s.first_pending;
+    if (wait)
+    {
+        // Commands of other queues may complete out of order
+        for (size_t i = s.first_pending; i < s.commands.size(); ++i)
+            if (s.commands[i].query)
+                resolve(s.commands[i], true);
+        s.first_pending = s.commands.size();
+    }
+}
+
+std::ostream& write_string(std::ostream& stream, const char* str)
+{
+    stream << '"';
+    for (; str != nullptr && *str != '\0'; ++str)
+    {
+        if (*str == '"' || *str == '\\')
+            stream << '\\';
+        stream << *str;
+    }
+    return stream << '"';
+}
+
+std::ostream& write_range(std::ostream& stream, const nd_range& range)
+{
+    stream << '"';
+    for (size_t i = 0; i < range.dimensions(); ++i)
+        stream << (i == 0 ? "" : ", ") << range[i];
+    return stream << '"';
+}
+
+// Chrome trace times are in microseconds
+std::ostream& write_time(std::ostream& stream, int64_t ns)
+{
+    return stream << static_cast<double>(ns) / 1000.;
+}
+
+void write_at_exit()
+{
+    auto& s = state();
+    std::string file_name;
+    {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        file_name = s.exit_file;
+    }
+    tracer::write(file_name);
+}
+}
+
+tracer::span::span(const char* category, const char* name)
+{
+    if (!enabled())
+        return;
+    _category = category;
+    _name = name;
+    _parent = current_span;
+    _active = true;
+    _start = clock_type::now();
+    current_span = this;
+}
+
+tracer::span::~span()
+{
+    if (!_active)
+        return;
+    auto end = clock_type::now();
+    current_span = _parent;
+    auto& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    auto start = since_origin(s, _start);
+    s.spans.push_back({_category, _name, _detail, get_thread_index(), start, since_origin(s, end) - start});
+}
+
+void tracer::enable(bool value)
+{
+    _enabled = value;
+}
+
+void tracer::configure_from_environment()
+{
+    static std::once_flag once;
+    std::call_once(once, []()
+    {
+        std::string file_name;
+        if (!get_environment_variable("ICLGPU_TRACE", file_name) || file_name.empty())
+            return;
+        auto& s = state();
+        {
+            std::lock_guard<std::mutex> lock(s.mutex);
+            s.exit_file = file_name;
+        }
+        std::atexit(write_at_exit);
+        enable(true);
+    });
+}
+
+void tracer::add_command(command_info&& info)
+{
+    auto now = clock_type::now();
+    auto span = current_span;
+    auto& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    // Timestamps are read when commands complete, so events are not kept for long
+    resolve_pending(s, false);
+    command_record cmd;
+    cmd.name = std::move(info.name);
+    cmd.function = span ? span->_name : nullptr;
+    cmd.detail = span ? span->_detail : nullptr;
+    cmd.work_size = info.work_size;
+    cmd.parallel_size = info.parallel_size;
+    cmd.queue = info.queue;
+    cmd.thread = get_thread_index();
+    cmd.submitted = since_origin(s, now);
+    cmd.query = std::move(info.query);
+    cmd.timestamps = {};
+    cmd.valid = false;
+    s.commands.push_back(std::move(cmd));
+}
+
+void tracer::flush()
+{
+    auto& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    resolve_pending(s, true);
+}
+
+void tracer::write(std::ostream& stream)
+{
+    auto& s = state();
+    std::vector<span_record> spans;
+    std::deque<command_record> commands;
+    {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        resolve_pending(s, true);
+        std::swap(spans, s.spans);
+        std::swap(commands, s.commands);
+        s.first_pending = 0;
+    }
+
+    const int host_pid = 0;
+    const int device_pid = 1;
+    auto flags = stream.flags();
+    stream << std::fixed << std::setprecision(3);
+    stream << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+    stream << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << host_pid << ",\"args\":{\"name\":\"host\"}},\n";
+    stream << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << device_pid << ",\"args\":{\"name\":\"device\"}}";
+
+    for (auto& span : spans)
+    {
+        stream << ",\n{\"name\":";
+        write_string(stream, span.name) << ",\"cat\":";
+        write_string(stream, span.category) << ",\"ph\":\"X\",\"pid\":" << host_pid << ",\"tid\":" << span.thread << ",\"ts\":";
+        write_time(stream, span.start) << ",\"dur\":";
+        write_time(stream, span.duration) << ",\"args\":{\"implementation\":";
+        write_string(stream, span.detail) << "}}";
+    }
+
+    std::vector<bool> queues;
+    for (auto& cmd : commands)
+    {
+        if (!cmd.valid)
+            continue;
+        if (queues.size() <= cmd.queue)
+            queues.resize(cmd.queue + 1, false);
+        queues[cmd.queue] = true;
+
+        auto& ts = cmd.timestamps;
+        auto host_time = [&](uint64_t device_time)
+        {
+            return cmd.submitted + static_cast<int64_t>(device_time - ts.queued);
+        };
+        stream << ",\n{\"name\":";
+        write_string(stream, cmd.name.c_str()) << ",\"cat\":\"kernel\",\"ph\":\"X\",\"pid\":" << device_pid
+            << ",\"tid\":" << cmd.queue << ",\"ts\":";
+        write_time(stream, host_time(ts.start)) << ",\"dur\":";
+        write_time(stream, static_cast<int64_t>(ts.end - ts.start)) << ",\"args\":{\"function\":";
+        write_string(stream, cmd.function) << ",\"implementation\":";
+        write_string(stream, cmd.detail) << ",\"global_size\":";
+        write_range(stream, cmd.work_size) << ",\"local_size\":";
+        write_range(stream, cmd.parallel_size) << ",\"host_thread\":" << cmd.thread << ",\"queued\":";
+        write_time(stream, host_time(ts.queued)) << ",\"submit\":";
+        write_time(stream, host_time(ts.submit)) << ",\"start\":";
+        write_time(stream, host_time(ts.start)) << ",\"end\":";
+        write_time(stream, host_time(ts.end)) << "}}";
+    }
+
+    for (size_t i = 0; i < queues.size(); ++i)
+    {
+        if (queues[i])
+            stream << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << device_pid << ",\"tid\":" << i
+                << ",\"args\":{\"name\":\"queue " << i << "\"}}";
+    }
+    stream << "\n]}\n";
+    stream.flags(flags);
+}
+
+bool tracer::write(const std::string& file_name)
+{
+    std::ofstream file(file_name);
+    if (!file)
+        return false;
+    write(file);
+    return static_cast<bool>(file);
+}
+
+}
@@ -0,0 +1,193 @@
+// Copyright (c) 2017-2018 Intel Corporation
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//      http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "work_stealing_pool.hpp"
+#include <algorithm>
+
+namespace iclgpu
+{
+
+/// @brief State of a running parallel_for() shared by its chunks
+struct work_stealing_pool::loop
+{
+    const std::function<void(size_t, size_t)>* body;
+    // Guarded by mutex: the loop is destroyed by parallel_for() as soon as it sees zero
+    size_t                                     remaining;
+    std::exception_ptr                         error;
+    std::mutex                                 mutex;
+    std::condition_variable                    done_cv;
+};
+
+work_stealing_pool::work_stealing_pool(size_t threads)
+{
+    threads = std::max<size_t>(threads, 1);
+    for (size_t i = 1; i < threads; ++i)
+    {
+        _queues.emplace_back(new worker_queue);
+    }
+    for (size_t i = 0; i < _queues.size(); ++i)
+    {
+        _threads.emplace_back(&work_stealing_pool::worker, this, i);
+    }
+}
+
+work_stealing_pool::~work_stealing_pool()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+    }
+    _cv.notify_all();
+    for (auto& t : _threads)
+    {
+        t.join();
+    }
+}
+
+void work_stealing_pool::parallel_for(size_t begin, size_t end, size_t grain,
+                                      const std::function<void(size_t, size_t)>& body)
+{
+    if (end <= begin)
+        return;
+
+    const auto count = end - begin;
+    // Several chunks per thread let fast threads take over the work of the slow ones
+    if (grain == 0)
+        grain = std::max<size_t>(count / (concurrency() * 4), 1);
+    const auto chunks = (count + grain - 1) / grain;
+    if (chunks == 1)
+    {
+        body(begin, end);
+        return;
+    }
+    if (_queues.empty())
+    {
+        // Chunks are run one by one to keep the semantics of multithreaded loops
+        std::exception_ptr error;
+        for (auto chunk_begin = begin; chunk_begin < end; chunk_begin += grain)
+        {
+            try
+            {
+                body(chunk_begin, std::min(chunk_begin + grain, end));
+            }
+            catch (...)
+            {
+                if (!error)
+                    error = std::current_exception();
+            }
+        }
+        if (error)
+            std::rethrow_exception(error);
+        return;
+    }
+
+    loop l;
+    l.body = &body;
+    l.remaining = chunks;
+
+    // Chunks are spread over the queues starting from different queue for every loop
+    const auto first = _next_queue++ % _queues.size();
+    _pending += chunks;
+    for (size_t i = 0; i < chunks; ++i)
+    {
+        auto& queue = *_queues[(first + i) % _queues.size()];
+        auto chunk_begin = begin + i * grain;
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.chunks.push_back({&l, chunk_begin, std::min(chunk_begin + grain, end)});
+    }
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+    }
+    _cv.notify_all();
+
+    chunk c;
+    while (steal(first, c))
+    {
+        run(c);
+    }
+
+    std::unique_lock<std::mutex> lock(l.mutex);
+    l.done_cv.wait(lock, [&l] { return l.remaining == 0; });
+    if (l.error)
+        std::rethrow_exception(l.error);
+}
+
+bool work_stealing_pool::pop(size_t index, chunk& result)
+{
+    auto& queue = *_queues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.chunks.empty())
+        return false;
+    result = queue.chunks.back();
+    queue.chunks.pop_back();
+    --_pending;
+    return true;
+}
+
+bool work_stealing_pool::steal(size_t first, chunk& result)
+{
+    for (size_t i = 0; i < _queues.size(); ++i)
+    {
+        auto& queue = *_queues[(first + i) % _queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.chunks.empty())
+            continue;
+        result = queue.chunks.front();
+        queue.chunks.pop_front();
+        --_pending;
+        return true;
+    }
+    return false;
+}
+
+void work_stealing_pool::run(const chunk& c)
+{
+    auto& l = *c.owner;
+    std::exception_ptr error;
+    try
+    {
+        (*l.body)(c.begin, c.end);
+    }
+    catch (...)
+    {
+        error = std::current_exception();
+    }
+
+    std::lock_guard<std::mutex> lock(l.mutex);
+    if (error && !l.error)
+        l.error = error;
+    if (--l.remaining == 0)
+        l.done_cv.notify_all();
+}
+
+void work_stealing_pool::worker(size_t index)
+{
+    while (true)
+    {
+        chunk c;
+        if (pop(index, c) || steal(index + 1, c))
+        {
+            run(c);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        _cv.wait(lock, [this] { return _stop || _pending > 0; });
+        if (_stop)
+            return;
+    }
+}
+
+}
@@ -0,0 +1,85 @@
+// Copyright (c) 2017-2018 Intel Corporation
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//      http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace iclgpu
+{
+
+/// @brief Pool of worker threads executing parallel loops.
+/// @details Every worker owns a queue of loop chunks: it takes chunks from the back of its own queue
+/// and steals from the front of other queues when its queue is empty. The thread calling parallel_for()
+/// executes chunks as well, so nested loops do not block workers.
+class work_stealing_pool
+{
+public:
+    /// @param threads Total number of threads executing loops, including the calling thread
+    explicit work_stealing_pool(size_t threads);
+
+    /// @brief Waits for the running chunks and stops the workers
+    ~work_stealing_pool();
+
+    work_stealing_pool(const work_stealing_pool&) = delete;
+    work_stealing_pool& operator=(const work_stealing_pool&) = delete;
+
+    /// @brief Calls @p body for consecutive chunks of [begin, end) range and waits for their completion
+    /// @param grain Minimum chunk size, 0 selects it by the number of threads
+    /// @details The first exception thrown by @p body is rethrown after all chunks are completed.
+    void parallel_for(size_t begin, size_t end, size_t grain, const std::function<void(size_t, size_t)>& body);
+
+    /// @brief Number of threads executing loops, including the calling thread
+    size_t concurrency() const { return _queues.size() + 1; }
+
+private:
+    struct loop;
+
+    struct chunk
+    {
+        loop*  owner;
+        size_t begin;
+        size_t end;
+    };
+
+    struct worker_queue
+    {
+        std::mutex        mutex;
+        std::deque<chunk> chunks;
+    };
+
+    std::vector<std::unique_ptr<worker_queue>> _queues;
+    std::vector<std::thread>                   _threads;
+    std::atomic<size_t>                        _pending{0};
+    std::atomic<size_t>                        _next_queue{0};
+    std::mutex                                 _mutex;
+    std::condition_variable                    _cv;
+    bool                                       _stop = false;
+
+    void worker(size_t index);
+    bool pop(size_t index, chunk& result);
+    bool steal(size_t first, chunk& result);
+    void run(const chunk& c);
+};
+
+}
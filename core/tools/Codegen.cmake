@@ -144,3 +144,67 @@ function(add_codegen_kernels_db Prefix)
     set(KERNELS_DB_INC ${KERNELS_DB_INC} PARENT_SCOPE)
     set(CODEGEN_TARGET_NAME ${CODEGEN_TARGET_NAME} PARENT_SCOPE)
 endfunction()
+
+#.rst:
+# add_codegen_kernels_il
+# ------------------
+#
+# Compile kernels database to SPIR-V and generate include file with precompiled modules.
+# Modules which cannot be compiled offline are skipped (they are built from sources at runtime).
+#
+# add_codegen_kernels_il(Prefix [sources_dir [include_dirs...]])
+#
+# ::
+#
+#   Prefix       - prefix of generated file and table name (${Prefix}_ocl_kernels_il)
+#
+#   sources_dir  - directory where kernels are stored
+#                   Default: ${CMAKE_CURRENT_SOURCE_DIR}
+#   include_dirs - additional directories with headers (.h.cl files)
+
+function(add_codegen_kernels_il Prefix)
+    define_codegen_variables()
+
+    find_program(ICLGPU__AOT_CLANG NAMES clang clang-16 clang-15 clang-14 clang-13 clang-12 DOC "Clang used to compile kernels to LLVM IR.")
+    find_program(ICLGPU__AOT_LLVM_SPIRV NAMES llvm-spirv DOC "Translator from LLVM IR to SPIR-V.")
+    if(NOT ICLGPU__AOT_CLANG OR NOT ICLGPU__AOT_LLVM_SPIRV)
+        message(FATAL_ERROR "[ICLGPU] ICLGPU__AOT_KERNELS requires clang and llvm-spirv (set ICLGPU__AOT_CLANG and ICLGPU__AOT_LLVM_SPIRV).")
+    endif()
+
+    set(KERNELS_IL_INC "${Prefix}_ocl_kernels_il.inc")
+    set(KERNELS_SOURCES_DIR ${CMAKE_CURRENT_SOURCE_DIR})
+    set(KERNELS_DEPENDS)
+
+    if(ARGC GREATER 1)
+        set(KERNELS_SOURCES_DIR ${ARGV1})
+    endif()
+
+    set(INCLUDE_ARGS)
+    foreach(INCLUDE_DIR IN LISTS ARGN)
+        if(NOT INCLUDE_DIR STREQUAL KERNELS_SOURCES_DIR)
+            list(APPEND INCLUDE_ARGS "--include-dir" "${INCLUDE_DIR}")
+            file(GLOB_RECURSE INCLUDE_KERNELS ${INCLUDE_DIR}/*.cl)
+            list(APPEND KERNELS_DEPENDS ${INCLUDE_KERNELS})
+        endif()
+    endforeach()
+
+    file(GLOB_RECURSE SOURCE_KERNELS ${KERNELS_SOURCES_DIR}/*.cl)
+    list(APPEND KERNELS_DEPENDS ${SOURCE_KERNELS})
+
+    set(CODEGEN_TARGET_NAME "${Prefix}_ocl_kernels_il")
+
+    add_custom_command(OUTPUT "${CODEGEN_INCDIR}/${KERNELS_IL_INC}"
+        COMMAND "${CMAKE_COMMAND}" -E make_directory ${CODEGEN_CACHEDIR}
+        COMMAND "${PYTHON_EXECUTABLE}" "${CODEGEN_TOOLSDIR}/primitive_il_gen.py"
+                "${CODEGEN_CACHEDIR}/${KERNELS_IL_INC}" "${Prefix}" "${KERNELS_SOURCES_DIR}" ${INCLUDE_ARGS}
+                --clang "${ICLGPU__AOT_CLANG}" --llvm-spirv "${ICLGPU__AOT_LLVM_SPIRV}"
+        COMMAND "${CMAKE_COMMAND}" -E copy_if_different "${CODEGEN_CACHEDIR}/${KERNELS_IL_INC}" "${CODEGEN_INCDIR}/${KERNELS_IL_INC}"
+        DEPENDS ${KERNELS_DEPENDS} "${CODEGEN_TOOLSDIR}/primitive_il_gen.py"
+        COMMENT "Compiling ${Prefix} kernels to SPIR-V ..."
+    )
+    add_custom_target(${CODEGEN_TARGET_NAME} DEPENDS "${CODEGEN_INCDIR}/${KERNELS_IL_INC}")
+
+    set(CODEGEN_INCDIR ${CODEGEN_INCDIR} PARENT_SCOPE)
+    set(KERNELS_IL_INC ${KERNELS_IL_INC} PARENT_SCOPE)
+    set(CODEGEN_TARGET_NAME ${CODEGEN_TARGET_NAME} PARENT_SCOPE)
+endfunction()
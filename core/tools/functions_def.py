@@ -46,7 +46,10 @@ class FunctionsDef:
             struct=('struct',),
             params=('params',),
             implementations=('implementations',),
+            host_implementations=('host_implementations',),
             impl_type=('impl_type',),
+            selection=('selection',),
+            selection_type=('cached', 'uncached'),
             type=(
                 'char', 'uchar',
                 'short', 'ushort',
@@ -188,14 +191,24 @@ class FunctionsDef:
         self.__expect(self.__tokenize(), 'colon')
         return self.__tokenize()
 
+    def __parse_selection(self):
+        self.__expect(self.__tokenize(), 'colon')
+        token = self.__tokenize()
+        self.__expect(token, 'selection_type')
+        return token
+
     def __parse_function_elem(self):
         return self.__select(self.__tokenize(), {
             'params': lambda token:
                 ('params', self.__parse_list(self.__parse_param, lambda element: element['name'])),
             'implementations': lambda token:
                 ('implementations', self.__parse_list(self.__parse_implementation, lambda element: element)),
+            'host_implementations': lambda token:
+                ('host_implementations', self.__parse_list(self.__parse_implementation, lambda element: element)),
             'impl_type': lambda token:
-                ('impl_type', self.__parse_impl_type())
+                ('impl_type', self.__parse_impl_type()),
+            'selection': lambda token:
+                ('selection', self.__parse_selection())
         })
 
     def __parse_struct_elem(self):
@@ -231,6 +244,9 @@ class FunctionsDef:
                 self.__syntax_error('missing parameters definition for function: ' + name)
             if len(params) < 1:
                 self.__syntax_error('at least 1 parameter should be defined for function ' + name)
+            impls = result.get('implementations', []) + result.get('host_implementations', [])
+            if len(set(impls)) != len(impls):
+                self.__syntax_error('implementation is defined twice for function ' + name)
             return result
         elif type_ == 'struct':
             if len(elements) < 1:
@@ -75,6 +75,20 @@ struct $func_name
         {}
     };
 
+    /// @brief Returns performance DB key of the parameters shape
+    static std::string shape(const params& p)
+    {
+        return shape_builder(name())$shape_adds.str();
+    }
+
+    /// @brief Selection of implementations is memoized by selection_key unless accept() reads blobs data
+    static constexpr bool selection_cached = $selection_cached;
+    using selection_key = std::array<uint64_t, $selection_key_size>;
+    static selection_key make_selection_key(const params& p)
+    {
+        return {{ $selection_values }};
+    }
+
     using impl = function_impl_${impl_type}<$func_name>;
     using selector = selector_${selector_type}<$func_name>;
 };
@@ -122,6 +136,8 @@ struct ${func_name}_${impl_name} : ${func_name}::impl
 
 impl_maker_tpl = Template('ctx->get<implementations::${func_name}_${impl_name}>(),')
 
+host_impl_engine_type = '    engine_type get_engine_type() const override { return engine_type::host; }\n'
+
 
 def hpp_function(func):
     assert func['type'] == 'function'
@@ -130,10 +146,16 @@ def hpp_function(func):
     params_defs = []
     scores_defs = []
     scores_init = []
+    shape_adds = []
+    selection_values = []
     params_num = len(func['params'])
     assert params_num > 0
     for i, p in enumerate(func['params']):
         params_defs.append('{} {};'.format(p['c_type'], p['name']))
+        if not p['blob'] and not p['struct']:
+            shape_adds.append('.add(p.{})'.format(p['name']))
+        if not p['struct']:
+            selection_values.append('selection_value(p.{})'.format(p['name']))
         scores_defs.append('float& {};'.format(p['name']))
         scores_init.append('{}(_data[{}])'.format(p['name'], i))
 
@@ -142,9 +164,14 @@ def hpp_function(func):
     impl_type = func.get('impl_type', 'execute')
     impl_tpl = impl_tpls[impl_type]
     selector_type = 'accept'
-    for impl_name in func['implementations']:
+    for impl_name in func.get('implementations', []):
         impls_defs.append(impl_tpl.substitute(func_name=func_name, impl_name=impl_name))
         impls_makers.append(impl_maker_tpl.substitute(func_name=func_name, impl_name=impl_name))
+    for impl_name in func.get('host_implementations', []):
+        # Host implementations are selected only for the host engine
+        impl_def = impl_tpl.substitute(func_name=func_name, impl_name=impl_name)
+        impls_defs.append(impl_def.replace('    bool accept(', host_impl_engine_type + '    bool accept(', 1))
+        impls_makers.append(impl_maker_tpl.substitute(func_name=func_name, impl_name=impl_name))
 
     return function_tpl.substitute(
         func_name=func_name,
@@ -153,6 +180,10 @@ def hpp_function(func):
         params_defs='\n        '.join(params_defs),
         scores_defs='\n        '.join(scores_defs),
         scores_init='\n            , '.join(scores_init),
+        shape_adds=''.join(shape_adds),
+        selection_cached='true' if func.get('selection', 'cached') == 'cached' and len(selection_values) == params_num else 'false',
+        selection_key_size=max(len(selection_values), 1),
+        selection_values=', '.join(selection_values or ['0']),
         impls_defs=''.join(impls_defs),
         impls_makers='\n        '.join(impls_makers),
         impl_type=impl_type,
@@ -235,6 +266,37 @@ ${set_kernel_args}
 ''')
 }
 
+cpp_host_impl_tpl = Template('''#include "functions/${func_name}.hpp"
+#include "host/host_engine.hpp"
+
+static const char* kernel_name = "${func_name}_${impl_name}";
+
+namespace iclgpu { namespace functions { namespace implementations {
+
+bool ${func_name}_${impl_name}::accept(const ${func_name}::params& params, ${func_name}::score& score)
+{
+    // TODO Add implementation code here:
+    return false;
+}
+
+event ${func_name}_${impl_name}::execute(const ${func_name}::params& params, const std::vector<event>& dep_events)
+{
+    // TODO Modify implementation code here:
+    auto engine = context()->get<host_engine>();
+    auto kernel = engine->get_kernel(kernel_name, [](const host_kernel_args& args, size_t begin, size_t end)
+    {
+    });
+    size_t buf_size = 1;
+${set_kernel_args}
+
+    kernel->set_options({ nd_range(1) });
+
+    return kernel->submit(dep_events);
+}
+
+} } } // namespace iclgpu::functions::implementations
+''')
+
 set_kernel_args_tpls = {
     'scalar': Template('''
     kernel->set_arg(${idx}, params.${param_name});'''),
@@ -266,9 +328,11 @@ def create_function_sources(hpp_dir, impl_dir, func):
             f.write(hpp_file_content)
 
     impl_type = func.get('impl_type', 'execute')
-    cpp_impl_tpl = cpp_impl_tpls[impl_type]
-    for impl_name in func['implementations']:
+    host_impls = func.get('host_implementations', [])
+    for impl_name in func.get('implementations', []) + host_impls:
         impl_filename = func_name + '_' + impl_name
+        is_host = impl_name in host_impls
+        cpp_impl_tpl = cpp_host_impl_tpl if is_host else cpp_impl_tpls[impl_type]
 
         params = []
         set_kernel_args = []
@@ -296,13 +360,14 @@ def create_function_sources(hpp_dir, impl_dir, func):
                     set_kernel_args=''.join(set_kernel_args),
                     read_buffers=''.join(read_buffers)
                 ))
-            # Write func_impl.cl file
-            with open(cl_file_path, 'w') as f:
-                f.write(cl_impl_tpl.substitute(
-                    func_name=func_name,
-                    impl_name=impl_name,
-                    params=', '.join(params)
-                ))
+            # Write func_impl.cl file, host implementations have no kernels
+            if not is_host:
+                with open(cl_file_path, 'w') as f:
+                    f.write(cl_impl_tpl.substitute(
+                        func_name=func_name,
+                        impl_name=impl_name,
+                        params=', '.join(params)
+                    ))
 
         # Escape '\' for cmake compatibility
         print(cpp_file_path.replace('\\', '\\\\'))
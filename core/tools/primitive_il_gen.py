@@ -0,0 +1,143 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2017-2018 Intel Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+# Compiles OpenCL modules ahead of time to SPIR-V and embeds the results into an include file.
+# Modules are named the same way as in primitive_db_gen.py, headers ('.h.cl' files) are resolved
+# from the kernels directory and from additional include directories.
+# A module which fails to compile is skipped with a warning: it will be compiled from source at runtime.
+
+import argparse
+import concurrent.futures
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+
+
+def collect_kernels(dir_path, kernels):
+    for file_name in sorted(os.listdir(dir_path)):
+        file_path = os.path.join(dir_path, file_name)
+        if os.path.isdir(file_path):
+            collect_kernels(file_path, kernels)
+        elif file_name.endswith('.cl'):
+            with open(file_path, 'r') as kernel_file:
+                kernels[file_name[:file_name.rfind('.')]] = kernel_file.read()
+
+
+def compile_module(args, work_dir, name, source):
+    src_path = os.path.join(work_dir, name + '.cl')
+    bc_path = os.path.join(work_dir, name + '.bc')
+    spv_path = os.path.join(work_dir, name + '.spv')
+
+    # Same composition as ocl_toolkit::build_program
+    with open(src_path, 'w') as src_file:
+        src_file.write(args.prelude_source)
+        src_file.write('\n')
+        src_file.write(source)
+
+    clang_cmd = [args.clang, '-c', '-x', 'cl', '-cl-std=CL1.2', '-target', 'spir64-unknown-unknown',
+                 '-emit-llvm', '-Xclang', '-finclude-default-header', '-O2',
+                 '-I', os.path.join(work_dir, 'include'), '-o', bc_path, src_path]
+    for ext in args.extensions:
+        clang_cmd[1:1] = ['-Xclang', '-cl-ext=+' + ext]
+    spirv_cmd = [args.llvm_spirv, bc_path, '-o', spv_path]
+    if args.spirv_extensions:
+        spirv_cmd.append('--spirv-ext=' + ','.join('+' + e for e in args.spirv_extensions))
+
+    for cmd in (clang_cmd, spirv_cmd):
+        result = subprocess.run(cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+        if result.returncode != 0:
+            sys.stderr.write('warning: {} is not precompiled, it will be built at runtime:\n{}\n'.format(
+                name, result.stdout))
+            return name, None
+
+    with open(spv_path, 'rb') as spv_file:
+        return name, spv_file.read()
+
+
+def write_inc(out_file_name, prefix, binaries):
+    with open(out_file_name, 'w') as out_file:
+        out_file.write('// This file is autogenerated by primitive_il_gen.py, all changes to this file will be undone\n\n')
+        names = sorted(binaries.keys())
+        for idx, name in enumerate(names):
+            data = binaries[name]
+            out_file.write('// precompiled from {}\n'.format(name))
+            out_file.write('static const unsigned char {}_ocl_il_{}[] = {{\n'.format(prefix, idx))
+            for i in range(0, len(data), 24):
+                out_file.write(','.join('0x{:02x}'.format(b) for b in data[i:i + 24]))
+                out_file.write(',\n')
+            out_file.write('};\n\n')
+
+        out_file.write('static const iclgpu::primitive_db::binary_value_type {}_ocl_kernels_il[] = {{\n'.format(prefix))
+        for idx, name in enumerate(names):
+            out_file.write('    {{"{0}", {1}_ocl_il_{2}, sizeof({1}_ocl_il_{2})}},\n'.format(name, prefix, idx))
+        # terminator, also keeps the array non-empty
+        out_file.write('    {nullptr, nullptr, 0}\n};\n')
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Compile OpenCL kernels database to SPIR-V.')
+    parser.add_argument('out_file')
+    parser.add_argument('prefix')
+    parser.add_argument('kernels_dir')
+    parser.add_argument('--include-dir', action='append', default=[],
+                        help='additional directory with .h.cl headers')
+    parser.add_argument('--prelude', default='complex.h', help='header prepended to every module')
+    parser.add_argument('--clang', required=True)
+    parser.add_argument('--llvm-spirv', required=True)
+    parser.add_argument('--extension', dest='extensions', action='append',
+                        default=['cl_intel_subgroups', 'cl_khr_subgroups'])
+    parser.add_argument('--spirv-extension', dest='spirv_extensions', action='append',
+                        default=['SPV_INTEL_subgroups'])
+    parser.add_argument('-j', '--jobs', type=int, default=os.cpu_count() or 1)
+    args = parser.parse_args()
+
+    headers = {}
+    for include_dir in args.include_dir:
+        collect_kernels(include_dir, headers)
+    modules = {}
+    collect_kernels(args.kernels_dir, modules)
+    headers.update({name: code for name, code in modules.items() if name.endswith('.h')})
+    modules = {name: code for name, code in modules.items() if not name.endswith('.h')}
+    headers = {name: code for name, code in headers.items() if name.endswith('.h')}
+
+    args.prelude_source = headers.get(args.prelude, '')
+
+    work_dir = tempfile.mkdtemp(prefix='iclgpu_il_')
+    try:
+        os.makedirs(os.path.join(work_dir, 'include'))
+        for name, code in headers.items():
+            with open(os.path.join(work_dir, 'include', name), 'w') as header_file:
+                header_file.write(code)
+
+        binaries = {}
+        with concurrent.futures.ThreadPoolExecutor(max_workers=args.jobs) as executor:
+            futures = [executor.submit(compile_module, args, work_dir, name, code) for name, code in modules.items()]
+            for future in concurrent.futures.as_completed(futures):
+                name, data = future.result()
+                if data is not None:
+                    binaries[name] = data
+    finally:
+        shutil.rmtree(work_dir, ignore_errors=True)
+
+    print('Precompiled {} of {} modules'.format(len(binaries), len(modules)))
+    write_inc(args.out_file, args.prefix, binaries)
+
+
+if __name__ == '__main__':
+    main()
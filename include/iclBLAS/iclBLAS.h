@@ -14,6 +14,7 @@
  */
 
 #pragma once
+#include <stddef.h>
 
 /*****************************************************************************/
 // exporting symbols from dynamic library
@@ -122,6 +123,21 @@ typedef enum {
  */
 typedef struct iclblasContext *iclblasHandle_t;
 
+/*!
+ * @brief Opaque structure holding ordered sequence of asynchronous calls
+ */
+typedef struct iclblasStream *iclblasStream_t;
+
+/*!
+ * @brief Opaque structure marking a point of execution in a stream
+ */
+typedef struct iclblasEvent *iclblasEvent_t;
+
+/*!
+ * @brief Opaque structure holding recorded sequence of calls
+ */
+typedef struct iclblasGraph *iclblasGraph_t;
+
 /*!
  * @brief Indicates operation to be performed.
  */
@@ -156,6 +172,54 @@ typedef enum {
     ICLBLAS_SIDE_LEFT = 0, /*!< the matrix is on the left side in equation */
     ICLBLAS_SIDE_RIGHT = 1 /*!< the matrix is on the right side in equation */
 } iclblasSideMode_t;
+
+/*!
+ * @brief Indicates where scalars and results of functions are stored.
+ */
+typedef enum {
+    ICLBLAS_POINTER_MODE_HOST   = 0, /*!< scalars and results are in host memory */
+    ICLBLAS_POINTER_MODE_DEVICE = 1  /*!< scalars and results may be in device memory allocated by ::iclblasAlloc */
+} iclblasPointerMode_t;
+
+/*!
+ * @brief Flags of ::iclblasWarmup.
+ */
+typedef enum {
+    ICLBLAS_WARMUP_ASYNC = 0, /*!< start building in background and return immediately */
+    ICLBLAS_WARMUP_WAIT  = 1  /*!< return when all requested modules are built */
+} iclblasWarmupFlags_t;
+
+/*!
+ * @brief Indicates how the kernels module was obtained.
+ */
+typedef enum {
+    ICLBLAS_MODULE_SOURCE      = 0, /*!< compiled from OpenCL C sources */
+    ICLBLAS_MODULE_PRECOMPILED = 1, /*!< built from SPIR-V precompiled at library build time */
+    ICLBLAS_MODULE_CACHED      = 2, /*!< loaded from the on-disk program binary cache */
+    ICLBLAS_MODULE_SHARED      = 3  /*!< built for another handle using the same device */
+} iclblasModuleOrigin_t;
+
+/*!
+ * @brief Build statistics of a kernels module.
+ */
+typedef struct {
+    const char*           module;     /*!< module name */
+    iclblasModuleOrigin_t origin;     /*!< how the module was obtained */
+    int                   background; /*!< non-zero if the module was built by warm-up */
+    double                build_time; /*!< build time in milliseconds */
+} iclblasModuleBuildInfo_t;
+
+/*!
+ * @brief Statistics of device memory buffers allocator.
+ */
+typedef struct {
+    unsigned long long requests;        /*!< number of buffers requested from the pool */
+    unsigned long long hits;            /*!< number of requests served by cached buffers */
+    unsigned long long allocations;     /*!< number of device memory allocations */
+    size_t             cached_buffers;  /*!< number of buffers cached for reuse */
+    size_t             cached_bytes;    /*!< total size of buffers cached for reuse */
+    size_t             high_water_mark; /*!< maximum total size of cached buffers */
+} iclblasBufferPoolStats_t;
 /*! @} */
 
 /*****************************************************************************/
@@ -167,16 +231,447 @@ typedef enum {
 /*!
  * @brief Create library context
  *
+ * The handle can be used by several threads concurrently. Calls of each thread are executed in order;
+ * calls of different threads are not ordered unless they use the same stream.
+ * Settings of the handle (e.g. stream and pointer mode) are shared by all threads.
+ * Handles using the same device share OpenCL context and built kernels modules, so only the first one builds them.
+ *
  * @param handle pointer to store context handle
  */
 ICLBLAS_API iclblasStatus_t iclblasCreate(iclblasHandle_t* handle);
 
+/*!
+ * @brief Get number of OpenCL devices available to the library
+ *
+ * Intel GPUs are used unless @b ICLGPU_DEVICE_TYPE environment variable selects @b cpu or @b all devices.
+ *
+ * @param[out] count pointer to store the number of devices
+ */
+ICLBLAS_API iclblasStatus_t iclblasGetDeviceCount(int* count);
+
+/*!
+ * @brief Create library context using the device
+ *
+ * ::iclblasCreate uses the device set by @b ICLGPU_DEVICE environment variable, the first device by default.
+ *
+ * @param handle pointer to store context handle
+ * @param device index of the device, less than the number returned by ::iclblasGetDeviceCount
+ */
+ICLBLAS_API iclblasStatus_t iclblasCreateWithDevice(iclblasHandle_t* handle, int device);
+
+/*!
+ * @brief Set devices sharing work of large calls
+ *
+ * Large ::iclblasSgemm calls are split into column panels and ::iclblasSgemmStridedBatched calls into batches
+ * computed on the devices concurrently, proportionally to the devices throughput.
+ * The handle device is always a member of the group; other listed devices get own contexts.
+ * Listing the handle device more than once adds independent contexts on the same device.
+ * The initial list is set by @b ICLGPU_DEVICES environment variable: @b all or comma separated device indices.
+ * Only calls with host memory operands outside of graph capture are split.
+ *
+ * @param handle  handle to the library context
+ * @param devices array of device indices
+ * @param count   number of elements in @b devices, 0 makes the handle device work alone
+ */
+ICLBLAS_API iclblasStatus_t iclblasSetDevices(iclblasHandle_t handle, const int* devices, int count);
+
 /*!
  * @brief Destroy library context
  *
  * @param handle handle to the library context to be destroyed
  */
 ICLBLAS_API iclblasStatus_t iclblasDestroy(iclblasHandle_t handle);
+
+/*!
+ * @brief Build kernels modules of BLAS functions in background
+ *
+ * Compiles modules on a thread pool, so the first call of a function does not pay the compilation time.
+ * A function call which needs a module being built waits for that build.
+ * Warm-up at handle creation can be requested by @b ICLBLAS_WARMUP environment variable:
+ * @b all or comma separated list of function names.
+ *
+ * @param handle    handle to the library context
+ * @param functions NULL-terminated array of function names (e.g. "Sgemm" or "iclblasSgemm");
+ *                  NULL requests all modules
+ * @param flags     ::iclblasWarmupFlags_t value
+ */
+ICLBLAS_API iclblasStatus_t iclblasWarmup(iclblasHandle_t handle, const char* const* functions, int flags);
+
+/*!
+ * @brief Get build statistics of kernels modules built in the context
+ *
+ * If @b info is NULL, the number of available records is stored to @b count.
+ * Otherwise up to @b count records are written and @b count is set to the number of written records.
+ * Module names stay valid until the next call of the function or the handle destruction.
+ * Modules built earlier for another handle using the same device are reported with ICLBLAS_MODULE_SHARED origin.
+ * Setting @b ICLBLAS_BUILD_REPORT environment variable prints the statistics when the handle is destroyed.
+ *
+ * @param[in] handle     handle to the library context
+ * @param[out] info      array of at least @b count records or NULL
+ * @param[in,out] count  number of records
+ */
+ICLBLAS_API iclblasStatus_t iclblasGetModuleBuildInfo(iclblasHandle_t handle, iclblasModuleBuildInfo_t* info, int* count);
+
+/*!
+ * @brief Get statistics of device memory buffers allocator
+ *
+ * Device buffers of operands and temporary results are cached for reuse in power-of-two size classes.
+ * The limit of cached memory is set by @b ICLGPU_BUFFER_POOL_SIZE environment variable.
+ *
+ * @param[in] handle handle to the library context
+ * @param[out] stats pointer to store statistics
+ */
+ICLBLAS_API iclblasStatus_t iclblasGetBufferPoolStats(iclblasHandle_t handle, iclblasBufferPoolStats_t* stats);
+
+/*!
+ * @brief Free device memory buffers cached for reuse
+ *
+ * @param handle handle to the library context
+ */
+ICLBLAS_API iclblasStatus_t iclblasTrimBufferPool(iclblasHandle_t handle);
+
+/*!
+ * @brief Register host memory used by multiple calls
+ *
+ * Device buffer for the memory is created once and reused by all calls which get pointers
+ * inside the registered range (including interior pointers like sub-matrices).
+ * Without registration each call creates new buffers and copies unaligned data.
+ * After the host modifies registered data, the change must be published with ::iclblasHostSync.
+ *
+ * @param handle handle to the library context
+ * @param ptr    start of the host memory range, must not overlap other registered ranges
+ * @param size   size of the range in bytes
+ */
+ICLBLAS_API iclblasStatus_t iclblasHostRegister(iclblasHandle_t handle, void* ptr, size_t size);
+
+/*!
+ * @brief Unregister host memory registered by ::iclblasHostRegister
+ *
+ * @param handle handle to the library context
+ * @param ptr    pointer passed to ::iclblasHostRegister
+ */
+ICLBLAS_API iclblasStatus_t iclblasHostUnregister(iclblasHandle_t handle, void* ptr);
+
+/*!
+ * @brief Publish host modifications of registered memory
+ *
+ * Data written by the library functions is always visible on the host, no call is needed for it.
+ *
+ * @param handle handle to the library context
+ * @param ptr    pointer inside registered memory
+ * @param size   number of modified bytes, 0 means up to the end of the registered range
+ */
+ICLBLAS_API iclblasStatus_t iclblasHostSync(iclblasHandle_t handle, void* ptr, size_t size);
+
+/*!
+ * @brief Allocate device memory
+ *
+ * Returned pointer is an opaque handle which can be passed to all library functions instead of host pointers,
+ * so intermediate results of a chain of calls stay on the device.
+ * Pointer arithmetic is allowed: pointers inside the allocation address its parts.
+ * Offsets must be multiples of device base address alignment (128 bytes on most of devices),
+ * otherwise functions return ::ICLBLAS_STATUS_NOT_SUPPORTED.
+ * The memory must not be accessed by the host directly, use ::iclblasSetVector, ::iclblasGetVector,
+ * ::iclblasSetMatrix and ::iclblasGetMatrix to transfer data.
+ *
+ * @param[in] handle handle to the library context
+ * @param[in] size   size of memory in bytes
+ * @param[out] ptr   pointer to store the device memory handle
+ */
+ICLBLAS_API iclblasStatus_t iclblasAlloc(iclblasHandle_t handle, size_t size, void** ptr);
+
+/*!
+ * @brief Free device memory allocated by ::iclblasAlloc
+ *
+ * @param handle handle to the library context
+ * @param ptr    pointer returned by ::iclblasAlloc
+ *
+ * Returns ::ICLBLAS_STATUS_INVALID_VALUE if @p ptr was allocated with other handle.
+ */
+ICLBLAS_API iclblasStatus_t iclblasFree(iclblasHandle_t handle, void* ptr);
+
+/*!
+ * @brief Copy @b n elements from host vector x to device vector y
+ *
+ * @param handle   handle to the library context
+ * @param n        number of elements
+ * @param elemSize size of element in bytes
+ * @param x        host vector
+ * @param incx     stride between elements of x
+ * @param y        device vector
+ * @param incy     stride between elements of y
+ */
+ICLBLAS_API iclblasStatus_t iclblasSetVector(iclblasHandle_t handle, int n, int elemSize, const void* x, int incx, void* y, int incy);
+
+/*!
+ * @brief Copy @b n elements from device vector x to host vector y
+ *
+ * @param handle   handle to the library context
+ * @param n        number of elements
+ * @param elemSize size of element in bytes
+ * @param x        device vector
+ * @param incx     stride between elements of x
+ * @param y        host vector
+ * @param incy     stride between elements of y
+ */
+ICLBLAS_API iclblasStatus_t iclblasGetVector(iclblasHandle_t handle, int n, int elemSize, const void* x, int incx, void* y, int incy);
+
+/*!
+ * @brief Copy @b rows x @b cols column-major matrix from host memory A to device memory B
+ *
+ * @param handle   handle to the library context
+ * @param rows     number of rows
+ * @param cols     number of columns
+ * @param elemSize size of element in bytes
+ * @param A        host matrix
+ * @param lda      leading dimension of A
+ * @param B        device matrix
+ * @param ldb      leading dimension of B
+ */
+ICLBLAS_API iclblasStatus_t iclblasSetMatrix(iclblasHandle_t handle, int rows, int cols, int elemSize, const void* A, int lda, void* B, int ldb);
+
+/*!
+ * @brief Copy @b rows x @b cols column-major matrix from device memory A to host memory B
+ *
+ * @param handle   handle to the library context
+ * @param rows     number of rows
+ * @param cols     number of columns
+ * @param elemSize size of element in bytes
+ * @param A        device matrix
+ * @param lda      leading dimension of A
+ * @param B        host matrix
+ * @param ldb      leading dimension of B
+ */
+ICLBLAS_API iclblasStatus_t iclblasGetMatrix(iclblasHandle_t handle, int rows, int cols, int elemSize, const void* A, int lda, void* B, int ldb);
+
+/*!
+ * @brief Set where scalars and results of functions called with the handle are stored
+ *
+ * In ::ICLBLAS_POINTER_MODE_DEVICE mode scalar parameters (e.g. @b alpha, @b beta) and results
+ * of reductions (e.g. ::iclblasSdot, ::iclblasSnrm2) may point to memory allocated by ::iclblasAlloc,
+ * so a result of one call can be passed as a scalar to the next call without copying it to the host.
+ * ::iclblasSaxpy and ::iclblasSscal read the scalar on the device. Other functions read device scalars
+ * when they are called, waiting for completion of preceding calls.
+ * Host pointers are still accepted in this mode. ::iclblasSrotm and ::iclblasSrotmg support host pointers only.
+ *
+ * @param handle handle to the library context
+ * @param mode   ::ICLBLAS_POINTER_MODE_HOST (default) or ::ICLBLAS_POINTER_MODE_DEVICE
+ */
+ICLBLAS_API iclblasStatus_t iclblasSetPointerMode(iclblasHandle_t handle, iclblasPointerMode_t mode);
+
+/*!
+ * @brief Get where scalars and results of functions called with the handle are stored
+ *
+ * @param[in] handle handle to the library context
+ * @param[out] mode  pointer to store the mode
+ */
+ICLBLAS_API iclblasStatus_t iclblasGetPointerMode(iclblasHandle_t handle, iclblasPointerMode_t* mode);
+
+/*!
+ * @brief Enable or disable collection of kernels execution times
+ *
+ * Profiling adds overhead to every kernel submission on some drivers, so it is disabled by default.
+ * It is required for kernel times in the execution trace (see ::iclblasSetTracing).
+ * Default value can be set by @b ICLGPU_PROFILING environment variable, profiling is also enabled
+ * if @b ICLGPU_TRACE is set. Waits for completion of preceding calls.
+ *
+ * @param handle  handle to the library context
+ * @param enabled non-zero value enables profiling
+ */
+ICLBLAS_API iclblasStatus_t iclblasSetProfiling(iclblasHandle_t handle, int enabled);
+
+/*!
+ * @brief Get whether kernels execution times are collected
+ *
+ * @param[in] handle   handle to the library context
+ * @param[out] enabled pointer to store non-zero value if profiling is enabled
+ */
+ICLBLAS_API iclblasStatus_t iclblasGetProfiling(iclblasHandle_t handle, int* enabled);
+
+/*!
+ * @brief Enable or disable selection of function implementations by measured performance
+ *
+ * When enabled, first calls with similar parameters (same function, transposes and scalars kind,
+ * dimensions and strides of the same order of magnitude) run each applicable implementation in turn and
+ * wait for its completion, following calls run the fastest one.
+ * Measurements are stored per device beside cached program binaries (see @b ICLGPU_CACHE_DIR)
+ * when the handle is destroyed and loaded when the selection is enabled again.
+ * Default value can be set by @b ICLGPU_TUNING environment variable.
+ *
+ * @param handle  handle to the library context
+ * @param enabled non-zero value enables the selection
+ */
+ICLBLAS_API iclblasStatus_t iclblasSetTuning(iclblasHandle_t handle, int enabled);
+
+/*!
+ * @brief Get whether function implementations are selected by measured performance
+ *
+ * @param[in] handle   handle to the library context
+ * @param[out] enabled pointer to store non-zero value if the selection is enabled
+ */
+ICLBLAS_API iclblasStatus_t iclblasGetTuning(iclblasHandle_t handle, int* enabled);
+
+/*!
+ * @brief Create stream of asynchronous calls
+ *
+ * The stream can be used only with handles created by the same call of ::iclblasCreate.
+ *
+ * @param[in] handle  handle to the library context
+ * @param[out] stream pointer to store the stream
+ */
+ICLBLAS_API iclblasStatus_t iclblasStreamCreate(iclblasHandle_t handle, iclblasStream_t* stream);
+
+/*!
+ * @brief Wait for completion of calls in the stream and destroy it
+ *
+ * @param stream stream to be destroyed
+ */
+ICLBLAS_API iclblasStatus_t iclblasStreamDestroy(iclblasStream_t stream);
+
+/*!
+ * @brief Set stream used by subsequent calls with the handle
+ *
+ * While a stream is set, BLAS functions only enqueue the operation and return immediately.
+ * Operations in the stream are executed in the order of calls, so results of a call
+ * can be used by next calls in the same stream, also through host memory.
+ * Host memory passed to the functions must not be modified or freed, and results must not be read
+ * until ::iclblasStreamSynchronize or ::iclblasEventSynchronize returns.
+ * NULL restores default behavior: functions return when the operation is completed.
+ *
+ * @param handle handle to the library context
+ * @param stream stream created for the handle or NULL
+ */
+ICLBLAS_API iclblasStatus_t iclblasSetStream(iclblasHandle_t handle, iclblasStream_t stream);
+
+/*!
+ * @brief Get stream used by calls with the handle
+ *
+ * @param[in] handle  handle to the library context
+ * @param[out] stream pointer to store the stream, NULL is stored if calls are synchronous
+ */
+ICLBLAS_API iclblasStatus_t iclblasGetStream(iclblasHandle_t handle, iclblasStream_t* stream);
+
+/*!
+ * @brief Wait for completion of all calls enqueued in the stream
+ *
+ * @param stream the stream
+ */
+ICLBLAS_API iclblasStatus_t iclblasStreamSynchronize(iclblasStream_t stream);
+
+/*!
+ * @brief Make calls enqueued in the stream after this call wait for the event
+ *
+ * The host is not blocked if the event was recorded in a stream of the same handle.
+ *
+ * @param stream the stream
+ * @param event  event recorded by ::iclblasEventRecord
+ */
+ICLBLAS_API iclblasStatus_t iclblasStreamWaitEvent(iclblasStream_t stream, iclblasEvent_t event);
+
+/*!
+ * @brief Create event
+ *
+ * The event is completed until it is recorded.
+ *
+ * @param[out] event pointer to store the event
+ */
+ICLBLAS_API iclblasStatus_t iclblasEventCreate(iclblasEvent_t* event);
+
+/*!
+ * @brief Destroy event
+ *
+ * @param event event to be destroyed
+ */
+ICLBLAS_API iclblasStatus_t iclblasEventDestroy(iclblasEvent_t event);
+
+/*!
+ * @brief Capture completion of calls enqueued in the stream so far
+ *
+ * @param event  the event
+ * @param stream the stream
+ */
+ICLBLAS_API iclblasStatus_t iclblasEventRecord(iclblasEvent_t event, iclblasStream_t stream);
+
+/*!
+ * @brief Wait for completion of calls captured by the event
+ *
+ * @param event the event
+ */
+ICLBLAS_API iclblasStatus_t iclblasEventSynchronize(iclblasEvent_t event);
+
+/*!
+ * @brief Start recording of calls with the handle into a graph
+ *
+ * Until ::iclblasGraphEndCapture is called, BLAS functions select the implementation and prepare
+ * kernels and buffers, but nothing is executed and results are not written.
+ * In ::ICLBLAS_POINTER_MODE_DEVICE, functions which read scalars from device memory on the host
+ * return ::ICLBLAS_STATUS_NOT_SUPPORTED, since the value is not known before replay.
+ *
+ * @param handle handle to the library context
+ */
+ICLBLAS_API iclblasStatus_t iclblasGraphBeginCapture(iclblasHandle_t handle);
+
+/*!
+ * @brief Stop recording started by ::iclblasGraphBeginCapture
+ *
+ * @param[in] handle handle to the library context
+ * @param[out] graph pointer to store the graph of recorded calls
+ */
+ICLBLAS_API iclblasStatus_t iclblasGraphEndCapture(iclblasHandle_t handle, iclblasGraph_t* graph);
+
+/*!
+ * @brief Execute recorded calls
+ *
+ * Calls are executed with the same parameters as during recording, without implementation selection
+ * and kernels preparation. Current content of host memory is used.
+ * If a stream is set on the handle, the calls are enqueued to the stream.
+ *
+ * @param handle handle to the library context used for recording
+ * @param graph  the graph
+ */
+ICLBLAS_API iclblasStatus_t iclblasGraphLaunch(iclblasHandle_t handle, iclblasGraph_t graph);
+
+/*!
+ * @brief Replace host pointer used by recorded calls
+ *
+ * New memory must have at least the same size as the memory used by the calls.
+ * Pointers to device memory allocated by ::iclblasAlloc cannot be replaced.
+ *
+ * @param graph   the graph
+ * @param oldPtr  pointer passed to calls during recording
+ * @param newPtr  pointer used by next launches
+ */
+ICLBLAS_API iclblasStatus_t iclblasGraphUpdatePointer(iclblasGraph_t graph, const void* oldPtr, void* newPtr);
+
+/*!
+ * @brief Destroy graph
+ *
+ * @param graph graph to be destroyed
+ */
+ICLBLAS_API iclblasStatus_t iclblasGraphDestroy(iclblasGraph_t graph);
+
+/*!
+ * @brief Enable or disable recording of the execution trace
+ *
+ * While tracing is enabled, every function call records dispatch time on the host with the selected
+ * implementation, and every kernel records its name, global and local work sizes, and device
+ * queued, submit, start and end times. Tracing can be also enabled by @b ICLGPU_TRACE environment variable
+ * naming the file the trace is written to at process exit.
+ * Kernel times are recorded only for handles with profiling enabled, see ::iclblasSetProfiling.
+ *
+ * @param enabled non-zero value enables tracing
+ */
+ICLBLAS_API iclblasStatus_t iclblasSetTracing(int enabled);
+
+/*!
+ * @brief Write recorded trace to a file and clear it
+ *
+ * The file is in Chrome trace JSON format, it can be opened by chrome://tracing or https://ui.perfetto.dev.
+ * Waits for completion of traced kernels.
+ *
+ * @param fileName name of the file
+ */
+ICLBLAS_API iclblasStatus_t iclblasWriteTrace(const char* fileName);
 /*! @} */
 
 /*****************************************************************************/
@@ -629,6 +1124,22 @@ ICLBLAS_API iclblasStatus_t iclblasScasum(iclblasHandle_t handle, int n, oclComp
  */
 ICLBLAS_API iclblasStatus_t iclblasStrsv(iclblasHandle_t handle, iclblasFillMode_t uplo, iclblasOperation_t trans, iclblasDiagType_t diag, int n, float* A, int lda, float* x, int incx);
 
+/*!
+ * @brief Solves a batch of triangular systems of equations with equally spaced matrices and vectors
+ *
+ * @code
+ * op(A[i]) * x[i] = b[i]
+ * @endcode
+ * Where @b A[i] = @b A + i * @b strideA and @b x[i] = @b x + i * @b stridex for i in [0, @b batchCount).
+ * All systems are solved by a single kernel launch, each system by one work-item or one work-group.
+ * See ::iclblasStrsv for the description of the remaining parameters.
+ *
+ * @param[in] strideA     distance in elements between consecutive matrices @b A[i]
+ * @param[in] stridex     distance in elements between consecutive vectors @b x[i]
+ * @param[in] batchCount  number of systems
+ */
+ICLBLAS_API iclblasStatus_t iclblasStrsvStridedBatched(iclblasHandle_t handle, iclblasFillMode_t uplo, iclblasOperation_t trans, iclblasDiagType_t diag, int n, float* A, int lda, long long strideA, float* x, int incx, long long stridex, int batchCount);
+
 /*!
  * @brief Solves triangular banded linear system with single right-hand side
  *
@@ -1047,6 +1558,23 @@ ICLBLAS_API iclblasStatus_t iclblasSsymv(iclblasHandle_t handle, iclblasFillMode
  * @param[in] incy      stride between elements of @b y; should be at least 1
  */
 ICLBLAS_API iclblasStatus_t iclblasSgemv(iclblasHandle_t handle, iclblasOperation_t trans, int m, int n, const float* alpha, float *A, int lda, float *x, int incx, const float* beta, float *y, int incy);
+
+/*!
+ * @brief Computes a batch of matrix-vector products with equally spaced matrices and vectors
+ *
+ * @code
+ * y[i] = alpha * op(A[i]) * x[i] + beta * y[i]
+ * @endcode
+ * Where @b A[i] = @b A + i * @b strideA, @b x[i] = @b x + i * @b stridex and @b y[i] = @b y + i * @b stridey
+ * for i in [0, @b batchCount). All products are computed by a single kernel launch.
+ * See ::iclblasSgemv for the description of the remaining parameters.
+ *
+ * @param[in] strideA     distance in elements between consecutive matrices @b A[i]
+ * @param[in] stridex     distance in elements between consecutive vectors @b x[i]
+ * @param[in] stridey     distance in elements between consecutive vectors @b y[i]
+ * @param[in] batchCount  number of products
+ */
+ICLBLAS_API iclblasStatus_t iclblasSgemvStridedBatched(iclblasHandle_t handle, iclblasOperation_t trans, int m, int n, const float* alpha, float* A, int lda, long long strideA, float* x, int incx, long long stridex, const float* beta, float* y, int incy, long long stridey, int batchCount);
 /*! @} */
 
 /*****************************************************************************/
@@ -1667,6 +2195,10 @@ ICLBLAS_API iclblasStatus_t iclblasSsyr2k(iclblasHandle_t handle, iclblasFillMod
 * op(B) = B^H   if transb == ICLBLAS_OP_C
 * @endcode
 *
+* Large non-transposed products of host data on a device sharing memory with the host are split between
+* the device and the host threads. @b ICLGPU_SGEMM_HYBRID environment variable enables (@b 1) or disables (@b 0)
+* the split regardless of the device.
+*
 * @param[in] handle handle to the library context
 * @param[in] transa indicates operation op(A) for matrix @b A
 * @param[in] transb indicates operation op(B) for matrix @b B
@@ -1684,6 +2216,42 @@ ICLBLAS_API iclblasStatus_t iclblasSsyr2k(iclblasHandle_t handle, iclblasFillMod
 */
 ICLBLAS_API iclblasStatus_t iclblasSgemm(iclblasHandle_t handle, iclblasOperation_t transa, iclblasOperation_t transb, int m, int n, int k, const float* alpha, float* A, int lda, float* B, int ldb, const float* beta, float* C, int ldc);
 
+/*!
+* @brief Computes a batch of matrix-matrix products with equally spaced matrices
+*
+* @code
+* C[i] = alpha * op(A[i]) * op(B[i]) + beta * C[i]
+* @endcode
+* Where @b A[i] = @b A + i * @b strideA, @b B[i] = @b B + i * @b strideB and @b C[i] = @b C + i * @b strideC
+* for i in [0, @b batchCount). All products are computed by a single kernel launch.
+* See ::iclblasSgemm for the description of the remaining parameters.
+*
+* @param[in] strideA     distance in elements between consecutive matrices @b A[i]
+* @param[in] strideB     distance in elements between consecutive matrices @b B[i]
+* @param[in] strideC     distance in elements between consecutive matrices @b C[i]
+* @param[in] batchCount  number of products
+*/
+ICLBLAS_API iclblasStatus_t iclblasSgemmStridedBatched(iclblasHandle_t handle, iclblasOperation_t transa, iclblasOperation_t transb, int m, int n, int k, const float* alpha, float* A, int lda, long long strideA, float* B, int ldb, long long strideB, const float* beta, float* C, int ldc, long long strideC, int batchCount);
+
+/*!
+* @brief Computes a batch of matrix-matrix products with matrices given by arrays of pointers
+*
+* @code
+* C[i] = alpha * op(A[i]) * op(B[i]) + beta * C[i]
+* @endcode
+* For i in [0, @b batchCount). See ::iclblasSgemm for the description of the remaining parameters.
+*
+* Matrices allocated by ::iclblasAlloc which are equally spaced in a single allocation are computed in place
+* by a single kernel launch, like by ::iclblasSgemmStridedBatched. Otherwise matrices are gathered into contiguous
+* memory and the function returns when results are copied back, also when a stream is set.
+*
+* @param[in] Aarray      array of @b batchCount pointers to matrices @b A[i]
+* @param[in] Barray      array of @b batchCount pointers to matrices @b B[i]
+* @param[in,out] Carray  array of @b batchCount pointers to matrices @b C[i]
+* @param[in] batchCount  number of products
+*/
+ICLBLAS_API iclblasStatus_t iclblasSgemmBatched(iclblasHandle_t handle, iclblasOperation_t transa, iclblasOperation_t transb, int m, int n, int k, const float* alpha, float* const Aarray[], int lda, float* const Barray[], int ldb, const float* beta, float* const Carray[], int ldc, int batchCount);
+
 /*!
 * @brief Solves triangular linear system with multiple right-hand-sides
 *
@@ -1798,6 +2366,42 @@ ICLBLAS_API iclblasStatus_t iclblasStrmm(iclblasHandle_t handle, iclblasSideMode
 */
 ICLBLAS_API iclblasStatus_t iclblasCgemm(iclblasHandle_t handle, iclblasOperation_t transa, iclblasOperation_t transb, int m, int n, int k, const oclComplex_t* alpha, oclComplex_t* A, int lda, oclComplex_t* B, int ldb, const oclComplex_t* beta, oclComplex_t* C, int ldc);
 
+/*!
+* @brief Computes a batch of matrix-matrix products with equally spaced matrices
+*
+* @code
+* C[i] = alpha * op(A[i]) * op(B[i]) + beta * C[i]
+* @endcode
+* Where @b A[i] = @b A + i * @b strideA, @b B[i] = @b B + i * @b strideB and @b C[i] = @b C + i * @b strideC
+* for i in [0, @b batchCount). All products are computed by a single kernel launch.
+* See ::iclblasCgemm for the description of the remaining parameters.
+*
+* @param[in] strideA     distance in elements between consecutive matrices @b A[i]
+* @param[in] strideB     distance in elements between consecutive matrices @b B[i]
+* @param[in] strideC     distance in elements between consecutive matrices @b C[i]
+* @param[in] batchCount  number of products
+*/
+ICLBLAS_API iclblasStatus_t iclblasCgemmStridedBatched(iclblasHandle_t handle, iclblasOperation_t transa, iclblasOperation_t transb, int m, int n, int k, const oclComplex_t* alpha, oclComplex_t* A, int lda, long long strideA, oclComplex_t* B, int ldb, long long strideB, const oclComplex_t* beta, oclComplex_t* C, int ldc, long long strideC, int batchCount);
+
+/*!
+* @brief Computes a batch of matrix-matrix products with matrices given by arrays of pointers
+*
+* @code
+* C[i] = alpha * op(A[i]) * op(B[i]) + beta * C[i]
+* @endcode
+* For i in [0, @b batchCount). See ::iclblasCgemm for the description of the remaining parameters.
+*
+* Matrices allocated by ::iclblasAlloc which are equally spaced in a single allocation are computed in place
+* by a single kernel launch, like by ::iclblasCgemmStridedBatched. Otherwise matrices are gathered into contiguous
+* memory and the function returns when results are copied back, also when a stream is set.
+*
+* @param[in] Aarray      array of @b batchCount pointers to matrices @b A[i]
+* @param[in] Barray      array of @b batchCount pointers to matrices @b B[i]
+* @param[in,out] Carray  array of @b batchCount pointers to matrices @b C[i]
+* @param[in] batchCount  number of products
+*/
+ICLBLAS_API iclblasStatus_t iclblasCgemmBatched(iclblasHandle_t handle, iclblasOperation_t transa, iclblasOperation_t transb, int m, int n, int k, const oclComplex_t* alpha, oclComplex_t* const Aarray[], int lda, oclComplex_t* const Barray[], int ldb, const oclComplex_t* beta, oclComplex_t* const Carray[], int ldc, int batchCount);
+
 /*!
 * @brief Performs symmetric matrix by matrix multiplication
 *
@@ -0,0 +1,99 @@
+// Copyright (c) 2017-2018 Intel Corporation
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//      http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <functional>
+#include <mutex>
+
+namespace iclgpu
+{
+/// @addtogroup context Context management
+/// @{
+
+/// @brief Hash map which is only extended, so lookups take no locks
+/// @details Insertions are serialized by a mutex and publish immutable nodes, readers running concurrently see
+/// either complete entries or nothing. Entries live until the map is destroyed, values are never replaced.
+template <class Key, class Value, class Hash = std::hash<Key>, size_t BucketsCount = 256>
+class append_only_map
+{
+public:
+    append_only_map()
+    {
+        for (auto& bucket : _buckets)
+            bucket.store(nullptr, std::memory_order_relaxed);
+    }
+
+    ~append_only_map()
+    {
+        for (auto& bucket : _buckets)
+        {
+            auto node = bucket.load(std::memory_order_relaxed);
+            while (node != nullptr)
+            {
+                auto next = node->next;
+                delete node;
+                node = next;
+            }
+        }
+    }
+
+    append_only_map(const append_only_map&) = delete;
+    append_only_map& operator=(const append_only_map&) = delete;
+
+    /// @returns Pointer to the value of the key or NULL if the key is not found
+    const Value* find(const Key& key) const
+    {
+        for (auto node = _buckets[index(key)].load(std::memory_order_acquire); node != nullptr; node = node->next)
+        {
+            if (node->key == key)
+                return &node->value;
+        }
+        return nullptr;
+    }
+
+    /// @brief Adds the value if the key is not found
+    /// @returns The value stored for the key
+    const Value& insert(const Key& key, const Value& value)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto& bucket = _buckets[index(key)];
+        auto head = bucket.load(std::memory_order_relaxed);
+        for (auto node = head; node != nullptr; node = node->next)
+        {
+            if (node->key == key)
+                return node->value;
+        }
+        auto node = new node_type{ key, value, head };
+        bucket.store(node, std::memory_order_release);
+        return node->value;
+    }
+
+private:
+    struct node_type
+    {
+        const Key         key;
+        const Value       value;
+        node_type* const  next;
+    };
+
+    std::array<std::atomic<node_type*>, BucketsCount> _buckets;
+    std::mutex _mutex;
+
+    static size_t index(const Key& key) { return Hash()(key) % BucketsCount; }
+};
+
+/// @}
+} // namespace iclgpu
@@ -13,8 +13,9 @@
 // limitations under the License.
 
 #pragma once
+#include "append_only_map.hpp"
 #include <memory>
-#include <unordered_map>
+#include <mutex>
 #include <exception>
 #include <typeindex>
 
@@ -33,6 +34,7 @@ class container
 
 public:
     /// @brief Context holder base class
+    /// @details Holders do not own the container, so they can be cached by container elements.
     class holder
     {
     public:
@@ -43,9 +45,9 @@ public:
 
         virtual ~holder() = default;
         /// @brief Get container/context reference
-        std::shared_ptr<C> context() const { return _context; }
+        std::shared_ptr<C> context() const { return _context.lock(); }
     private:
-        std::shared_ptr<C> _context;
+        std::weak_ptr<C> _context;
     };
 
     /// @brief Base class for objects onwed by container/context
@@ -72,19 +74,26 @@ public:
     };
 
     /// @brief Construct or get an object owned by container (singleton lifetime).
+    /// @details Thread-safe. Existing objects are found without locks, objects are constructed one at a time
+    /// and their constructors may get other objects.
     /// @tparam T inherited from class element
     template <class T, typename ... Args>
     typename std::enable_if<std::is_base_of<element_base, T>::value, std::shared_ptr<T>>::type
     get(Args&&...args)
     {
         element_key key(typeid(T));
-        auto it  = _elements.find(key);
-        if (it != _elements.end())
+        if (auto found = _elements.find(key))
+        {
+            return std::static_pointer_cast<T>(*found);
+        }
+
+        std::lock_guard<std::recursive_mutex> lock(_construction_mutex);
+        if (auto found = _elements.find(key))
         {
-            return std::static_pointer_cast<T>(it->second);
+            return std::static_pointer_cast<T>(*found);
         }
         auto result = instantiate<T>(std::forward<Args>(args)...);
-        _elements.insert(std::make_pair(key, result));
+        _elements.insert(key, result);
         return result;
     }
 
@@ -97,7 +106,8 @@ public:
     }
 
 private:
-    std::unordered_map<element_key, std::shared_ptr<element_base>> _elements;
+    append_only_map<element_key, std::shared_ptr<element_base>, std::hash<element_key>, 1024> _elements;
+    std::recursive_mutex _construction_mutex;
 
     template<class T, class... Args>
     std::enable_if_t<std::is_constructible<T, std::shared_ptr<C>, Args&&...>::value, std::shared_ptr<T>>
@@ -14,6 +14,7 @@
 
 #pragma once
 #include "container.hpp"
+#include <atomic>
 
 namespace iclgpu
 {
@@ -27,14 +28,15 @@ struct engine;
 enum class engine_type
 {
     default_engine, ///< engine type registered as default
-    open_cl         ///< Open CL engine
+    open_cl,        ///< Open CL engine
+    host            ///< Host CPU engine
 };
 
 /// @brief Global library context provides access to all library objects.
 class context : public container<context>, public std::enable_shared_from_this<context>
 {
-    context()
-        : _default_engine_type(engine_type::open_cl) {}
+    explicit context(size_t device)
+        : _default_engine_type(engine_type::default_engine), _device(device) {}
 
 public:
     /// @brief Return function dispatcher
@@ -44,10 +46,28 @@ public:
     /// @param engine_type engine type to be returned
     std::shared_ptr<engine> get_engine(engine_type type = engine_type::default_engine);
 
+    /// @brief Returns type of the engine registered as default
+    /// @details Selected by @b ICLGPU_ENGINE environment variable: @c opencl, @c host or @c auto (default).
+    /// @c auto selects OpenCL engine if OpenCL device is available and host engine otherwise.
+    engine_type get_default_engine_type();
+
+    /// @brief Returns index of the OpenCL device used by the context
+    /// @details Index in the list of ocl_engine::get_device_names(). Contexts created without device index
+    /// use the device set by @b ICLGPU_DEVICE environment variable, the first device by default.
+    size_t get_device();
+
     /// @brief Create Context instance
-    static std::shared_ptr<context> create() { return std::shared_ptr<context>(new context); }
+    static std::shared_ptr<context> create() { return std::shared_ptr<context>(new context(default_device)); }
+
+    /// @brief Create Context instance using OpenCL device @p device
+    /// @param device index in the list of ocl_engine::get_device_names()
+    static std::shared_ptr<context> create(size_t device) { return std::shared_ptr<context>(new context(device)); }
 private:
-    engine_type _default_engine_type;
+    static const size_t default_device = static_cast<size_t>(-1);
+
+    // Resolved on first use by any thread
+    std::atomic<engine_type> _default_engine_type;
+    std::atomic<size_t> _device;
 };
 
 /// @}
@@ -0,0 +1,91 @@
+// Copyright (c) 2017-2018 Intel Corporation
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//      http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include "context.hpp"
+#include "dispatcher.hpp"
+#include "engine.hpp"
+#include "errors.hpp"
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace iclgpu
+{
+/// @addtogroup context Context management
+/// @{
+
+/// @brief OpenCL devices sharing work of the context
+/// @details Member 0 is the context itself, other members are child contexts with own engines created on first use.
+/// Multi-device implementations shard work between members proportionally to the device throughput and merge
+/// completion events of the parts into event_group.
+/// Devices are set by set_devices() or by @b ICLGPU_DEVICES environment variable: @c all or comma-separated
+/// device indices. By default the context works alone.
+class device_group : public context::element<device_group>
+{
+public:
+    using initializer_type = std::function<void(const std::shared_ptr<iclgpu::context>&)>;
+
+    explicit device_group(const std::shared_ptr<iclgpu::context>& ctx);
+
+    /// @brief Sets devices of the group
+    /// @param devices indices of ocl_engine::get_device_names(). The first occurrence of the context device is
+    /// the context itself, the context device is a member even if it is not listed. Repeated devices get own engines.
+    void set_devices(const std::vector<size_t>& devices);
+
+    /// @brief Returns number of members including the context itself
+    size_t size();
+
+    /// @brief Returns context of the member, the context itself for @p index 0
+    std::shared_ptr<iclgpu::context> get_context(size_t index);
+
+    /// @brief Sets function called for each created child context, e.g. to register kernels of the library
+    void set_context_initializer(const initializer_type& initializer);
+
+    /// @brief Splits @p count items between members proportionally to device throughput
+    /// @returns Number of items per member, multiples of @p granularity except the last non-empty part
+    std::vector<size_t> split(size_t count, size_t granularity = 1);
+
+    /// @brief Executes the part of the function on the member
+    /// @details The context itself runs the best implementation other than @p self, so the distributing
+    /// implementation is not called recursively. Members do not share buffers: parameters should use host data.
+    template <class Func>
+    std::shared_ptr<event> execute_part(size_t index, typename Func::params& params,
+                                        const std::vector<std::shared_ptr<event>>& dep_events,
+                                        const typename Func::impl* self)
+    {
+        if (index != 0)
+            return get_context(index)->get_dispatcher()->template execute_function<Func>(params, dep_events);
+
+        for (auto& impl : context()->get_dispatcher()->template select<Func>(params))
+        {
+            if (impl.second.get() != self)
+                return impl.second->execute(params, dep_events);
+        }
+        throw error_unsupported("Function parameters are not supported");
+    }
+
+private:
+    std::mutex _mutex;
+    std::vector<size_t> _devices;
+    std::vector<std::shared_ptr<iclgpu::context>> _contexts;
+    std::vector<float> _weights;
+    initializer_type _initializer;
+
+    float get_weight(size_t index);
+};
+
+/// @}
+} // namespace iclgpu
@@ -17,6 +17,9 @@
 #include "functions_base.hpp"
 #include "engine.hpp"
 #include "context.hpp"
+#include "tracer.hpp"
+#include "performance_db.hpp"
+#include <chrono>
 #include <vector>
 #include <memory>
 #include <stdexcept>
@@ -41,6 +44,14 @@ public:
         return selector->select(params);
     }
 
+    /// @brief Same as select(), but the list can be reused by calls with similar parameters
+    template <class Func>
+    std::shared_ptr<const functions::scored_impls_list<Func>> select_cached(typename Func::params& params) const
+    {
+        auto selector = context()->get<typename Func::selector>();
+        return selector->select_cached(params);
+    }
+
     /// @brief Executes a function
     /// @tparam Func the function to be executed
     /// @param params Actual function parameters
@@ -51,13 +62,17 @@ public:
                             std::shared_ptr<event>>::type
     execute_function(typename Func::params& params, const std::vector<std::shared_ptr<event>>& dep_events = {}) const
     {
-        auto impls = select<Func>(params);
-        if (impls.size() == 0)
+        tracer::span span("function", Func::name());
+        auto impls = select_cached<Func>(params);
+        if (impls->size() == 0)
         {
             throw error_unsupported("Function parameters are not supported");
         }
 
-        return impls[0].second->execute(params, dep_events);
+        return run_selected<Func>(params, *impls, span, [&](typename Func::impl& impl)
+        {
+            return impl.execute(params, dep_events);
+        });
     }
 
     /// @brief Executes a function
@@ -70,16 +85,55 @@ public:
                             std::shared_ptr<event>>::type
     execute_function(typename Func::params& params, const std::vector<std::shared_ptr<event>>& dep_events = {}) const
     {
-        auto impls = select<Func>(params);
-        if (impls.size() == 0)
+        tracer::span span("function", Func::name());
+        auto impls = select_cached<Func>(params);
+        if (impls->size() == 0)
         {
             throw error_unsupported("Function parameters are not supported");
         }
 
-        auto cmd_builder = impls[0].second->selected();
-        if (!cmd_builder) throw std::logic_error("selected() is not implemented.");
-        auto cmd = cmd_builder(params);
-        return cmd->submit(dep_events);
+        return run_selected<Func>(params, *impls, span, [&](typename Func::impl& impl)
+        {
+            auto cmd_builder = impl.selected();
+            if (!cmd_builder) throw std::logic_error("selected() is not implemented.");
+            auto cmd = cmd_builder(params);
+            return cmd->submit(dep_events);
+        });
+    }
+
+private:
+    /// @brief Runs the implementation with the highest score or the one chosen by performance_db
+    /// @details Calls measured for performance_db wait for completion, so the time of each accepted
+    /// implementation is known. Calls recorded by engine::begin_capture() are never measured.
+    template <class Func, class Run>
+    std::shared_ptr<event> run_selected(const typename Func::params&           params,
+                                        const functions::scored_impls_list<Func>& impls,
+                                        tracer::span&                            span,
+                                        Run                                      run) const
+    {
+        size_t index = 0;
+        bool measure = false;
+        std::string key;
+        auto perf_db = context()->get<performance_db>();
+        if (impls.size() > 1 && perf_db->is_enabled() && !context()->get_engine()->is_capturing())
+        {
+            key = Func::shape(params);
+            std::vector<const char*> names;
+            for (auto& impl : impls)
+                names.push_back(impl.second->name());
+            index = perf_db->select(key, names, measure);
+        }
+
+        auto& impl = *impls[index].second;
+        span.set_detail(impl.full_name());
+        if (!measure)
+            return run(impl);
+
+        auto start = std::chrono::steady_clock::now();
+        auto evt = run(impl);
+        if (evt) evt->wait();
+        perf_db->record(key, impl.name(), std::chrono::steady_clock::now() - start);
+        return evt;
     }
 };
 
@@ -15,12 +15,17 @@
 #pragma once
 #include <memory>
 #include <exception>
+#include <stdexcept>
 #include <typeinfo>
 #include <vector>
 #include <type_traits>
 #include <chrono>
 #include <map>
+#include <string>
 #include <cassert>
+#include <cstdint>
+#include <functional>
+#include <utility>
 
 namespace iclgpu
 {
@@ -73,8 +78,43 @@ struct event : engine_object
 {
     using engine_object::engine_object;
     /// @brief Wait for the event completion
-    /// @return duration of the process controlled by the Event (e.g. kernel execution time)
-    virtual std::chrono::nanoseconds wait() = 0;
+    virtual void wait() = 0;
+
+    /// @brief Wait for the event completion and return duration of the process controlled by the Event
+    /// (e.g. kernel execution time)
+    /// @details Throws error_unsupported if profiling was not enabled on the engine when the command was submitted.
+    /// @sa engine::set_profiling
+    virtual std::chrono::nanoseconds duration() = 0;
+
+    /// @brief Calls @p callback once the event is completed, possibly on another thread
+    /// @details The callback must not block. The default implementation waits for the event, which suits
+    /// events completed on submission.
+    virtual void on_completion(const std::function<void()>& callback)
+    {
+        wait();
+        callback();
+    }
+};
+
+/// @brief Event of commands submitted to several engines, completed when all the events are
+/// @details Used to merge results of work shared by engines of different devices.
+/// Engines wait for the events of other engines on the host.
+struct event_group : event
+{
+    event_group(const std::shared_ptr<engine>& engine, const std::vector<std::shared_ptr<event>>& events);
+
+    void wait() override;
+
+    /// @brief Returns the longest duration of the events
+    std::chrono::nanoseconds duration() override;
+
+    /// @brief Calls @p callback when the last of the events is completed
+    void on_completion(const std::function<void()>& callback) override;
+
+    const std::vector<std::shared_ptr<event>>& events() const { return _events; }
+
+private:
+    std::vector<std::shared_ptr<event>> _events;
 };
 
 /// @brief Represents a command queue within an Engine
@@ -117,11 +157,53 @@ struct buffer : engine_object
     virtual size_t size() const = 0;
     /// @brief Returns direct raw pointer to the buffer data
     virtual void* get_host_ptr() = 0;
+
+    /// @brief Copy @p rows rows of @p row_size bytes from host memory to the buffer
+    /// @param offset Offset of the first row in the buffer
+    /// @param pitch Distance between rows in the buffer
+    /// @param host_ptr Pointer to the first row in host memory
+    /// @param host_pitch Distance between rows in host memory
+    virtual void write_rect(size_t offset, size_t pitch, const void* host_ptr, size_t host_pitch,
+                            size_t row_size, size_t rows) = 0;
+
+    /// @brief Copy @p rows rows of @p row_size bytes from the buffer to host memory
+    /// @sa write_rect
+    virtual void read_rect(size_t offset, size_t pitch, void* host_ptr, size_t host_pitch,
+                           size_t row_size, size_t rows) = 0;
+
+    /// @brief Returns buffer sharing memory with @p size bytes of this buffer starting at @p offset
+    /// @details Throws error_unsupported if the engine does not support the offset alignment.
+    virtual std::shared_ptr<buffer> get_sub_buffer(size_t offset, size_t size) = 0;
+};
+
+/// @brief Registry of engine buffers exposed to users as opaque pointers
+/// @details Every buffer gets unique range of reserved inaccessible host address space.
+/// So pointer arithmetic on opaque pointers addresses parts of the buffer.
+class device_memory
+{
+public:
+    /// @brief Returns opaque pointer to the @p buffer data
+    /// @param owner Object allowed to release the pointer, see remove()
+    static void* add(const std::shared_ptr<buffer>& buffer, const void* owner = nullptr);
+
+    /// @brief Releases opaque pointer returned by add()
+    /// @returns false if @p ptr is not an opaque pointer or it was added by other @p owner
+    static bool remove(void* ptr, const void* owner = nullptr);
+
+    /// @brief Returns buffer addressed by @p ptr and offset of @p ptr in the buffer, or {NULL, 0} for host pointers
+    static std::pair<std::shared_ptr<buffer>, size_t> find(const void* ptr);
 };
 
 /// @brief Represents data direction for kernel command
 enum direction { none = 0x0, input = 0x1, output = 0x2, inout = input | output };
 
+/// @brief Initial content of memory buffers created without host data
+enum class buffer_init
+{
+    zero,          ///< filled with zeros, required by kernels accumulating into the buffer
+    uninitialized  ///< undefined content, for buffers entirely overwritten by kernels
+};
+
 /// @brief Binds host data and memory buffers per engine describing data direction (in/out) for kernel.
 class buffer_binding
 {
@@ -188,6 +270,11 @@ public:
     /// @details If there is no buffer binded - create and register new binded buffer
     std::shared_ptr<buffer> get_buffer(const std::shared_ptr<engine>& engine) const;
 
+    /// @brief Bind host-allocated data at @p ptr instead of the current one
+    /// @details Buffers created for the previous data are dropped, so commands using the binding
+    /// get buffers of the new data on the next submission.
+    void rebind(void* ptr);
+
     bool is_output() const { return (_direction & output) != 0; }
     bool is_input() const { return (_direction & input) != 0; }
 
@@ -230,6 +317,7 @@ protected:
 };
 
 /// @brief Represents set of command can be executed in parallel
+/// @details Engines may submit the commands to different queues. The returned event is completed when all commands are.
 struct commands_parallel : command
 {
     using command::command;
@@ -239,7 +327,7 @@ struct commands_parallel : command
 
     std::shared_ptr<event> submit(const std::vector<std::shared_ptr<event>>& dependencies = {},
                                   const command_queue&                       queue        = default_queue) override;
-private:
+protected:
     std::vector<std::shared_ptr<command>> _commands;
 };
 
@@ -348,6 +436,51 @@ protected:
 
 template <typename ElemTy, direction Dir> class blob;
 
+/// @brief Preprocessor definitions (name and value) used to build a kernels module variant
+/// @details Allows implementations to specialize kernel constants (e.g. tile sizes) at runtime.
+using kernel_defines = std::map<std::string, std::string>;
+
+/// @brief Build statistics of a kernels module
+struct module_build_info
+{
+    /// @brief How the module program was obtained
+    /// @details @c shared modules are built for another context using the same device
+    enum origin_type { source, precompiled, cached, shared };
+
+    /// @brief Module name followed by build options of the variant if any
+    std::string              module;
+    origin_type              origin;
+    /// @brief true if the module was built by warm-up
+    bool                     background;
+    std::chrono::nanoseconds duration;
+};
+
+/// @brief Commands recorded by engine::begin_capture()
+struct captured_commands
+{
+    /// @brief Recorded commands in submission order
+    std::shared_ptr<commands_sequence> sequence;
+    /// @brief Data bindings used by the recorded commands
+    std::vector<std::shared_ptr<buffer_binding>> bindings;
+};
+
+/// @brief Statistics of engine memory buffers allocator
+struct buffer_pool_stats
+{
+    /// @brief Number of buffers requested from the pool
+    uint64_t requests;
+    /// @brief Number of requests served by cached buffers
+    uint64_t hits;
+    /// @brief Number of device memory allocations
+    uint64_t allocations;
+    size_t   cached_buffers;
+    size_t   cached_bytes;
+    /// @brief Maximum total size of cached buffers
+    size_t   high_water_mark;
+
+    double hit_rate() const { return requests == 0 ? 0. : static_cast<double>(hits) / requests; }
+};
+
 /// @brief Base class for execution engines
 struct engine
 {
@@ -359,13 +492,25 @@ struct engine
     /// @brief Create kernel command
     /// @param name Kernel name
     /// @param module (optional) Module name in which kernel is defined
-    virtual std::shared_ptr<kernel_command> get_kernel(const std::string& name,
-                                                       const std::string& module = std::string()) = 0;
+    /// @param defines (optional) Preprocessor definitions the module is compiled with.
+    /// Each set of definitions is built and cached as separate program.
+    virtual std::shared_ptr<kernel_command> get_kernel(const std::string&    name,
+                                                       const std::string&    module = std::string(),
+                                                       const kernel_defines& defines = kernel_defines()) = 0;
+
+    /// @brief Create kernel command from the module variant with @p defines if the variant is already built
+    /// @details Otherwise the variant is built in background and the kernel comes from the module without
+    /// definitions, which may be precompiled. Definitions must not change results of the kernel,
+    /// see functions::specialization.
+    virtual std::shared_ptr<kernel_command> get_specialized_kernel(const std::string&    name,
+                                                                   const std::string&    module,
+                                                                   const kernel_defines& defines) = 0;
 
     /// @brief Create memory buffer within the engine
     /// @param size Requested buffer size
     /// @param ptr (optional) Raw pointer from which data should be copied to memory buffer
-    virtual std::shared_ptr<buffer> create_buffer(size_t size, void* ptr = nullptr) = 0;
+    /// @param init (optional) Initial content of the buffer if @p ptr is not set
+    virtual std::shared_ptr<buffer> create_buffer(size_t size, void* ptr = nullptr, buffer_init init = buffer_init::zero) = 0;
 
     /// @brief Create raise event command
     virtual std::shared_ptr<raise_event_command> get_raise_event_command() = 0;
@@ -378,12 +523,73 @@ struct engine
     /// @param commands (optional) Commands can be executed in parallel
     virtual std::shared_ptr<commands_parallel> get_commands_parallel(const std::vector<std::shared_ptr<command>>& commands = {}) = 0;
 
+    /// @brief Start building of kernel modules in background
+    /// @details Modules which are built or being built are skipped.
+    /// get_kernel() waits for the module being built or builds it itself if the build is not started yet.
+    /// @param modules Names of modules to be built
+    virtual void warmup(const std::vector<std::string>& modules) = 0;
+
+    /// @brief Wait for completion of all background module builds
+    virtual void wait_warmup() = 0;
+
+    /// @brief Returns build statistics of all modules built by the engine
+    virtual std::vector<module_build_info> get_build_info() = 0;
+
+    /// @brief Returns statistics of memory buffers allocator
+    virtual buffer_pool_stats get_buffer_pool_stats() = 0;
+
+    /// @brief Free memory buffers cached for reuse
+    virtual void trim_buffer_pool() = 0;
+
+    /// @brief Register host memory range, so kernels use buffer created once instead of new buffer on every call
+    /// @details Pointers inside the range (e.g. sub-matrices) are resolved to the same memory.
+    /// Host changes of the data must be published with sync_host_memory().
+    virtual void register_host_memory(void* ptr, size_t size) = 0;
+
+    /// @brief Unregister host memory range registered at @p ptr
+    virtual void unregister_host_memory(void* ptr) = 0;
+
+    /// @brief Publish host changes of registered memory to the engine
+    /// @param size Number of changed bytes at @p ptr, 0 means up to the end of the registered range
+    virtual void sync_host_memory(void* ptr, size_t size = 0) = 0;
+
+    /// @brief Returns buffer of host data inside registered memory or NULL if the data is not registered
+    virtual std::shared_ptr<buffer> get_registered_buffer(void* ptr, size_t size) = 0;
+
+    /// @brief Start recording of submitted commands instead of their execution
+    /// @details Submission of a kernel during capture returns completed event.
+    /// Recorded commands read current host data on every submission.
+    virtual void begin_capture() = 0;
+
+    /// @brief Stop recording started by begin_capture()
+    virtual captured_commands end_capture() = 0;
+
+    /// @brief Returns true between begin_capture() and end_capture()
+    virtual bool is_capturing() = 0;
+
+    /// @brief Enable collection of commands execution times used by event::duration() and tracing
+    /// @details Profiling may add overhead to every command submission, so it is disabled by default.
+    /// Waits for completion of submitted commands. Must not be called concurrently with commands submission.
+    virtual void set_profiling(bool enabled) = 0;
+
+    /// @brief Returns true if commands execution times are collected
+    virtual bool is_profiling_enabled() = 0;
+
+    /// @brief Reads data stored by store_device_data() for the same device
+    /// @returns false if the data is not found or persistent storage is disabled
+    virtual bool load_device_data(const std::string& name, std::string& data) = 0;
+
+    /// @brief Persistently stores device-specific data (e.g. measured performance) under @p name
+    /// @details Data is kept beside cached program binaries (see @b ICLGPU_CACHE_DIR), failures are ignored.
+    virtual void store_device_data(const std::string& name, const std::string& data) = 0;
+
     /// @brief Create temporary buffer with @b num elements of @b T
+    /// @details Content is undefined unless @p init is buffer_init::zero
     template <typename T = char>
-    std::shared_ptr<buffer_binding> get_temp_buffer(size_t num)
+    std::shared_ptr<buffer_binding> get_temp_buffer(size_t num, buffer_init init = buffer_init::uninitialized)
     {
         if (num == 0) throw std::invalid_argument("size should not be zero.");
-        return std::make_shared<buffer_binding>(create_buffer(num * sizeof_t<T>(), nullptr), none);
+        return std::make_shared<buffer_binding>(create_buffer(num * sizeof_t<T>(), nullptr, init), none);
     }
 
     /// @brief Get input buffer binding from Blob object
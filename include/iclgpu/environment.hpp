@@ -0,0 +1,61 @@
+// Copyright (c) 2017-2018 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <string>
+#include <cstdlib>
+#include <cstdint>
+
+namespace iclgpu
+{
+/// @brief Reads environment variable.
+/// @returns false if the variable is not defined, true otherwise (the value can be empty).
+inline bool get_environment_variable(const char* name, std::string& value)
+{
+#ifdef _MSC_VER
+    char* buf = nullptr;
+    size_t len = 0;
+    if (_dupenv_s(&buf, &len, name) != 0 || buf == nullptr)
+        return false;
+    value = buf;
+    free(buf);
+    return true;
+#else
+    auto env = std::getenv(name);
+    if (env == nullptr)
+        return false;
+    value = env;
+    return true;
+#endif
+}
+
+/// @brief Parses size value with optional K, M or G suffix.
+/// @returns default_value if the string cannot be parsed.
+inline uint64_t parse_size_value(const std::string& str, uint64_t default_value)
+{
+    char* end = nullptr;
+    auto value = std::strtoull(str.c_str(), &end, 10);
+    if (end == str.c_str())
+        return default_value;
+    switch (*end)
+    {
+    case 'k': case 'K': value <<= 10; break;
+    case 'm': case 'M': value <<= 20; break;
+    case 'g': case 'G': value <<= 30; break;
+    case '\0': break;
+    default: return default_value;
+    }
+    return value;
+}
+}
@@ -18,11 +18,18 @@
 #include <memory>
 #include <complex>
 #include <algorithm>
+#include <atomic>
 #include "context.hpp"
 #include "engine.hpp"
 #include "errors.hpp"
 #include <functional>
 #include <numeric>
+#include <string>
+#include <type_traits>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
 
 namespace iclgpu
 {
@@ -41,7 +48,7 @@ public:
         : _buffer_binding(nullptr) {}
 
     blob(ElemTy* ptr, size_t size)
-        : _buffer_binding(std::make_shared<buffer_binding>(ptr, size * sizeof_t<ElemTy>(), Dir))
+        : _buffer_binding(make_binding(ptr, size * sizeof_t<ElemTy>()))
     {}
 
     blob(const std::shared_ptr<buffer>& buffer, size_t size = 0)
@@ -50,7 +57,7 @@ public:
 
     //TODO Remove below by fixing client code.
     blob(ElemTy* ptr)
-        : _buffer_binding(std::make_shared<buffer_binding>(ptr, 0, Dir))
+        : _buffer_binding(make_binding(ptr, 0))
     {}
 
     std::shared_ptr<buffer_binding> get() const { return _buffer_binding; }
@@ -58,6 +65,19 @@ public:
     operator ElemTy*() const { return reinterpret_cast<ElemTy*>(_buffer_binding->get_host_ptr()); }
     operator std::shared_ptr<buffer_binding>() const { return get(); }
     operator bool() const { return _buffer_binding && _buffer_binding->is_defined(); }
+
+private:
+    /// @brief Pointers to device memory (see device_memory) are bound to the engine buffer
+    static std::shared_ptr<buffer_binding> make_binding(ElemTy* ptr, size_t size)
+    {
+        auto device = device_memory::find(ptr);
+        if (!device.first)
+            return std::make_shared<buffer_binding>(ptr, size, Dir);
+
+        auto& buffer = device.first;
+        auto sub_buffer = device.second == 0 ? buffer : buffer->get_sub_buffer(device.second, buffer->size() - device.second);
+        return std::make_shared<buffer_binding>(sub_buffer, Dir, size);
+    }
 };
 
 namespace functions
@@ -90,6 +110,127 @@ protected:
     array_type _data;
 };
 
+/// @brief Builds performance DB key of function parameters
+/// @details Parameters with close performance share the key: small integers (e.g. transpose flags, unit strides)
+/// are kept exact, larger ones are bucketed by log2. Scalars are reduced to zero, one or other value.
+/// @sa performance_db
+class shape_builder
+{
+public:
+    explicit shape_builder(const char* name)
+        : _key(name) {}
+
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value, shape_builder&>::type add(T value)
+    {
+        auto v = static_cast<int64_t>(value);
+        if (v >= -exact_limit && v <= exact_limit)
+            return append(std::to_string(v));
+
+        uint64_t magnitude = v < 0 ? 0 - static_cast<uint64_t>(v) : static_cast<uint64_t>(v);
+        int log2 = 0;
+        while (magnitude >>= 1)
+            ++log2;
+        return append((v < 0 ? "-p" : "p") + std::to_string(log2));
+    }
+
+    shape_builder& add(double value) { return append(value == 0. ? "z" : value == 1. ? "o" : "x"); }
+    shape_builder& add(const complex_t& value) { return add(value.imag() == 0.f ? value.real() : 2.f); }
+
+    const std::string& str() const { return _key; }
+
+private:
+    static const int64_t exact_limit = 4;
+    std::string _key;
+
+    shape_builder& append(const std::string& value)
+    {
+        _key += ':';
+        _key += value;
+        return *this;
+    }
+};
+
+/// @brief Builds kernel definitions which replace arguments by constants for common parameter values
+/// @details Implementation declares arguments its kernel allows to specialize. The kernel refers to such
+/// argument as SPEC_<name>, which falls back to the argument itself if it is not defined. Every combination
+/// of constants is a separate module variant, engine::get_specialized_kernel() builds it in background
+/// and uses the default module until the variant is ready.
+class specialization
+{
+public:
+    /// @brief Declares integer argument, specialized if it is equal to one (e.g. unit stride)
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value, specialization&>::type add(const char* name, T value)
+    {
+        return value == 1 ? define(name, "1") : *this;
+    }
+
+    /// @brief Declares scalar argument, specialized if it is equal to zero or one
+    specialization& add(const char* name, float value)
+    {
+        return value == 0.f ? define(name, "0.0f") : value == 1.f ? define(name, "1.0f") : *this;
+    }
+
+    const kernel_defines& defines() const { return _defines; }
+
+private:
+    kernel_defines _defines;
+
+    specialization& define(const char* name, const char* value)
+    {
+        _defines[std::string("SPEC_") + name] = value;
+        return *this;
+    }
+};
+
+/// @brief Values of function parameters in Func::selection_key
+/// @details Scalars are kept exact. Blobs are represented by their kind and alignment of host data,
+/// so calls with different data share the key.
+/// @sa selector_accept::select_cached
+template <typename T>
+typename std::enable_if<std::is_integral<T>::value, uint64_t>::type selection_value(T value)
+{
+    return static_cast<uint64_t>(static_cast<int64_t>(value));
+}
+
+inline uint64_t selection_value(float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+inline uint64_t selection_value(double value)
+{
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+inline uint64_t selection_value(const complex_t& value)
+{
+    return selection_value(value.real()) | selection_value(value.imag()) << 32;
+}
+
+template <typename ElemTy, direction Dir>
+uint64_t selection_value(const blob<ElemTy, Dir>& value)
+{
+    // Alignments above the limit are not distinguished
+    const unsigned max_alignment_log2 = 7;
+    auto binding = value.get();
+    if (!binding)
+        return 0;
+    if (binding->get_owning_engine())
+        return 1;
+
+    auto address = reinterpret_cast<std::uintptr_t>(binding->get_host_ptr());
+    unsigned alignment_log2 = 0;
+    while (alignment_log2 < max_alignment_log2 && (address & (std::uintptr_t(1) << alignment_log2)) == 0)
+        ++alignment_log2;
+    return 2 + (binding->size() != 0 ? 1 : 0) + 2 * alignment_log2;
+}
+
 //TODO remove this alias by changing implementations code to avoid this alias.
 using event = std::shared_ptr<iclgpu::event>;
 
@@ -107,6 +248,11 @@ struct function_impl : context::holder
     /// @brief string representation of function and the implementation
     virtual const char* full_name() const = 0;
 
+    /// @brief Type of the engine the implementation runs on
+    /// @details Only implementations of the context default engine type are selected.
+    /// engine_type::default_engine stands for implementations which do not use the engine.
+    virtual engine_type get_engine_type() const { return engine_type::open_cl; }
+
     /// @brief Check if the implementation supports actual function parameters values
     /// @param[in] params actual function parameters to be checked
     /// @param[in,out] score assuming implementation performance function_score based on actual parameters
@@ -176,6 +322,102 @@ struct score_builder_dot_product : context::holder
 };
 
 
+/// @brief Recent results of selector_accept::select_cached() for the function
+template <class Func>
+class selection_cache : public context::element<selection_cache<Func>>
+{
+public:
+    using key_type = typename Func::selection_key;
+    using value_type = std::shared_ptr<const scored_impls_list<Func>>;
+
+    /// @brief The cache is cleared when the number of keys exceeds the limit
+    static const size_t max_size = 256;
+
+    /// @brief Number of recently found entries each thread looks up without the lock
+    static const size_t recent_size = 4;
+
+    explicit selection_cache(const std::shared_ptr<iclgpu::context>& ctx)
+        : context::element<selection_cache>(ctx)
+        , _id(next_id()) {}
+
+    /// @returns NULL if the key is not found
+    value_type find(const key_type& key) const
+    {
+        // Threads usually repeat few shapes. Entries dropped by clearing stay valid: selection depends on the key only.
+        auto& recent = recent_entries();
+        for (auto& entry : recent.entries)
+        {
+            if (entry.owner == _id && entry.key == key)
+                return entry.value;
+        }
+
+        value_type result;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto it = _entries.find(key);
+            if (it == _entries.end())
+                return nullptr;
+            result = it->second;
+        }
+        recent.entries[recent.next++ % recent_size] = { _id, key, result };
+        return result;
+    }
+
+    void insert(const key_type& key, const value_type& value)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_entries.size() >= max_size)
+            _entries.clear();
+        _entries[key] = value;
+    }
+
+private:
+    struct key_hash
+    {
+        size_t operator()(const key_type& key) const
+        {
+            uint64_t hash = 0xcbf29ce484222325ULL;
+            for (auto value : key)
+            {
+                hash ^= value;
+                hash *= 0x100000001b3ULL;
+            }
+            return static_cast<size_t>(hash ^ (hash >> 32));
+        }
+    };
+
+    struct recent_entry
+    {
+        uint64_t   owner;
+        key_type   key;
+        value_type value;
+    };
+
+    struct recent_list
+    {
+        std::array<recent_entry, recent_size> entries;
+        size_t next;
+    };
+
+    /// @brief Entries of all caches of the function found by the calling thread
+    static recent_list& recent_entries()
+    {
+        thread_local recent_list recent = {};
+        return recent;
+    }
+
+    /// @brief Identifies the cache in recent entries, addresses of destroyed caches can be reused
+    static uint64_t next_id()
+    {
+        static std::atomic<uint64_t> last_id(0);
+        return ++last_id;
+    }
+
+    const uint64_t _id;
+    mutable std::mutex _mutex;
+    std::unordered_map<key_type, value_type, key_hash> _entries;
+};
+
 /// @brief Helper class to select function implementation by calling accept() method for each implementation.
 /// @tparam Func function type
 /// @tparam ScoreCalculator Helper class to calculate implementation score
@@ -183,8 +425,7 @@ template <class Func, class ScoreCalculator = score_builder_dot_product<Func>>
 struct selector_accept : context::holder
 {
     explicit selector_accept(const std::shared_ptr<iclgpu::context>& ctx)
-        : holder(ctx)
-        , _score_calculator(ctx->get<ScoreCalculator>()) {}
+        : holder(ctx) {}
 
 
     /// @brief Creates the list of function implementations which accept specified function parameters
@@ -198,16 +439,22 @@ struct selector_accept : context::holder
         }
 
         scored_impls_list<Func> result;
+        auto score_calculator = context()->template get<ScoreCalculator>();
+        const auto default_type = context()->get_default_engine_type();
 
         for (auto& impl : impls)
         {
+            auto impl_engine_type = impl->get_engine_type();
+            if (impl_engine_type != default_type && impl_engine_type != engine_type::default_engine)
+                continue;
+
             // note: default constructor for Func::score should initialize fields by 1.0.
             typename Func::score score;
             // call accept() for each function implementation,
             // calculate and select the high score implementation
             if (impl->accept(params, score))
             {
-                float calculated_score = _score_calculator->calculate_score_value(score);
+                float calculated_score = score_calculator->calculate_score_value(score);
                 result.push_back({calculated_score, impl});
             }
         }
@@ -222,8 +469,24 @@ struct selector_accept : context::holder
         return result;
     }
 
-private:
-    std::shared_ptr<ScoreCalculator> _score_calculator;
+    /// @brief Same as select(), but the result is reused for calls with the same Func::selection_key
+    /// @details Implementations of the functions with Func::selection_cached set must not read blobs data
+    /// in accept(). Returned implementations are shared by all calls.
+    std::shared_ptr<const scored_impls_list<Func>> select_cached(const typename Func::params& params)
+    {
+        if (!Func::selection_cached)
+            return std::make_shared<const scored_impls_list<Func>>(select(params));
+
+        auto key = Func::make_selection_key(params);
+        auto cache = context()->template get<selection_cache<Func>>();
+        auto result = cache->find(key);
+        if (!result)
+        {
+            result = std::make_shared<const scored_impls_list<Func>>(select(params));
+            cache->insert(key, result);
+        }
+        return result;
+    }
 };
 } //namespace functions
 
@@ -0,0 +1,144 @@
+// Copyright (c) 2017-2018 Intel Corporation
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//      http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+#include "context.hpp"
+#include "engine.hpp"
+#include "primitive_db.hpp"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/// @file host_engine.hpp
+/// Host CPU execution engine implementation
+
+namespace iclgpu
+{
+/// @addtogroup engine Execution engines
+/// @{
+
+class work_stealing_pool;
+
+/// @brief Arguments of host kernel set by kernel_command::set_arg()
+class host_kernel_args
+{
+public:
+    /// @brief Returns value of scalar argument @p idx
+    template <typename T>
+    T scalar(unsigned idx) const
+    {
+        T value;
+        get_scalar(idx, &value, sizeof(T));
+        return value;
+    }
+
+    /// @brief Returns host pointer to data of buffer argument @p idx
+    template <typename T>
+    T* buffer(unsigned idx) const
+    {
+        return static_cast<T*>(get_buffer(idx));
+    }
+
+    void set_scalar(unsigned idx, const void* ptr, size_t size);
+    void set_buffer(unsigned idx, void* ptr);
+
+private:
+    static const size_t max_scalar_size = 16;
+
+    struct arg
+    {
+        char   value[max_scalar_size];
+        size_t size = 0;
+        void*  ptr = nullptr;
+    };
+    std::vector<arg> _args;
+
+    void get_scalar(unsigned idx, void* ptr, size_t size) const;
+    void* get_buffer(unsigned idx) const;
+};
+
+/// @brief Host kernel function processing work items [begin, end) of the first work size dimension
+/// @details Chunks of the work size are processed concurrently by the engine threads.
+/// Chunk size is not less than the first parallel size dimension if it is set.
+using host_kernel_function = std::function<void(const host_kernel_args& args, size_t begin, size_t end)>;
+
+/// @brief Engine executing commands on host CPU threads
+/// @details Kernels are C++ functions run by a work-stealing pool of @b ICLGPU_HOST_THREADS threads.
+/// Commands are executed on submission, the submitting thread takes part in the work, so returned events
+/// are always completed. Buffers created for host data use the data in place.
+class host_engine : public engine, public context::element<host_engine>, public std::enable_shared_from_this<host_engine>
+{
+public:
+    explicit host_engine(const std::shared_ptr<iclgpu::context>& ctx);
+
+    ~host_engine() override; // -required because work_stealing_pool is incomplete type
+    primitive_db* get_primitive_db() override;
+    std::shared_ptr<kernel_command>      get_kernel(const std::string& name, const std::string& module = std::string(),
+                                                    const kernel_defines& defines = kernel_defines()) override;
+    std::shared_ptr<kernel_command>      get_specialized_kernel(const std::string& name, const std::string& module,
+                                                                const kernel_defines& defines) override;
+    std::shared_ptr<buffer>              create_buffer(size_t size, void* ptr, buffer_init init) override;
+    std::shared_ptr<raise_event_command> get_raise_event_command() override;
+    std::shared_ptr<commands_sequence>   get_commands_sequence(const std::vector<std::shared_ptr<command>>& commands) override;
+    std::shared_ptr<commands_parallel>   get_commands_parallel(const std::vector<std::shared_ptr<command>>& commands) override;
+    void                                 warmup(const std::vector<std::string>& modules) override;
+    void                                 wait_warmup() override;
+    std::vector<module_build_info>       get_build_info() override;
+    buffer_pool_stats                    get_buffer_pool_stats() override;
+    void                                 trim_buffer_pool() override;
+    void                                 register_host_memory(void* ptr, size_t size) override;
+    void                                 unregister_host_memory(void* ptr) override;
+    void                                 sync_host_memory(void* ptr, size_t size) override;
+    std::shared_ptr<buffer>              get_registered_buffer(void* ptr, size_t size) override;
+    void                                 begin_capture() override;
+    captured_commands                    end_capture() override;
+    bool                                 is_capturing() override;
+    void                                 set_profiling(bool enabled) override;
+    bool                                 is_profiling_enabled() override;
+    bool                                 load_device_data(const std::string& name, std::string& data) override;
+    void                                 store_device_data(const std::string& name, const std::string& data) override;
+
+    /// @brief Create kernel command executing @p function
+    /// @param name Kernel name reported by tracing
+    std::shared_ptr<kernel_command> get_kernel(const std::string& name, const host_kernel_function& function);
+
+    /// @brief Calls @p body for chunks of [begin, end) range on the engine threads and waits for completion
+    /// @param grain Minimum chunk size, 0 selects it by the number of threads
+    void parallel_for(size_t begin, size_t end, size_t grain, const std::function<void(size_t, size_t)>& body);
+
+    /// @brief Number of threads executing kernels
+    size_t concurrency() const;
+
+    /// @brief Records @p cmd instead of its execution if capture is started
+    /// @returns false if capture is not started
+    bool capture(const std::shared_ptr<command>& cmd);
+
+    /// @brief Adds @p binding to the bindings of captured commands if capture is started
+    void capture_binding(const std::shared_ptr<buffer_binding>& binding);
+
+private:
+    std::unique_ptr<work_stealing_pool> _pool;
+    primitive_db                        _primitive_db;
+    std::atomic<bool>                   _profiling{false};
+    std::mutex                          _capture_mutex;
+    std::atomic<bool>                   _capturing{false};
+    captured_commands                   _capture;
+};
+
+
+/// @}
+}
@@ -16,6 +16,8 @@
 #include "context.hpp"
 #include "engine.hpp"
 #include <memory>
+#include <string>
+#include <vector>
 
 /// @file ocl_engine.hpp
 /// OpenCL execution engine implementation
@@ -34,11 +36,39 @@ public:
 
     ~ocl_engine() override; // -required because ocl_toolkit is incomplete type
     primitive_db* get_primitive_db() override;
-    std::shared_ptr<kernel_command>      get_kernel(const std::string& name, const std::string& module = std::string()) override;
-    std::shared_ptr<buffer>              create_buffer(size_t size, void* ptr) override;
+    std::shared_ptr<kernel_command>      get_kernel(const std::string& name, const std::string& module = std::string(),
+                                                    const kernel_defines& defines = kernel_defines()) override;
+    std::shared_ptr<kernel_command>      get_specialized_kernel(const std::string& name, const std::string& module,
+                                                                const kernel_defines& defines) override;
+    std::shared_ptr<buffer>              create_buffer(size_t size, void* ptr, buffer_init init) override;
     std::shared_ptr<raise_event_command> get_raise_event_command() override;
     std::shared_ptr<commands_sequence>   get_commands_sequence(const std::vector<std::shared_ptr<command>>& commands) override;
     std::shared_ptr<commands_parallel>   get_commands_parallel(const std::vector<std::shared_ptr<command>>& commands) override;
+    void                                 warmup(const std::vector<std::string>& modules) override;
+    void                                 wait_warmup() override;
+    std::vector<module_build_info>       get_build_info() override;
+    buffer_pool_stats                    get_buffer_pool_stats() override;
+    void                                 trim_buffer_pool() override;
+    void                                 register_host_memory(void* ptr, size_t size) override;
+    void                                 unregister_host_memory(void* ptr) override;
+    void                                 sync_host_memory(void* ptr, size_t size) override;
+    std::shared_ptr<buffer>              get_registered_buffer(void* ptr, size_t size) override;
+    void                                 begin_capture() override;
+    captured_commands                    end_capture() override;
+    bool                                 is_capturing() override;
+    void                                 set_profiling(bool enabled) override;
+    bool                                 is_profiling_enabled() override;
+    bool                                 load_device_data(const std::string& name, std::string& data) override;
+    void                                 store_device_data(const std::string& name, const std::string& data) override;
+
+    /// @brief Returns relative throughput of the engine device, used to balance work between devices
+    float get_device_weight() const;
+
+    /// @brief Returns true if the device works on host memory without copies, e.g. integrated GPU or CPU device
+    bool is_host_memory_shared() const;
+
+    /// @brief Returns names of OpenCL devices in the order of device indices, see context::create(size_t)
+    static std::vector<std::string> get_device_names();
 
     const ocl_toolkit& toolkit() const { return *_ocl_toolkit; }
     ocl_toolkit& toolkit() { return *_ocl_toolkit; }
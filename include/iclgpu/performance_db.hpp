@@ -0,0 +1,92 @@
+// Copyright (c) 2017-2018 Intel Corporation
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//      http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+#include "context.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace iclgpu
+{
+struct engine;
+
+/// @addtogroup functions Functions definition and implementation
+/// @{
+
+/// @brief Measured performance of function implementations used to select the fastest one
+/// @details Keys are built from function parameters by shape_builder, so similar calls share the measurements.
+/// While measuring is enabled, first calls of each key run every accepted implementation in turn and the
+/// dispatcher reports their times; later calls run the fastest implementation.
+/// Measurements of the device are loaded when measuring is enabled and stored when the context is destroyed.
+/// Measuring is enabled by set_enabled() or by non-zero @b ICLGPU_TUNING environment variable.
+class performance_db : public context::element<performance_db>
+{
+public:
+    /// @brief Number of measured calls of each implementation before the fastest one is chosen
+    static const unsigned samples_count = 3;
+    /// @brief Name of the device data file, see engine::store_device_data()
+    static const char* data_name() { return "perfdb"; }
+
+    explicit performance_db(const std::shared_ptr<iclgpu::context>& ctx);
+    ~performance_db() override;
+
+    bool is_enabled() const { return _enabled.load(std::memory_order_relaxed); }
+
+    /// @brief Enables measuring, loads stored measurements of the context engine device on first enabling
+    void set_enabled(bool enabled);
+
+    /// @brief Chooses implementation to run
+    /// @param key Shape key of the function parameters
+    /// @param impls Names of accepted implementations ordered by static score
+    /// @param[out] measure true if the call should be timed and reported by record()
+    /// @returns Index of the implementation in @p impls
+    size_t select(const std::string& key, const std::vector<const char*>& impls, bool& measure);
+
+    /// @brief Reports execution time of the implementation chosen by select()
+    void record(const std::string& key, const std::string& impl, std::chrono::nanoseconds duration);
+
+    /// @brief Returns measurements in text form
+    std::string serialize() const;
+
+    /// @brief Merges measurements in the form returned by serialize()
+    /// @returns false if the data has unknown format
+    bool deserialize(const std::string& data);
+
+    /// @brief Stores measurements of the device if they were changed
+    void save();
+
+private:
+    struct entry
+    {
+        unsigned samples;
+        uint64_t best;
+    };
+
+    std::atomic<bool> _enabled{false};
+    mutable std::mutex _mutex;
+    std::unordered_map<std::string, std::map<std::string, entry>> _entries;
+    std::shared_ptr<engine> _engine;
+    bool _modified = false;
+};
+
+/// @}
+}
@@ -16,22 +16,36 @@
 #include <unordered_map>
 #include <initializer_list>
 #include <algorithm>
+#include <mutex>
 #include <string>
+#include <vector>
 
 namespace iclgpu
 {
 /// @brief Helper class to store kernel sources
+/// @details Thread-safe: sources can be inserted while modules are built.
 class primitive_db
 {
 public:
     using db_type = std::unordered_map<std::string, std::string>;
     using value_type = db_type::value_type;
 
+    /// @brief Precompiled (SPIR-V) module. Data must have static storage duration.
+    struct binary_value_type
+    {
+        const char* name;
+        const unsigned char* data;
+        size_t size;
+    };
+
     virtual ~primitive_db() = default;
 
     /// @brief Get kernel source code by it's name
     std::string get(const std::string& id);
 
+    /// @brief Returns names of all modules (headers are not included)
+    std::vector<std::string> module_names() const;
+
 
     /// @brief Add kernel source to the DB
     virtual void insert(const value_type& value);
@@ -58,8 +72,25 @@ public:
         insert_range(std::cbegin(ilist), std::cend(ilist));
     }
 
+    /// @brief Add precompiled modules to the DB.
+    /// @details The list is terminated by an entry with null name. The list must have static storage duration.
+    /// A precompiled module is dropped if its source or any header is replaced later.
+    void insert_binaries(const binary_value_type* values);
+
+    /// @brief Get precompiled module by it's name
+    /// @returns nullptr if there is no precompiled module
+    const binary_value_type* get_binary(const std::string& id) const;
+
 protected:
+    enum class insert_result { unchanged, added, replaced };
+    /// @brief Adds the source or replaces existing one, see insert()
+    insert_result store(const value_type& value);
+
+private:
+    mutable std::mutex _mutex;
     db_type _db;
+    // Entries of the lists passed to insert_binaries()
+    std::unordered_map<std::string, const binary_value_type*> _binaries;
 };
 
 }
@@ -0,0 +1,110 @@
+// Copyright (c) 2017-2018 Intel Corporation
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//      http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+#include "engine.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+
+namespace iclgpu
+{
+/// @addtogroup engine Execution engines
+/// @{
+
+/// @brief Device timestamps of a command in nanoseconds
+struct command_timestamps
+{
+    uint64_t queued;
+    uint64_t submit;
+    uint64_t start;
+    uint64_t end;
+};
+
+/// @brief Process-wide recorder of host dispatch spans and device commands
+/// @details Tracing is enabled by enable() or by @b ICLGPU_TRACE environment variable which names the file
+/// the trace is written to at process exit. Recorded events are exported in Chrome trace JSON format
+/// (chrome://tracing). When tracing is disabled every hook costs single relaxed atomic load.
+class tracer
+{
+public:
+    /// @brief Reads timestamps of a traced command
+    /// @param wait Wait for the command completion if true
+    /// @returns false if the command is not completed
+    using timestamps_query = std::function<bool(bool wait, command_timestamps& timestamps)>;
+
+    /// @brief Description of a command submitted to a device
+    struct command_info
+    {
+        std::string      name;
+        nd_range         work_size;
+        nd_range         parallel_size;
+        size_t           queue;
+        timestamps_query query;
+    };
+
+    /// @brief Host span (e.g. function dispatch) recorded from construction to destruction
+    /// @details Commands submitted by the thread inside the span are attributed to it.
+    class span
+    {
+    public:
+        span(const char* category, const char* name);
+        ~span();
+
+        span(const span&) = delete;
+        span& operator=(const span&) = delete;
+
+        /// @brief Sets name of the implementation selected for the span
+        void set_detail(const char* detail) { _detail = detail; }
+
+    private:
+        friend class tracer;
+        const char* _category = nullptr;
+        const char* _name = nullptr;
+        const char* _detail = nullptr;
+        span*       _parent = nullptr;
+        bool        _active = false;
+        std::chrono::steady_clock::time_point _start;
+    };
+
+    static bool enabled() { return _enabled.load(std::memory_order_relaxed); }
+    static void enable(bool value);
+
+    /// @brief Enables tracing if @b ICLGPU_TRACE environment variable is set. Evaluated once per process.
+    static void configure_from_environment();
+
+    /// @brief Records command submitted by the calling thread
+    static void add_command(command_info&& info);
+
+    /// @brief Waits for all recorded commands and reads their timestamps
+    /// @details Should be called before the engine which submitted the commands is destroyed.
+    static void flush();
+
+    /// @brief Writes recorded events in Chrome trace JSON format and clears them
+    static void write(std::ostream& stream);
+
+    /// @brief Writes recorded events to the file
+    /// @returns false if the file cannot be written
+    static bool write(const std::string& file_name);
+
+private:
+    static std::atomic<bool> _enabled;
+};
+
+/// @}
+}
@@ -0,0 +1,45 @@
+/* Copyright (c) 2017-2018 Intel Corporation
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+__kernel void CgemmStridedBatched_naive(int transa, int transb, int m, int n, int k, complex_t alpha,
+                                        __global complex_t* A, int lda, long strideA,
+                                        __global complex_t* B, int ldb, long strideB, complex_t beta,
+                                        __global complex_t* C, int ldc, long strideC)
+{
+    const int i = get_global_id(0);
+    const int j = get_global_id(1);
+    const long batch = get_global_id(2);
+
+    A += batch * strideA;
+    B += batch * strideB;
+    C += batch * strideC;
+
+    complex_t value = (complex_t)(0.f, 0.f);
+    for (int l = 0; l < k; l++)
+    {
+        complex_t a = transa == 0 ? A[l * lda + i] : A[i * lda + l];
+        complex_t b = transb == 0 ? B[j * ldb + l] : B[l * ldb + j];
+        if (transa == 2)
+            a = conjg(a);
+        if (transb == 2)
+            b = conjg(b);
+        value += cmul(a, b);
+    }
+
+    if (creal(beta) == 0.f && cimag(beta) == 0.f)
+        C[j * ldc + i] = cmul(alpha, value);
+    else
+        C[j * ldc + i] = cmul(alpha, value) + cmul(beta, C[j * ldc + i]);
+}
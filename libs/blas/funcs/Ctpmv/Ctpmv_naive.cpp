@@ -42,7 +42,7 @@ event Ctpmv_naive::execute(const Ctpmv::params& params, const std::vector<event>
     kernel->set_arg(5, buf_x);
     kernel->set_arg(6, params.incx);
 
-    auto buf_parties = engine->get_temp_buffer(params.n * sizeof(iclgpu::complex_t));
+    auto buf_parties = engine->get_temp_buffer(params.n * sizeof(iclgpu::complex_t), buffer_init::zero);
     kernel->set_arg(7, buf_parties);
 
     auto gws = nd_range(1);
@@ -0,0 +1,66 @@
+// Copyright (c) 2017-2018 Intel Corporation
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//      http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "functions/Saxpy.hpp"
+#include "host/host_engine.hpp"
+#include "../implementation_helpers.hpp"
+
+static const char* kernel_name = "Saxpy_host";
+
+namespace iclgpu { namespace functions { namespace implementations {
+
+bool Saxpy_host::accept(const Saxpy::params& params, Saxpy::score& score)
+{
+    return true;
+}
+
+event Saxpy_host::execute(const Saxpy::params& params, const std::vector<event>& dep_events)
+{
+    auto engine = context()->get<host_engine>();
+    auto kernel = engine->get_kernel(kernel_name, [](const host_kernel_args& args, size_t begin, size_t end)
+    {
+        auto n = args.scalar<int>(0);
+        auto alpha = args.scalar<float>(1);
+        auto incx = args.scalar<int>(3);
+        auto incy = args.scalar<int>(5);
+        auto x = args.buffer<const float>(2) + first_element(n, incx);
+        auto y = args.buffer<float>(4) + first_element(n, incy);
+
+        if (incx == 1 && incy == 1)
+        {
+            for (size_t i = begin; i < end; ++i)
+                y[i] += alpha * x[i];
+        }
+        else
+        {
+            for (auto i = static_cast<std::ptrdiff_t>(begin); i < static_cast<std::ptrdiff_t>(end); ++i)
+                y[i * incy] += alpha * x[i * incx];
+        }
+    });
+
+    kernel->set_arg(0, params.n);
+    kernel->set_arg(1, params.alpha);
+    auto buf_x = engine->get_input_buffer(params.x, vector_size(params.n, params.incx));
+    kernel->set_arg(2, buf_x);
+    kernel->set_arg(3, params.incx);
+    auto buf_y = engine->get_inout_buffer(params.y, vector_size(params.n, params.incy));
+    kernel->set_arg(4, buf_y);
+    kernel->set_arg(5, params.incy);
+
+    kernel->set_options({ nd_range(params.n), nd_range(4096) });
+
+    return kernel->submit(dep_events);
+}
+
+} } } // namespace iclgpu::functions::implementations
@@ -13,8 +13,10 @@
  * limitations under the License.
  */
 
+#include "specialization.h"
+
 __kernel void Saxpy_naive(float alpha, __global float* x, uint incx, __global float* y, uint incy)
 {
     uint gid = get_global_id(0);
-    y[gid * incy] += alpha * x[gid * incx];
+    y[gid * SPEC_incy] += SPEC_alpha * x[gid * SPEC_incx];
 }
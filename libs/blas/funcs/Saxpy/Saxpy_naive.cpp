@@ -29,7 +29,11 @@ event Saxpy_naive::execute(const Saxpy::params& params, const std::vector<event>
 {
 
     auto engine = context()->get_engine();
-    auto kernel = engine->get_kernel(kernel_name, module_name);
+    auto kernel = engine->get_specialized_kernel(kernel_name, module_name, specialization()
+                                                 .add("alpha", params.alpha)
+                                                 .add("incx", params.incx)
+                                                 .add("incy", params.incy)
+                                                 .defines());
 
     size_t x_buf_size = params.n * params.incx;
     size_t y_buf_size = params.n * params.incy;
@@ -0,0 +1,20 @@
+/* Copyright (c) 2017-2018 Intel Corporation
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+__kernel void Saxpy_device_scalar_naive(__global float* alpha, __global float* x, uint incx, __global float* y, uint incy)
+{
+    uint gid = get_global_id(0);
+    y[gid * incy] += alpha[0] * x[gid * incx];
+}
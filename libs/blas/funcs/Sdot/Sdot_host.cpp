@@ -0,0 +1,100 @@
+// Copyright (c) 2017-2018 Intel Corporation
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//      http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "functions/Sdot.hpp"
+#include "host/host_engine.hpp"
+#include "../implementation_helpers.hpp"
+#include <algorithm>
+
+static const char* first_kernel_name = "Sdot_host_blocks";
+static const char* second_kernel_name = "Sdot_host_sum";
+
+namespace iclgpu { namespace functions { namespace implementations {
+
+// Elements reduced by one work item of the first stage, partial sums don't depend on the number of threads
+static const size_t block_size = 4096;
+
+bool Sdot_host::accept(const Sdot::params& params, Sdot::score& score)
+{
+    return true;
+}
+
+event Sdot_host::execute(const Sdot::params& params, const std::vector<event>& dep_events)
+{
+    auto engine = context()->get<host_engine>();
+    const size_t blocks = (params.n + block_size - 1) / block_size;
+
+    // First stage: partial sums of blocks
+    auto first_kernel = engine->get_kernel(first_kernel_name, [](const host_kernel_args& args, size_t begin, size_t end)
+    {
+        auto block_sums = args.buffer<float>(0);
+        auto n = args.scalar<int>(1);
+        auto incx = args.scalar<int>(3);
+        auto incy = args.scalar<int>(5);
+        auto x = args.buffer<const float>(2) + first_element(n, incx);
+        auto y = args.buffer<const float>(4) + first_element(n, incy);
+
+        for (size_t block = begin; block < end; ++block)
+        {
+            auto first = static_cast<std::ptrdiff_t>(block * block_size);
+            auto last = std::min<std::ptrdiff_t>(first + block_size, n);
+            if (incx == 1 && incy == 1)
+            {
+                block_sums[block] = host_dot(x + first, y + first, last - first);
+            }
+            else
+            {
+                float sum = 0.f;
+                for (auto i = first; i < last; ++i)
+                    sum += x[i * incx] * y[i * incy];
+                block_sums[block] = sum;
+            }
+        }
+    });
+
+    auto buf_block_sums = engine->get_temp_buffer<float>(blocks);
+    first_kernel->set_arg(0, buf_block_sums);
+    first_kernel->set_arg(1, params.n);
+    auto buf_x = engine->get_input_buffer(params.x, vector_size(params.n, params.incx));
+    first_kernel->set_arg(2, buf_x);
+    first_kernel->set_arg(3, params.incx);
+    auto buf_y = engine->get_input_buffer(params.y, vector_size(params.n, params.incy));
+    first_kernel->set_arg(4, buf_y);
+    first_kernel->set_arg(5, params.incy);
+    first_kernel->set_options({ nd_range(blocks), nd_range(1) });
+
+    auto event = first_kernel->submit(dep_events);
+
+    // Second stage: sum of partial sums in fixed order
+    auto second_kernel = engine->get_kernel(second_kernel_name, [](const host_kernel_args& args, size_t, size_t)
+    {
+        auto result = args.buffer<float>(0);
+        auto block_sums = args.buffer<const float>(1);
+        auto blocks = args.scalar<size_t>(2);
+        float sum = 0.f;
+        for (size_t block = 0; block < blocks; ++block)
+            sum += block_sums[block];
+        *result = sum;
+    });
+
+    auto buf_result = engine->get_output_buffer(params.result, 1);
+    second_kernel->set_arg(0, buf_result);
+    second_kernel->set_arg(1, buf_block_sums);
+    second_kernel->set_arg(2, blocks);
+    second_kernel->set_options({ nd_range(1) });
+
+    return second_kernel->submit({ event });
+}
+
+} } } // namespace iclgpu::functions::implementations
@@ -0,0 +1,135 @@
+// Copyright (c) 2017-2018 Intel Corporation
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//      http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "functions/Sgemm.hpp"
+#include "host/host_engine.hpp"
+#include "../implementation_helpers.hpp"
+#include <algorithm>
+#include <vector>
+
+static const char* kernel_name = "Sgemm_host";
+
+namespace iclgpu { namespace functions { namespace implementations {
+
+// Block of A reused for all columns of C processed by a work item chunk: 128 x 256 floats fit in L2 cache
+static const std::ptrdiff_t row_block = 128;
+static const std::ptrdiff_t depth_block = 256;
+
+bool Sgemm_host::accept(const Sgemm::params& params, Sgemm::score& score)
+{
+    return true;
+}
+
+event Sgemm_host::execute(const Sgemm::params& params, const std::vector<event>& dep_events)
+{
+    auto engine = context()->get<host_engine>();
+    // Work items are columns of C
+    auto kernel = engine->get_kernel(kernel_name, [](const host_kernel_args& args, size_t begin, size_t end)
+    {
+        auto transa = args.scalar<int>(0);
+        auto transb = args.scalar<int>(1);
+        auto m = static_cast<std::ptrdiff_t>(args.scalar<int>(2));
+        auto k = static_cast<std::ptrdiff_t>(args.scalar<int>(4));
+        auto alpha = args.scalar<float>(5);
+        auto A = args.buffer<const float>(6);
+        auto lda = static_cast<std::ptrdiff_t>(args.scalar<int>(7));
+        auto B = args.buffer<const float>(8);
+        auto ldb = static_cast<std::ptrdiff_t>(args.scalar<int>(9));
+        auto beta = args.scalar<float>(10);
+        auto C = args.buffer<float>(11);
+        auto ldc = static_cast<std::ptrdiff_t>(args.scalar<int>(12));
+        const auto first = static_cast<std::ptrdiff_t>(begin);
+        const auto last = static_cast<std::ptrdiff_t>(end);
+
+        // alpha * op(B) columns of the chunk, contiguous
+        std::vector<float> b((last - first) * k);
+        for (auto j = first; j < last; ++j)
+        {
+            auto bj = b.data() + (j - first) * k;
+            for (std::ptrdiff_t l = 0; l < k; ++l)
+                bj[l] = alpha * (transb == 0 ? B[j * ldb + l] : B[l * ldb + j]);
+
+            // BLAS semantics: C is not read when beta is zero
+            auto c = C + j * ldc;
+            if (beta == 0.f)
+                std::fill(c, c + m, 0.f);
+            else if (beta != 1.f)
+                for (std::ptrdiff_t i = 0; i < m; ++i)
+                    c[i] *= beta;
+        }
+
+        if (transa == 0)
+        {
+            // C(:, j) += A(:, l) * b(l, j): axpy over contiguous columns of A
+            for (std::ptrdiff_t i0 = 0; i0 < m; i0 += row_block)
+            {
+                const auto i1 = std::min(i0 + row_block, m);
+                for (std::ptrdiff_t l0 = 0; l0 < k; l0 += depth_block)
+                {
+                    const auto l1 = std::min(l0 + depth_block, k);
+                    for (auto j = first; j < last; ++j)
+                    {
+                        auto bj = b.data() + (j - first) * k;
+                        auto c = C + j * ldc;
+                        for (auto l = l0; l < l1; ++l)
+                        {
+                            const float blj = bj[l];
+                            if (blj == 0.f)
+                                continue;
+                            auto a = A + l * lda;
+                            for (auto i = i0; i < i1; ++i)
+                                c[i] += blj * a[i];
+                        }
+                    }
+                }
+            }
+        }
+        else
+        {
+            // C(i, j) += A(:, i) . b(:, j): dot products of contiguous columns of A
+            for (std::ptrdiff_t i = 0; i < m; ++i)
+            {
+                auto a = A + i * lda;
+                for (auto j = first; j < last; ++j)
+                    C[j * ldc + i] += host_dot(a, b.data() + (j - first) * k, k);
+            }
+        }
+    });
+
+    const size_t a_cols = params.transa == 0 ? params.k : params.m;
+    const size_t b_cols = params.transb == 0 ? params.n : params.k;
+
+    kernel->set_arg(0, params.transa);
+    kernel->set_arg(1, params.transb);
+    kernel->set_arg(2, params.m);
+    kernel->set_arg(3, params.n);
+    kernel->set_arg(4, params.k);
+    kernel->set_arg(5, params.alpha);
+    auto buf_A = engine->get_input_buffer(params.A, params.lda * a_cols);
+    kernel->set_arg(6, buf_A);
+    kernel->set_arg(7, params.lda);
+    auto buf_B = engine->get_input_buffer(params.B, params.ldb * b_cols);
+    kernel->set_arg(8, buf_B);
+    kernel->set_arg(9, params.ldb);
+    kernel->set_arg(10, params.beta);
+    auto buf_C = engine->get_inout_buffer(params.C, static_cast<size_t>(params.ldc) * params.n);
+    kernel->set_arg(11, buf_C);
+    kernel->set_arg(12, params.ldc);
+
+    kernel->set_options({ nd_range(params.n) });
+
+    return kernel->submit(dep_events);
+}
+
+} } } // namespace iclgpu::functions::implementations
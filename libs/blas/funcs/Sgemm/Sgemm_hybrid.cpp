@@ -0,0 +1,193 @@
+// Copyright (c) 2017-2018 Intel Corporation
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//      http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "functions/Sgemm.hpp"
+#include "host/host_engine.hpp"
+#include "ocl/ocl_engine.hpp"
+#include "environment.hpp"
+
+#include "iclblas_common.h.cl"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace iclgpu { namespace functions { namespace implementations {
+
+// Columns of C are split between the device and the host in blocks of this size
+constexpr static const int column_block = 64;
+// The host part does not pay for itself on smaller matrices
+constexpr static const int hybrid_threshold = 1024;
+// Host share of C columns of a shape before the first measurement
+constexpr static const float initial_host_share = 0.25f;
+// Shape running on the device alone gives one column block to the host every this many calls
+constexpr static const int host_probe_interval = 16;
+
+/// Host share of C columns per Sgemm shape adapted to the measured throughput of the parts
+class Sgemm_hybrid_split : public context::element<Sgemm_hybrid_split>
+{
+public:
+    explicit Sgemm_hybrid_split(const std::shared_ptr<iclgpu::context>& ctx)
+        : element(ctx) {}
+
+    /// Number of the last columns of C computed on the host, the device part gets at least one column block
+    /// @details Shape with the host share below half of a block runs on the device alone. Every
+    /// host_probe_interval-th call of it still gives one block to the host, so the share can grow again.
+    int get_host_columns(const std::string& shape, int n)
+    {
+        const int blocks = n / column_block;
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto& split = _splits.emplace(shape, shape_split()).first->second;
+        int host_blocks = std::min(static_cast<int>(split.host_share * blocks + 0.5f), blocks - 1);
+        if (host_blocks == 0 && ++split.device_only_calls >= host_probe_interval)
+        {
+            split.device_only_calls = 0;
+            host_blocks = std::min(1, blocks - 1);
+        }
+        return host_blocks * column_block;
+    }
+
+    /// Moves the share half way to the one finishing both parts at the same time
+    void update(const std::string& shape, int device_columns, std::chrono::nanoseconds device_time,
+                int host_columns, std::chrono::nanoseconds host_time)
+    {
+        const auto device_rate = device_columns / std::max<double>(static_cast<double>(device_time.count()), 1.);
+        const auto host_rate = host_columns / std::max<double>(static_cast<double>(host_time.count()), 1.);
+        const auto balanced = static_cast<float>(host_rate / (host_rate + device_rate));
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto& share = _splits.emplace(shape, shape_split()).first->second.host_share;
+        share = (share + balanced) / 2;
+    }
+
+private:
+    struct shape_split
+    {
+        float host_share = initial_host_share;
+        int   device_only_calls = 0;
+    };
+
+    std::mutex _mutex;
+    std::unordered_map<std::string, shape_split> _splits;
+};
+
+/// Times of the parts of one call, the part completed last updates the split
+struct Sgemm_hybrid_measurement
+{
+    std::atomic<int>         pending{2};
+    std::chrono::nanoseconds device_time{0};
+    std::chrono::nanoseconds host_time{0};
+};
+
+/// The host part pays off where the device shares memory with the host (integrated GPU, CPU device),
+/// @b ICLGPU_SGEMM_HYBRID=1 enables it for other devices, @b ICLGPU_SGEMM_HYBRID=0 disables it
+static bool is_enabled(const std::shared_ptr<iclgpu::context>& ctx)
+{
+    std::string value;
+    if (get_environment_variable("ICLGPU_SGEMM_HYBRID", value))
+        return value != "0";
+    auto ocl = std::dynamic_pointer_cast<ocl_engine>(ctx->get_engine());
+    return ocl && ocl->is_host_memory_shared();
+}
+
+/// The host part reads user data in place and runs on submission, so device memory and capture are not supported
+static bool is_splittable(const std::shared_ptr<iclgpu::context>& ctx, const Sgemm::params& params)
+{
+    return !params.A.get()->get_owning_engine()
+        && !params.B.get()->get_owning_engine()
+        && !params.C.get()->get_owning_engine()
+        && !ctx->get_engine()->is_capturing();
+}
+
+bool Sgemm_hybrid::accept(const Sgemm::params& params, Sgemm::score& score)
+{
+    if (params.transa != ICLBLAS_OP_N || params.transb != ICLBLAS_OP_N)
+        return false;
+    if (params.m < hybrid_threshold || params.n < hybrid_threshold || params.k < hybrid_threshold)
+        return false;
+    if (!is_splittable(context(), params) || context()->get<host_engine>()->concurrency() < 2)
+        return false;
+    if (!is_enabled(context()))
+        return false;
+
+    // Preferred to Sgemm_n3_sg_ntransAB used for the device part
+    score.transa = 1.50f;
+    score.transb = 1.50f;
+    score.n = 1.20f;
+    return true;
+}
+
+event Sgemm_hybrid::execute(const Sgemm::params& params, const std::vector<event>& dep_events)
+{
+    // Selection is memoized by the parameters key, so the device part alone runs calls the split cannot handle
+    auto device_impl = context()->get<Sgemm_n3_sg_ntransAB>();
+    if (!is_splittable(context(), params))
+        return device_impl->execute(params, dep_events);
+
+    auto split = context()->get<Sgemm_hybrid_split>();
+    const auto shape = Sgemm::shape(params);
+    const int host_n = split->get_host_columns(shape, params.n);
+    if (host_n == 0)
+        return device_impl->execute(params, dep_events);
+    const int device_n = params.n - host_n;
+
+    // Parts get own bindings: buffers are created by both engines concurrently
+    float* A = params.A;
+    float* B = params.B;
+    float* C = params.C;
+    const size_t a_size = static_cast<size_t>(params.lda) * params.k;
+    const size_t b_offset = static_cast<size_t>(params.ldb) * device_n;
+    const size_t c_offset = static_cast<size_t>(params.ldc) * device_n;
+
+    auto device_params = params;
+    device_params.n = device_n;
+    device_params.A = { A, a_size };
+    device_params.B = { B, b_offset };
+    device_params.C = { C, c_offset };
+
+    auto host_params = params;
+    host_params.n = host_n;
+    host_params.A = { A, a_size };
+    host_params.B = { B + b_offset, static_cast<size_t>(params.ldb) * host_n };
+    host_params.C = { C + c_offset, static_cast<size_t>(params.ldc) * host_n };
+
+    // Completion of the device part is timed by the event callback, so the call does not wait for it
+    auto measurement = std::make_shared<Sgemm_hybrid_measurement>();
+    auto apply = [split, shape, device_n, host_n, measurement]()
+    {
+        split->update(shape, device_n, measurement->device_time, host_n, measurement->host_time);
+    };
+
+    const auto start = std::chrono::steady_clock::now();
+    auto device_event = device_impl->execute(device_params, dep_events);
+    device_event->on_completion([start, measurement, apply]()
+    {
+        measurement->device_time = std::chrono::steady_clock::now() - start;
+        if (--measurement->pending == 0)
+            apply();
+    });
+
+    // This thread takes part in the host part, which is completed on return
+    context()->get<Sgemm_host>()->execute(host_params, dep_events);
+    measurement->host_time = std::chrono::steady_clock::now() - start;
+    if (--measurement->pending == 0)
+        apply();
+
+    return device_event;
+}
+
+} } } // namespace iclgpu::functions::implementations
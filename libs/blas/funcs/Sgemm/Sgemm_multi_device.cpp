@@ -0,0 +1,89 @@
+// Copyright (c) 2017-2018 Intel Corporation
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//      http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "functions/Sgemm.hpp"
+#include "device_group.hpp"
+
+#include "iclblas_common.h.cl"
+
+namespace iclgpu { namespace functions { namespace implementations {
+
+// Every device gets at least this many columns of C
+constexpr static const int panel_width = 128;
+// Smaller products do not pay for the transfers to several devices
+constexpr static const int multi_device_threshold = 256;
+
+/// Devices do not share buffers, so parts read and write user data in place and capture is not supported
+static bool is_distributable(const std::shared_ptr<iclgpu::context>& ctx, const Sgemm::params& params)
+{
+    return !params.A.get()->get_owning_engine()
+        && !params.B.get()->get_owning_engine()
+        && !params.C.get()->get_owning_engine()
+        && !ctx->get_engine()->is_capturing()
+        && ctx->get<device_group>()->size() > 1;
+}
+
+bool Sgemm_multi_device::accept(const Sgemm::params& params, Sgemm::score& score)
+{
+    if (params.m < multi_device_threshold || params.k < multi_device_threshold)
+        return false;
+    if (!is_distributable(context(), params))
+        return false;
+    if (params.n < panel_width * static_cast<int>(context()->get<device_group>()->size()))
+        return false;
+
+    // Preferred to the single device implementations which compute the parts
+    score.transa = 1.60f;
+    score.transb = 1.60f;
+    score.n = 1.30f;
+    return true;
+}
+
+event Sgemm_multi_device::execute(const Sgemm::params& params, const std::vector<event>& dep_events)
+{
+    auto group = context()->get<device_group>();
+    std::vector<size_t> parts(1, params.n);
+    // Selection is memoized by the parameters key, so the context device alone runs calls which cannot be split
+    if (is_distributable(context(), params))
+        parts = group->split(params.n, panel_width);
+
+    float* A = params.A;
+    float* B = params.B;
+    float* C = params.C;
+    const size_t a_size = static_cast<size_t>(params.lda) * (params.transa == ICLBLAS_OP_N ? params.k : params.m);
+
+    // Members get column panels of C and matching columns of op(B), A is read by all of them
+    std::vector<event> events;
+    size_t column = 0;
+    for (size_t i = 0; i < parts.size(); ++i)
+    {
+        if (parts[i] == 0)
+            continue;
+        const auto columns = static_cast<int>(parts[i]);
+        auto part = params;
+        part.n = columns;
+        part.A = { A, a_size };
+        if (params.transb == ICLBLAS_OP_N)
+            part.B = { B + params.ldb * column, static_cast<size_t>(params.ldb) * columns };
+        else
+            part.B = { B + column, static_cast<size_t>(params.ldb) * (params.k - 1) + columns };
+        part.C = { C + params.ldc * column, static_cast<size_t>(params.ldc) * columns };
+        events.push_back(group->execute_part<Sgemm>(i, part, dep_events, this));
+        column += parts[i];
+    }
+
+    return std::make_shared<event_group>(context()->get_engine(), events);
+}
+
+} } } // namespace iclgpu::functions::implementations
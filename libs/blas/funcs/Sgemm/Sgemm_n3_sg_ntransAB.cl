@@ -22,10 +22,19 @@
 #define TARG_MATRIX_FMT_A   C
 #define TARG_MATRIX_FMT_B   C
 
-#define TARG_TILE_M    16
-#define TARG_TILE_N     8
-#define TARG_TILE_AK   16
-#define TARG_TILE_BK   16
+// Tile sizes can be overridden by build options (see Sgemm_n3_sg_ntransAB.cpp)
+#ifndef TARG_TILE_M
+    #define TARG_TILE_M    16
+#endif
+#ifndef TARG_TILE_N
+    #define TARG_TILE_N     8
+#endif
+#ifndef TARG_TILE_AK
+    #define TARG_TILE_AK   16
+#endif
+#ifndef TARG_TILE_BK
+    #define TARG_TILE_BK   16
+#endif
 
 #define TARG_TILE_IDX_GDIM_M   0
 #define TARG_TILE_IDX_GDIM_N   1
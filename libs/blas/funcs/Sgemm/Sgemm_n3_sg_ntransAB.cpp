@@ -19,6 +19,7 @@
 
 #define TARG_SG_SIZE   16
 
+// Default tile sizes of the kernel
 #define TARG_TILE_M    16
 #define TARG_TILE_N     8
 #define TARG_TILE_AK   16
@@ -26,6 +27,15 @@
 
 constexpr static const int opt_threshold = 4;
 
+// Wider tiles in n dimension load tiles of A half as many times, large matrices keep the device busy anyway
+constexpr static const int wide_tile_n = 16;
+constexpr static const int wide_tile_threshold = 512;
+
+static int select_tile_n(const iclgpu::functions::Sgemm::params& params)
+{
+    return params.m >= wide_tile_threshold && params.n >= wide_tile_threshold ? wide_tile_n : TARG_TILE_N;
+}
+
 
 static const char* module_name = "Sgemm_n3_sg_ntransAB";
 static const char* kernel_name = "Sgemm_n3_sg_ntransAB";
@@ -52,9 +62,14 @@ bool Sgemm_n3_sg_ntransAB::accept(const Sgemm::params& params, Sgemm::score& sco
 
 event Sgemm_n3_sg_ntransAB::execute(const Sgemm::params& params, const std::vector<event>& dep_events)
 {
+    const int tile_n = select_tile_n(params);
+    kernel_defines defines;
+    if (tile_n != TARG_TILE_N)
+        defines["TARG_TILE_N"] = std::to_string(tile_n);
+
     auto engine = context()->get_engine();
-    auto kernel = engine->get_kernel(kernel_name, module_name);
-    
+    auto kernel = engine->get_kernel(kernel_name, module_name, defines);
+
     const size_t a_buf_size = params.k * params.lda;
     const size_t b_buf_size = params.n * params.ldb;
     const size_t c_buf_size = params.n * params.ldc;
@@ -76,7 +91,7 @@ event Sgemm_n3_sg_ntransAB::execute(const Sgemm::params& params, const std::vect
     kernel->set_arg(10, params.ldc);
 
     const size_t tile_cnt_m = (static_cast<size_t>(params.m) + TARG_TILE_M - 1) / TARG_TILE_M;
-    const size_t tile_cnt_n = (static_cast<size_t>(params.n) + TARG_TILE_N - 1) / TARG_TILE_N;
+    const size_t tile_cnt_n = (static_cast<size_t>(params.n) + tile_n - 1) / tile_n;
 
     auto gws = nd_range(TARG_SG_SIZE * tile_cnt_m, tile_cnt_n);
     auto lws = nd_range(TARG_SG_SIZE, 1);
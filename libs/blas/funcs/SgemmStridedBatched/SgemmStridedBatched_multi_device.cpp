@@ -0,0 +1,91 @@
+// Copyright (c) 2017-2018 Intel Corporation
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//      http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "functions/SgemmStridedBatched.hpp"
+#include "device_group.hpp"
+
+#include "iclblas_common.h.cl"
+
+namespace iclgpu { namespace functions { namespace implementations {
+
+// Smaller batches do not pay for the transfers to several devices
+constexpr static const int64_t multi_device_threshold = int64_t(1) << 24;
+
+/// Devices do not share buffers, so parts read and write user data in place and capture is not supported
+static bool is_distributable(const std::shared_ptr<iclgpu::context>& ctx, const SgemmStridedBatched::params& params)
+{
+    return !params.A.get()->get_owning_engine()
+        && !params.B.get()->get_owning_engine()
+        && !params.C.get()->get_owning_engine()
+        && !ctx->get_engine()->is_capturing()
+        && ctx->get<device_group>()->size() > 1;
+}
+
+bool SgemmStridedBatched_multi_device::accept(const SgemmStridedBatched::params& params,
+                                              SgemmStridedBatched::score& score)
+{
+    if (params.m <= 0 || params.n <= 0 || params.k <= 0)
+        return false;
+    if (int64_t(params.m) * params.n * params.k * params.batchCount < multi_device_threshold)
+        return false;
+    // Parts write C of different batches concurrently, so the matrices must not overlap
+    if (params.strideC < int64_t(params.ldc) * params.n)
+        return false;
+    if (!is_distributable(context(), params))
+        return false;
+    if (params.batchCount < static_cast<int>(context()->get<device_group>()->size()))
+        return false;
+
+    // Preferred to the single device implementations which compute the parts
+    score.batchCount = 1.50f;
+    return true;
+}
+
+event SgemmStridedBatched_multi_device::execute(const SgemmStridedBatched::params& params,
+                                                const std::vector<event>& dep_events)
+{
+    auto group = context()->get<device_group>();
+    std::vector<size_t> parts(1, params.batchCount);
+    // Selection is memoized by the parameters key, so the context device alone runs calls which cannot be split
+    if (is_distributable(context(), params))
+        parts = group->split(params.batchCount);
+
+    float* A = params.A;
+    float* B = params.B;
+    float* C = params.C;
+    const size_t a_matrix = static_cast<size_t>(params.lda) * (params.transa == ICLBLAS_OP_N ? params.k : params.m);
+    const size_t b_matrix = static_cast<size_t>(params.ldb) * (params.transb == ICLBLAS_OP_N ? params.n : params.k);
+    const size_t c_matrix = static_cast<size_t>(params.ldc) * params.n;
+
+    // Members get consecutive batches
+    std::vector<event> events;
+    size_t first = 0;
+    for (size_t i = 0; i < parts.size(); ++i)
+    {
+        if (parts[i] == 0)
+            continue;
+        const size_t last = parts[i] - 1;
+        auto part = params;
+        part.batchCount = static_cast<int>(parts[i]);
+        part.A = { A + first * params.strideA, last * params.strideA + a_matrix };
+        part.B = { B + first * params.strideB, last * params.strideB + b_matrix };
+        part.C = { C + first * params.strideC, last * params.strideC + c_matrix };
+        events.push_back(group->execute_part<SgemmStridedBatched>(i, part, dep_events, this));
+        first += parts[i];
+    }
+
+    return std::make_shared<event_group>(context()->get_engine(), events);
+}
+
+} } } // namespace iclgpu::functions::implementations
@@ -0,0 +1,41 @@
+/* Copyright (c) 2017-2018 Intel Corporation
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+__kernel void SgemmStridedBatched_naive(int transa, int transb, int m, int n, int k, float alpha,
+                                        __global float* A, int lda, long strideA,
+                                        __global float* B, int ldb, long strideB, float beta,
+                                        __global float* C, int ldc, long strideC)
+{
+    const int i = get_global_id(0);
+    const int j = get_global_id(1);
+    const long batch = get_global_id(2);
+
+    A += batch * strideA;
+    B += batch * strideB;
+    C += batch * strideC;
+
+    float value = 0.f;
+    for (int l = 0; l < k; l++)
+    {
+        const float a = transa == 0 ? A[l * lda + i] : A[i * lda + l];
+        const float b = transb == 0 ? B[j * ldb + l] : B[l * ldb + j];
+        value += a * b;
+    }
+
+    if (beta == 0.f)
+        C[j * ldc + i] = alpha * value;
+    else
+        C[j * ldc + i] = alpha * value + beta * C[j * ldc + i];
+}
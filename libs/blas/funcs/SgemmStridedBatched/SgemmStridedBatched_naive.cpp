@@ -0,0 +1,67 @@
+// Copyright (c) 2017-2018 Intel Corporation
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//      http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "functions/SgemmStridedBatched.hpp"
+
+static const char* module_name = "SgemmStridedBatched_naive";
+static const char* kernel_name = "SgemmStridedBatched_naive";
+
+namespace iclgpu { namespace functions { namespace implementations {
+
+bool SgemmStridedBatched_naive::accept(const SgemmStridedBatched::params& params, SgemmStridedBatched::score& score)
+{
+    return true;
+}
+
+event SgemmStridedBatched_naive::execute(const SgemmStridedBatched::params& params, const std::vector<event>& dep_events)
+{
+    auto engine = context()->get_engine();
+    auto kernel = engine->get_kernel(kernel_name, module_name);
+
+    const size_t last = params.batchCount - 1;
+    const size_t a_buf_size = last * params.strideA + params.lda * (params.transa == 0 ? params.k : params.m);
+    const size_t b_buf_size = last * params.strideB + params.ldb * (params.transb == 0 ? params.n : params.k);
+    const size_t c_buf_size = last * params.strideC + params.ldc * params.n;
+
+    kernel->set_arg(0, params.transa);
+    kernel->set_arg(1, params.transb);
+    kernel->set_arg(2, params.m);
+    kernel->set_arg(3, params.n);
+    kernel->set_arg(4, params.k);
+    kernel->set_arg(5, params.alpha);
+    auto buf_A = engine->get_input_buffer(params.A, a_buf_size);
+    kernel->set_arg(6, buf_A);
+    kernel->set_arg(7, params.lda);
+    kernel->set_arg(8, params.strideA);
+    auto buf_B = engine->get_input_buffer(params.B, b_buf_size);
+    kernel->set_arg(9, buf_B);
+    kernel->set_arg(10, params.ldb);
+    kernel->set_arg(11, params.strideB);
+    kernel->set_arg(12, params.beta);
+    auto buf_C = engine->get_inout_buffer(params.C, c_buf_size);
+    kernel->set_arg(13, buf_C);
+    kernel->set_arg(14, params.ldc);
+    kernel->set_arg(15, params.strideC);
+
+    // Every work-item computes single element of C, batch index is the last dimension
+    auto gws = nd_range(params.m, params.n, params.batchCount);
+    auto lws = null_range;
+
+    kernel->set_options({ gws, lws });
+
+    return kernel->submit(dep_events);
+}
+
+} } } // namespace iclgpu::functions::implementations
@@ -0,0 +1,113 @@
+// Copyright (c) 2017-2018 Intel Corporation
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//      http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "functions/Sgemv.hpp"
+#include "host/host_engine.hpp"
+#include "../implementation_helpers.hpp"
+#include <vector>
+
+static const char* kernel_name = "Sgemv_host";
+
+namespace iclgpu { namespace functions { namespace implementations {
+
+bool Sgemv_host::accept(const Sgemv::params& params, Sgemv::score& score)
+{
+    return true;
+}
+
+event Sgemv_host::execute(const Sgemv::params& params, const std::vector<event>& dep_events)
+{
+    auto engine = context()->get<host_engine>();
+    // Work items are elements of y: rows of A without transposition, columns of A otherwise
+    auto kernel = engine->get_kernel(kernel_name, [](const host_kernel_args& args, size_t begin, size_t end)
+    {
+        auto trans = args.scalar<int>(0);
+        auto m = args.scalar<int>(1);
+        auto n = args.scalar<int>(2);
+        auto alpha = args.scalar<float>(3);
+        auto A = args.buffer<const float>(4);
+        auto lda = static_cast<std::ptrdiff_t>(args.scalar<int>(5));
+        auto incx = args.scalar<int>(7);
+        auto beta = args.scalar<float>(8);
+        auto incy = args.scalar<int>(10);
+        const bool ntrans = trans == 0;
+        const int x_size = ntrans ? n : m;
+        const int y_size = ntrans ? m : n;
+        auto x = args.buffer<const float>(6) + first_element(x_size, incx);
+        auto y = args.buffer<float>(9) + first_element(y_size, incy);
+
+        // op(A)*x of the rows [begin, end) accumulated contiguously
+        const auto rows = end - begin;
+        std::vector<float> acc(rows, 0.f);
+        if (ntrans)
+        {
+            for (std::ptrdiff_t j = 0; j < n; ++j)
+            {
+                const float xj = x[j * incx];
+                if (xj == 0.f)
+                    continue;
+                auto a = A + j * lda + begin;
+                for (size_t r = 0; r < rows; ++r)
+                    acc[r] += xj * a[r];
+            }
+        }
+        else if (incx == 1)
+        {
+            for (size_t r = 0; r < rows; ++r)
+                acc[r] = host_dot(A + (begin + r) * lda, x, m);
+        }
+        else
+        {
+            for (size_t r = 0; r < rows; ++r)
+            {
+                auto a = A + (begin + r) * lda;
+                float sum = 0.f;
+                for (std::ptrdiff_t i = 0; i < m; ++i)
+                    sum += a[i] * x[i * incx];
+                acc[r] = sum;
+            }
+        }
+
+        for (size_t r = 0; r < rows; ++r)
+        {
+            auto& yi = y[static_cast<std::ptrdiff_t>(begin + r) * incy];
+            // BLAS semantics: y is not read when beta is zero
+            yi = beta == 0.f ? alpha * acc[r] : alpha * acc[r] + beta * yi;
+        }
+    });
+
+    const int x_size = params.trans == 0 ? params.n : params.m;
+    const int y_size = params.trans == 0 ? params.m : params.n;
+
+    kernel->set_arg(0, params.trans);
+    kernel->set_arg(1, params.m);
+    kernel->set_arg(2, params.n);
+    kernel->set_arg(3, params.alpha);
+    auto buf_A = engine->get_input_buffer(params.A, static_cast<size_t>(params.lda) * params.n);
+    kernel->set_arg(4, buf_A);
+    kernel->set_arg(5, params.lda);
+    auto buf_x = engine->get_input_buffer(params.x, vector_size(x_size, params.incx));
+    kernel->set_arg(6, buf_x);
+    kernel->set_arg(7, params.incx);
+    kernel->set_arg(8, params.beta);
+    auto buf_y = engine->get_inout_buffer(params.y, vector_size(y_size, params.incy));
+    kernel->set_arg(9, buf_y);
+    kernel->set_arg(10, params.incy);
+
+    kernel->set_options({ nd_range(y_size), nd_range(params.trans == 0 ? 64 : 4) });
+
+    return kernel->submit(dep_events);
+}
+
+} } } // namespace iclgpu::functions::implementations
@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include "specialization.h"
+
 #define MAT_ACCESS(A, col, row, n) A[col * n + row]
 
 #define SIMD_WIDTH 16
@@ -31,15 +33,15 @@ __kernel void Sgemv_opt_simd16(uint trans, uint m, uint n, float alpha, __global
     float subgr_acc;
 
     for (uint col_loop_id = col_id; col_loop_id < n; col_loop_id += SIMD_WIDTH)
-        thread_res = fma(MAT_ACCESS(A, col_loop_id, row_id, lda), x[col_loop_id * incx], thread_res);
+        thread_res = fma(MAT_ACCESS(A, col_loop_id, row_id, lda), x[col_loop_id * SPEC_incx], thread_res);
 
     subgr_acc = sub_group_reduce_add(thread_res);
 
     if(col_id == 0)
     {   
-        if(beta != 0)
-            y[row_id * incy] = fma(beta, y[row_id * incy], alpha * subgr_acc);
+        if(SPEC_beta != 0)
+            y[row_id * SPEC_incy] = fma(SPEC_beta, y[row_id * SPEC_incy], SPEC_alpha * subgr_acc);
         else
-            y[row_id * incy] = alpha * subgr_acc;
+            y[row_id * SPEC_incy] = SPEC_alpha * subgr_acc;
     }
 }
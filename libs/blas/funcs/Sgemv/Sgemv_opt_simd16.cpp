@@ -41,7 +41,12 @@ bool Sgemv_opt_simd16::accept(const Sgemv::params& params, Sgemv::score& score)
 event Sgemv_opt_simd16::execute(const Sgemv::params& params, const std::vector<event>& dep_events)
 {
     auto engine = context()->get_engine();
-    auto kernel = engine->get_kernel(kernel_name, module_name);
+    auto kernel = engine->get_specialized_kernel(kernel_name, module_name, specialization()
+                                                 .add("alpha", params.alpha)
+                                                 .add("beta", params.beta)
+                                                 .add("incx", params.incx)
+                                                 .add("incy", params.incy)
+                                                 .defines());
 
     size_t buf_matrix_size = params.lda * params.n;
     size_t buf_vector_x = params.incx;
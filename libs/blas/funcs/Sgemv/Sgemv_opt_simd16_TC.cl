@@ -14,7 +14,10 @@
 
 #define MAT_ACCESS(A, col, row, n) A[col * n + row]
 
-#define SIMD_WIDTH 16
+// Sub-group size can be overridden by build options (see Sgemv_opt_simd16_TC.cpp)
+#ifndef SIMD_WIDTH
+    #define SIMD_WIDTH 16
+#endif
 
 /* We're lunching 1 thread for every row. Then in one row, we use 16 threads, where one thread
 /* calculate element n, n+SIMD_WIDTH and so on. Then they're added using sub_group_reduce_add.
@@ -20,8 +20,12 @@ static const char* kernel_name = "Sgemv_opt_simd16_TC";
 #define ICLBLAS_OP_T (1)
 #define ICLBLAS_OP_C (2)
 
+// Default sub-group size of the kernel
 #define SIMD_WIDTH 16
 
+// Short rows leave less lanes idle in the last iteration with narrow sub-groups
+constexpr static const int narrow_simd_width = 8;
+
 namespace iclgpu { namespace functions { namespace implementations {
 
 bool Sgemv_opt_simd16_TC::accept(const Sgemv::params& params, Sgemv::score& score)
@@ -40,8 +44,13 @@ bool Sgemv_opt_simd16_TC::accept(const Sgemv::params& params, Sgemv::score& scor
 
 event Sgemv_opt_simd16_TC::execute(const Sgemv::params& params, const std::vector<event>& dep_events)
 {
+    const int simd_width = params.m < 2 * SIMD_WIDTH ? narrow_simd_width : SIMD_WIDTH;
+    kernel_defines defines;
+    if (simd_width != SIMD_WIDTH)
+        defines["SIMD_WIDTH"] = std::to_string(simd_width);
+
     auto engine = context()->get_engine();
-    auto kernel = engine->get_kernel(kernel_name, module_name);
+    auto kernel = engine->get_kernel(kernel_name, module_name, defines);
 
     size_t buf_matrix_size = params.lda * params.n;
     size_t buf_vector_x = params.incx;
@@ -67,8 +76,8 @@ event Sgemv_opt_simd16_TC::execute(const Sgemv::params& params, const std::vecto
     kernel->set_arg(9, buf_y);
     kernel->set_arg(10, params.incy);
 
-    nd_range gws(params.n, SIMD_WIDTH);
-    nd_range lws(1, SIMD_WIDTH);
+    nd_range gws(params.n, simd_width);
+    nd_range lws(1, simd_width);
 
     kernel->set_options({ gws, lws });
 
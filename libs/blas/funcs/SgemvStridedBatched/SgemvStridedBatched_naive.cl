@@ -0,0 +1,49 @@
+/* Copyright (c) 2017-2018 Intel Corporation
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define MAT_ACCESS(A, row, col, N) A[col*N + row]
+
+#define ICLBLAS_OP_N (0)
+
+// One work-item computes one element of y, dimension 1 selects the problem in batch.
+__kernel void SgemvStridedBatched_naive(int trans, int m, int n, float alpha, __global float* A, int lda, ulong stride_a,
+                                        __global float* x, int incx, ulong stride_x, float beta,
+                                        __global float* y, int incy, ulong stride_y)
+{
+    const uint row_id = get_global_id(0);
+    const size_t batch_id = get_global_id(1);
+    A += batch_id * stride_a;
+    x += batch_id * stride_x;
+    y += batch_id * stride_y;
+
+    float l_result = 0;
+    /* For non-transpose matrix A*/
+    if (trans == ICLBLAS_OP_N)
+    {
+        for (uint col_id = 0; col_id < n; ++col_id)
+            l_result = mad(MAT_ACCESS(A, row_id, col_id, lda), x[col_id * incx], l_result);
+    }
+    /* For (conj.)-transpose matrix A*/
+    else
+    {
+        for (uint col_id = 0; col_id < m; ++col_id)
+            l_result = mad(MAT_ACCESS(A, col_id, row_id, lda), x[col_id * incx], l_result);
+    }
+
+    if (beta != 0)
+        y[row_id * incy] = fma(beta, y[row_id * incy], alpha * l_result);
+    else
+        y[row_id * incy] = alpha * l_result;
+}
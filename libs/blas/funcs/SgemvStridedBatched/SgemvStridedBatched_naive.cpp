@@ -0,0 +1,70 @@
+// Copyright (c) 2017-2018 Intel Corporation
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//      http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "functions/SgemvStridedBatched.hpp"
+
+static const char* module_name = "SgemvStridedBatched_naive";
+static const char* kernel_name = "SgemvStridedBatched_naive";
+
+#define ICLBLAS_OP_N (0)
+
+namespace iclgpu { namespace functions { namespace implementations {
+
+bool SgemvStridedBatched_naive::accept(const SgemvStridedBatched::params& params, SgemvStridedBatched::score& score)
+{
+    return true;
+}
+
+event SgemvStridedBatched_naive::execute(const SgemvStridedBatched::params& params, const std::vector<event>& dep_events)
+{
+    auto engine = context()->get_engine();
+    auto kernel = engine->get_kernel(kernel_name, module_name);
+
+    const bool ntrans = params.trans == ICLBLAS_OP_N;
+    const int len_x = ntrans ? params.n : params.m;
+    const int len_y = ntrans ? params.m : params.n;
+
+    const size_t last = params.batchCount - 1;
+    size_t buf_matrix_size = last * params.strideA + params.lda * params.n;
+    size_t buf_vector_x = last * params.stridex + len_x * params.incx;
+    size_t buf_vector_y = last * params.stridey + len_y * params.incy;
+
+    kernel->set_arg(0, params.trans);
+    kernel->set_arg(1, params.m);
+    kernel->set_arg(2, params.n);
+    kernel->set_arg(3, params.alpha);
+    auto buf_A = engine->get_input_buffer(params.A, buf_matrix_size);
+    kernel->set_arg(4, buf_A);
+    kernel->set_arg(5, params.lda);
+    kernel->set_arg(6, static_cast<uint64_t>(params.strideA));
+    auto buf_x = engine->get_input_buffer(params.x, buf_vector_x);
+    kernel->set_arg(7, buf_x);
+    kernel->set_arg(8, params.incx);
+    kernel->set_arg(9, static_cast<uint64_t>(params.stridex));
+    kernel->set_arg(10, params.beta);
+    auto buf_y = engine->get_inout_buffer(params.y, buf_vector_y);
+    kernel->set_arg(11, buf_y);
+    kernel->set_arg(12, params.incy);
+    kernel->set_arg(13, static_cast<uint64_t>(params.stridey));
+
+    nd_range gws(len_y, params.batchCount);
+    auto lws = null_range;
+
+    kernel->set_options({ gws, lws });
+
+    return kernel->submit(dep_events);
+}
+
+} } } // namespace iclgpu::functions::implementations
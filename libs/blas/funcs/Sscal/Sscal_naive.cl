@@ -13,8 +13,10 @@
  * limitations under the License.
  */
 
+#include "specialization.h"
+
 __kernel void Sscal_naive(float alpha, __global float* x, uint incx)
 {
    const uint gid = get_global_id(0);
-   x[gid * incx] *= alpha;
+   x[gid * SPEC_incx] *= SPEC_alpha;
 }
@@ -29,7 +29,10 @@ bool Sscal_naive::accept(const Sscal::params & params, Sscal::score & score)
 event Sscal_naive::execute(const Sscal::params & params, const std::vector<event>& dep_events)
 {
     auto engine = context()->get_engine();
-    auto kernel = engine->get_kernel(kernel_name, module_name);
+    auto kernel = engine->get_specialized_kernel(kernel_name, module_name, specialization()
+                                                 .add("alpha", params.alpha)
+                                                 .add("incx", params.incx)
+                                                 .defines());
     auto buf_size = params.n * params.incx;
 
     kernel->set_arg(0, params.alpha);
@@ -42,7 +42,7 @@ event Stpmv_naive::execute(const Stpmv::params& params, const std::vector<event>
     kernel->set_arg(5, buf_x);
     kernel->set_arg(6, params.incx);
     
-    auto buf_parties = engine->get_temp_buffer(params.n * sizeof(float));
+    auto buf_parties = engine->get_temp_buffer(params.n * sizeof(float), buffer_init::zero);
     kernel->set_arg(7, buf_parties);
 
 
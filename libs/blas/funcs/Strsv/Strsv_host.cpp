@@ -0,0 +1,117 @@
+// Copyright (c) 2017-2018 Intel Corporation
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//      http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "functions/Strsv.hpp"
+#include "host/host_engine.hpp"
+#include "../implementation_helpers.hpp"
+
+static const char* kernel_name = "Strsv_host";
+
+namespace iclgpu { namespace functions { namespace implementations {
+
+bool Strsv_host::accept(const Strsv::params& params, Strsv::score& score)
+{
+    return true;
+}
+
+event Strsv_host::execute(const Strsv::params& params, const std::vector<event>& dep_events)
+{
+    auto engine = context()->get<host_engine>();
+    // Substitution is sequential: single work item, columns of A are accessed contiguously
+    auto kernel = engine->get_kernel(kernel_name, [](const host_kernel_args& args, size_t, size_t)
+    {
+        auto uplo = args.scalar<int>(0);
+        auto trans = args.scalar<int>(1);
+        auto diag = args.scalar<int>(2);
+        auto n = args.scalar<int>(3);
+        auto A = args.buffer<const float>(4);
+        auto lda = static_cast<std::ptrdiff_t>(args.scalar<int>(5));
+        auto incx = args.scalar<int>(7);
+        auto x = args.buffer<float>(6) + first_element(n, incx);
+
+        const bool ntrans = trans == 0;
+        const bool lower = uplo == 1;
+        const bool unit = diag != 0;
+        auto X = [&](std::ptrdiff_t i) -> float& { return x[i * incx]; };
+        auto column = [&](std::ptrdiff_t j) { return A + j * lda; };
+
+        if (ntrans)
+        {
+            // Column oriented: solved x[j] updates the rest of x with column j
+            const std::ptrdiff_t first = lower ? 0 : n - 1;
+            const std::ptrdiff_t step = lower ? 1 : -1;
+            for (std::ptrdiff_t j = first; j >= 0 && j < n; j += step)
+            {
+                auto a = column(j);
+                if (!unit)
+                    X(j) /= a[j];
+                const float temp = X(j);
+                if (temp == 0.f)
+                    continue;
+                if (lower)
+                {
+                    for (std::ptrdiff_t i = j + 1; i < n; ++i)
+                        X(i) -= temp * a[i];
+                }
+                else
+                {
+                    for (std::ptrdiff_t i = 0; i < j; ++i)
+                        X(i) -= temp * a[i];
+                }
+            }
+        }
+        else
+        {
+            // Row oriented over op(A) = columns of A: x[j] is a dot product of column j and solved x
+            const std::ptrdiff_t first = lower ? n - 1 : 0;
+            const std::ptrdiff_t step = lower ? -1 : 1;
+            for (std::ptrdiff_t j = first; j >= 0 && j < n; j += step)
+            {
+                auto a = column(j);
+                float temp = X(j);
+                const std::ptrdiff_t begin = lower ? j + 1 : 0;
+                const std::ptrdiff_t end = lower ? n : j;
+                if (incx == 1)
+                {
+                    temp -= host_dot(a + begin, x + begin, end - begin);
+                }
+                else
+                {
+                    for (std::ptrdiff_t i = begin; i < end; ++i)
+                        temp -= a[i] * X(i);
+                }
+                if (!unit)
+                    temp /= a[j];
+                X(j) = temp;
+            }
+        }
+    });
+
+    kernel->set_arg(0, params.uplo);
+    kernel->set_arg(1, params.trans);
+    kernel->set_arg(2, params.diag);
+    kernel->set_arg(3, params.n);
+    auto buf_A = engine->get_input_buffer(params.A, static_cast<size_t>(params.lda) * params.n);
+    kernel->set_arg(4, buf_A);
+    kernel->set_arg(5, params.lda);
+    auto buf_x = engine->get_inout_buffer(params.x, vector_size(params.n, params.incx));
+    kernel->set_arg(6, buf_x);
+    kernel->set_arg(7, params.incx);
+
+    kernel->set_options({ nd_range(1) });
+
+    return kernel->submit(dep_events);
+}
+
+} } } // namespace iclgpu::functions::implementations
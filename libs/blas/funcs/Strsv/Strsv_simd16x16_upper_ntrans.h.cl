@@ -19,6 +19,8 @@
 // SUB_GROUPS - number of sub groups in work group
 // NOINCX - increment between values in x is equal 1
 // NOINCX_ALIGNED - same as NOINCX + pointer to x is aligned to 16B
+// BATCHED - work-group with index i in dimension 1 solves problem with A and x at i * stride_a and i * stride_x
+// KERNEL_NAME - name of the kernel
 
 #ifndef VEC_SIZE
 #define VEC_SIZE 1
@@ -32,6 +34,10 @@
 #define SUB_GROUPS 16
 #endif
 
+#ifndef KERNEL_NAME
+#define KERNEL_NAME Strsv_simd16x16_upper_ntrans
+#endif
+
 #if defined(NOINCX_ALIGNED) && !defined(NOINCX)
 #define NOINCX
 #endif
@@ -56,8 +62,17 @@
 // Then situation repeats in previous column, all threads move by BLOCK_WIDTH to the left.
 __attribute__((intel_reqd_sub_group_size(SIMD)))
 __attribute__((reqd_work_group_size(LWG_SIZE, 1, 1)))
-__kernel void Strsv_simd16x16_upper_ntrans(int diag, uint n, __global float* A, uint lda, __global float* x, uint incx)
+__kernel void KERNEL_NAME(int diag, uint n, __global float* A, uint lda, __global float* x, uint incx
+#ifdef BATCHED
+                          , ulong stride_a, ulong stride_x
+#endif
+                          )
 {
+#ifdef BATCHED
+    A += get_group_id(1) * stride_a;
+    x += get_group_id(1) * stride_x;
+#endif
+
     const uint sgid = get_sub_group_id();
     const uint sglid = get_sub_group_local_id();
 
@@ -311,3 +326,4 @@ __kernel void Strsv_simd16x16_upper_ntrans(int diag, uint n, __global float* A,
 #undef UPDATE_HEIGHT
 #undef UPDATE_SKIP
 #undef BLOCK_WIDTH
+#undef KERNEL_NAME
@@ -0,0 +1,58 @@
+// Copyright (c) 2017-2018 Intel Corporation
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//      http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "functions/StrsvStridedBatched.hpp"
+
+static const char* module_name = "StrsvStridedBatched_naive";
+static const char* kernel_name = "StrsvStridedBatched_naive";
+
+namespace iclgpu { namespace functions { namespace implementations {
+
+bool StrsvStridedBatched_naive::accept(const StrsvStridedBatched::params& params, StrsvStridedBatched::score& score)
+{
+    return true;
+}
+
+event StrsvStridedBatched_naive::execute(const StrsvStridedBatched::params& params, const std::vector<event>& dep_events)
+{
+    auto engine = context()->get_engine();
+    auto kernel = engine->get_kernel(kernel_name, module_name);
+    const size_t last = params.batchCount - 1;
+    size_t a_buf_size = last * params.strideA + params.n * params.lda;
+    size_t x_buf_size = last * params.stridex + params.n * params.incx;
+
+    kernel->set_arg(0, params.uplo);
+    kernel->set_arg(1, params.trans);
+    kernel->set_arg(2, params.diag);
+    kernel->set_arg(3, params.n);
+    auto buf_a = engine->get_input_buffer(params.A, a_buf_size);
+    kernel->set_arg(4, buf_a);
+    kernel->set_arg(5, params.lda);
+    kernel->set_arg(6, static_cast<uint64_t>(params.strideA));
+    auto buf_x = engine->get_inout_buffer(params.x, x_buf_size);
+    kernel->set_arg(7, buf_x);
+    kernel->set_arg(8, params.incx);
+    kernel->set_arg(9, static_cast<uint64_t>(params.stridex));
+
+    // One work-item solves one problem
+    auto gws = nd_range(params.batchCount);
+    auto lws = null_range;
+
+    kernel->set_options({ gws, lws });
+
+    return kernel->submit(dep_events);
+}
+
+} } } // namespace iclgpu::functions::implementations
@@ -0,0 +1,67 @@
+// Copyright (c) 2017-2018 Intel Corporation
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//      http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "functions/StrsvStridedBatched.hpp"
+
+static const char* module_name = "StrsvStridedBatched_simd16_upper_ntrans";
+static const char* kernel_name = "StrsvStridedBatched_simd16_upper_ntrans";
+
+#define ICLBLAS_FILL_MODE_UPPER (0)
+#define ICLBLAS_OP_N (0)
+
+// Work-group of 4 sub-groups solves one problem
+static const int lwg_size = 64;
+static const int simd = 16;
+
+namespace iclgpu { namespace functions { namespace implementations {
+
+bool StrsvStridedBatched_simd16_upper_ntrans::accept(const StrsvStridedBatched::params& params, StrsvStridedBatched::score& score)
+{
+    // Smaller problems are solved faster by single work-item
+    if (params.uplo != ICLBLAS_FILL_MODE_UPPER || params.trans != ICLBLAS_OP_N || params.n < 2 * simd)
+        return false;
+    score.uplo = 1.1f;
+    score.trans = 1.1f;
+    return true;
+}
+
+event StrsvStridedBatched_simd16_upper_ntrans::execute(const StrsvStridedBatched::params& params, const std::vector<event>& dep_events)
+{
+    auto engine = context()->get_engine();
+    auto kernel = engine->get_kernel(kernel_name, module_name);
+    const size_t last = params.batchCount - 1;
+    size_t A_buf_size = last * params.strideA + params.n * params.lda;
+    size_t x_buf_size = last * params.stridex + params.n * params.incx;
+
+    kernel->set_arg(0, params.diag);
+    kernel->set_arg(1, params.n);
+    auto buf_A = engine->get_input_buffer(params.A, A_buf_size);
+    kernel->set_arg(2, buf_A);
+    kernel->set_arg(3, params.lda);
+    auto buf_x = engine->get_inout_buffer(params.x, x_buf_size);
+    kernel->set_arg(4, buf_x);
+    kernel->set_arg(5, params.incx);
+    kernel->set_arg(6, static_cast<uint64_t>(params.strideA));
+    kernel->set_arg(7, static_cast<uint64_t>(params.stridex));
+
+    auto gws = nd_range(lwg_size, params.batchCount);
+    auto lws = nd_range(lwg_size, 1);
+    auto options = kernel_options(gws, lws);
+    kernel->set_options(options);
+
+    return kernel->submit(dep_events);
+}
+
+} } } // namespace iclgpu::functions::implementations
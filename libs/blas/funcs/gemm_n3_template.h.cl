@@ -68,6 +68,10 @@
 //                                     tile in m dimension.
 //  - TARG_TILE_IDX_GDIM_N      [uint] (default: 1) Number of dimension in get_group_id() which identifies index of
 //                                     tile in m dimension.
+//  - TARG_BATCH_IDX_GDIM       [uint] (optional) Number of dimension in get_group_id() which identifies index of
+//                                     matrices in batch. When defined, kernel has additional parameters
+//                                     stride_a, stride_b, stride_c (distances in elements between consecutive
+//                                     matrices A, B and C of the batch).
 //  - TARG_DT_OP_NZT(x)         [expr] (default: ((x) != 0) ) Expression that tests TARG_DATA_TYPE to be non-zero.
 //  - TARG_DT_OP_MUL(x, y)      [expr] (default: ((x) * (y)) ) Expression that multiplies two TARG_DATA_TYPE elements.
 //  - TARG_DT_OP_ADD(x, y)      [expr] (default: ((x) + (y)) ) Expression that adds two TARG_DATA_TYPE elements.
@@ -398,8 +402,20 @@ __kernel void TARG_KERNEL_NAME(uint m, uint n, uint k,
                                DATA_LS_RO_AS const TARG_DATA_TYPE* A, uint lda,
                                DATA_LS_RO_AS const TARG_DATA_TYPE* B, uint ldb,
                                TARG_DATA_TYPE beta,
-                               DATA_LS_RW_AS TARG_DATA_TYPE* C, uint ldc)
+                               DATA_LS_RW_AS TARG_DATA_TYPE* C, uint ldc
+#ifdef TARG_BATCH_IDX_GDIM
+                               , ulong stride_a, ulong stride_b, ulong stride_c
+#endif
+                               )
 {    
+#ifdef TARG_BATCH_IDX_GDIM
+    // [UNIFORM] Matrices of the batch calculated by current sub-group.
+    const ulong batch_idx = get_group_id(TARG_BATCH_IDX_GDIM);
+    A += batch_idx * stride_a;
+    B += batch_idx * stride_b;
+    C += batch_idx * stride_c;
+#endif
+
     // [CONSTEXPR][UNIFORM] Minimal size of tile in "k" dimension.
     const uint tile_k_min   = TARG_TILE_AK < TARG_TILE_BK ? TARG_TILE_AK : TARG_TILE_BK;
     // [CONSTEXPR][UNIFORM] Maximum ratio between sizes of tile in "k" dimension in matrix A and B.
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 
 template<unsigned int alignment, typename type>
@@ -21,3 +22,35 @@ bool is_aligned(type* ptr)
 {
     return (reinterpret_cast<std::uintptr_t>(ptr) & (alignment - 1)) == 0;
 }
+
+/// Index of the first element of a BLAS vector of @p n elements: vectors with negative increment are traversed from the end
+inline std::ptrdiff_t first_element(int n, int inc)
+{
+    return inc < 0 ? static_cast<std::ptrdiff_t>(1 - n) * inc : 0;
+}
+
+/// Number of elements of a BLAS vector buffer including the increment gaps
+inline std::size_t vector_size(int n, int inc)
+{
+    return n > 0 ? 1 + static_cast<std::size_t>(n - 1) * static_cast<std::size_t>(inc < 0 ? -inc : inc) : 0;
+}
+
+/// Dot product of contiguous vectors, independent partial sums let the compiler vectorize the loop
+template<typename acc_type = float>
+acc_type host_dot(const float* x, const float* y, std::size_t n)
+{
+    const std::size_t lanes = 8;
+    acc_type sums[lanes] = {};
+    std::size_t i = 0;
+    for (; i + lanes <= n; i += lanes)
+    {
+        for (std::size_t l = 0; l < lanes; ++l)
+            sums[l] += static_cast<acc_type>(x[i + l]) * static_cast<acc_type>(y[i + l]);
+    }
+    acc_type result = 0;
+    for (; i < n; ++i)
+        result += static_cast<acc_type>(x[i]) * static_cast<acc_type>(y[i]);
+    for (std::size_t l = 0; l < lanes; ++l)
+        result += sums[l];
+    return result;
+}
@@ -0,0 +1,40 @@
+/* Copyright (c) 2017-2018 Intel Corporation
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SPECIALIZATION_H
+#define SPECIALIZATION_H
+
+/* Arguments which may be replaced by constants at dispatch time (see iclgpu::functions::specialization).
+ * Kernel uses SPEC_<name> in place of the argument, module variants define it as a constant,
+ * otherwise it refers to the argument itself.
+ */
+
+#ifndef SPEC_alpha
+#   define SPEC_alpha alpha
+#endif
+
+#ifndef SPEC_beta
+#   define SPEC_beta beta
+#endif
+
+#ifndef SPEC_incx
+#   define SPEC_incx incx
+#endif
+
+#ifndef SPEC_incy
+#   define SPEC_incy incy
+#endif
+
+#endif /* SPECIALIZATION_H */
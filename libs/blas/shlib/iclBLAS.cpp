@@ -14,30 +14,296 @@
 
 #include "iclBLAS.h"
 #include "context.hpp"
+#include "device_group.hpp"
 #include "dispatcher.hpp"
+#include "environment.hpp"
 #include "primitive_db.hpp"
+#include "tracer.hpp"
+#include "performance_db.hpp"
+#include "ocl/ocl_engine.hpp"
 #include "iclBLASImpl.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+
+#ifdef BLAS_OCL_KERNELS_IL
+#include BLAS_OCL_KERNELS_IL
+#endif
+
+namespace
+{
+void insert_kernels(const std::shared_ptr<iclgpu::context>& ctx)
+{
+    auto db = ctx->get_engine()->get_primitive_db();
+    db->insert({
+    #include BLAS_OCL_KERNELS_DB
+    });
+#ifdef BLAS_OCL_KERNELS_IL
+    db->insert_binaries(blas_ocl_kernels_il);
+#endif
+}
+
+// Modules are named by implementations: <function>_<implementation>
+bool is_function_module(const std::string& module, const std::string& function)
+{
+    return module.compare(0, function.size(), function) == 0
+        && (module.size() == function.size() || module[function.size()] == '_');
+}
+}
 
 iclblasContext::iclblasContext()
     : _tag(tag_value), _gen_cl_context(iclgpu::context::create())
+{
+    initialize();
+}
+
+iclblasContext::iclblasContext(size_t device)
+    : _tag(tag_value), _gen_cl_context(iclgpu::context::create(device))
+{
+    initialize();
+}
+
+void iclblasContext::initialize()
+{
+    insert_kernels(_gen_cl_context);
+    // Contexts of other devices sharing work of the handle need the same kernels
+    _gen_cl_context->get<iclgpu::device_group>()->set_context_initializer(insert_kernels);
+
+    std::string warmup_policy;
+    if (iclgpu::get_environment_variable("ICLBLAS_WARMUP", warmup_policy) && !warmup_policy.empty() && warmup_policy != "0")
     {
-        _gen_cl_context->get_engine(iclgpu::engine_type::open_cl)->get_primitive_db()->insert({
-        #include BLAS_OCL_KERNELS_DB
-        });
+        std::vector<std::string> functions;
+        if (warmup_policy != "all")
+        {
+            std::istringstream stream(warmup_policy);
+            std::string function;
+            while (std::getline(stream, function, ','))
+            {
+                if (!function.empty())
+                    functions.push_back(function);
+            }
+        }
+        // Unknown function names are not reported here: there is no caller to report to.
+        warmup(functions, false);
     }
+}
 
 iclblasContext::~iclblasContext()
 {
+    std::string report;
+    if (iclgpu::get_environment_variable("ICLBLAS_BUILD_REPORT", report) && !report.empty() && report != "0")
+        print_build_report();
     _gen_cl_context.reset();
     _tag = 0;
 }
 
+bool iclblasContext::warmup(const std::vector<std::string>& functions, bool wait)
+{
+    auto engine = _gen_cl_context->get_engine();
+    auto all_modules = engine->get_primitive_db()->module_names();
+
+    std::vector<std::string> modules;
+    if (functions.empty())
+    {
+        modules = all_modules;
+    }
+    else
+    {
+        for (auto function : functions)
+        {
+            if (function.compare(0, 7, "iclblas") == 0)
+                function = function.substr(7);
+
+            auto found = false;
+            for (auto& module : all_modules)
+            {
+                if (is_function_module(module, function))
+                {
+                    modules.push_back(module);
+                    found = true;
+                }
+            }
+            if (!found)
+                return false;
+        }
+    }
+
+    engine->warmup(modules);
+    if (wait)
+        engine->wait_warmup();
+    return true;
+}
+
+const std::vector<iclgpu::module_build_info>& iclblasContext::get_build_info()
+{
+    _build_info = _gen_cl_context->get_engine()->get_build_info();
+    return _build_info;
+}
+
+void iclblasContext::print_build_report()
+{
+    auto info = get_build_info();
+    // The longest builds first: they are the most likely to be on the critical path
+    std::sort(info.begin(), info.end(), [](const iclgpu::module_build_info& l, const iclgpu::module_build_info& r)
+    {
+        return l.duration > r.duration;
+    });
+
+    static const char* origin_names[] = { "source", "precompiled", "cached", "shared" };
+    std::fprintf(stderr, "iclBLAS module build report (%d modules):\n", static_cast<int>(info.size()));
+    for (auto& i : info)
+    {
+        std::fprintf(stderr, "  %-48s %10.3f ms  %-11s %s\n", i.module.c_str(), i.duration.count() / 1e6,
+                     origin_names[i.origin], i.background ? "warm-up" : "on demand");
+    }
+}
+
 void iclblasContext::validate(iclblasHandle_t handle)
 {
     if (handle == nullptr || handle->_tag != tag_value)
         throw std::invalid_argument("handle");
 }
 
+iclblasStream::iclblasStream(const std::shared_ptr<iclgpu::context>& context)
+    : _tag(tag_value), _context(context) {}
+
+iclblasStream::~iclblasStream()
+{
+    _tag = 0;
+}
+
+void iclblasStream::validate(iclblasStream_t stream)
+{
+    if (stream == nullptr || stream->_tag != tag_value)
+        throw std::invalid_argument("stream");
+}
+
+void iclblasStream::submit(const std::function<std::shared_ptr<iclgpu::event>(const events_list&)>& func)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto dependencies = _waits;
+    if (_last)
+        dependencies.push_back(_last);
+    _last = func(dependencies);
+    _waits.clear();
+}
+
+std::shared_ptr<iclgpu::event> iclblasStream::record() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _last;
+}
+
+void iclblasStream::wait_event(const std::shared_ptr<iclgpu::event>& event)
+{
+    if (!event)
+        return;
+    // Events of other contexts cannot be passed to the engine
+    if (event->get_engine() != _context->get_engine())
+    {
+        event->wait();
+        return;
+    }
+    std::lock_guard<std::mutex> lock(_mutex);
+    _waits.push_back(event);
+}
+
+void iclblasStream::synchronize()
+{
+    std::shared_ptr<iclgpu::event> last;
+    events_list waits;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        last = _last;
+        waits = _waits;
+    }
+    for (auto& evt : waits)
+        evt->wait();
+    if (!last)
+        return;
+    last->wait();
+
+    // Release buffers of completed work unless new work was submitted meanwhile
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_last == last)
+        _last.reset();
+}
+
+void iclblasContext::begin_capture()
+{
+    _gen_cl_context->get_engine()->begin_capture();
+    _capturing = true;
+}
+
+iclgpu::captured_commands iclblasContext::end_capture()
+{
+    _capturing = false;
+    return _gen_cl_context->get_engine()->end_capture();
+}
+
+iclblasGraph::iclblasGraph(const std::shared_ptr<iclgpu::context>& context, iclgpu::captured_commands&& commands)
+    : _tag(tag_value), _context(context), _commands(std::move(commands)) {}
+
+iclblasGraph::~iclblasGraph()
+{
+    _tag = 0;
+}
+
+void iclblasGraph::validate(iclblasGraph_t graph)
+{
+    if (graph == nullptr || graph->_tag != tag_value)
+        throw std::invalid_argument("graph");
+}
+
+std::shared_ptr<iclgpu::event> iclblasGraph::launch(const iclblasStream::events_list& dependencies)
+{
+    // Kernel arguments are updated on submission
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _commands.sequence->submit(dependencies);
+}
+
+bool iclblasGraph::update_pointer(const void* old_ptr, void* new_ptr)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto found = false;
+    for (auto& binding : _commands.bindings)
+    {
+        if (!binding->get_owning_engine() && binding->get_host_ptr() == old_ptr)
+        {
+            binding->rebind(new_ptr);
+            found = true;
+        }
+    }
+    return found;
+}
+
+iclblasEvent::iclblasEvent()
+    : _tag(tag_value) {}
+
+iclblasEvent::~iclblasEvent()
+{
+    _tag = 0;
+}
+
+void iclblasEvent::validate(iclblasEvent_t event)
+{
+    if (event == nullptr || event->_tag != tag_value)
+        throw std::invalid_argument("event");
+}
+
+std::shared_ptr<iclgpu::event> iclblasEvent::get() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _event;
+}
+
+void iclblasEvent::set(const std::shared_ptr<iclgpu::event>& event)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _event = event;
+}
+
 // BLAS C API implementation
 extern "C"
 iclblasStatus_t iclblasCreate(iclblasHandle_t* handle)
@@ -50,6 +316,56 @@ iclblasStatus_t iclblasCreate(iclblasHandle_t* handle)
     return ICLBLAS_STATUS_SUCCESS;
 }
 
+extern "C"
+iclblasStatus_t iclblasGetDeviceCount(int* count)
+{
+    if (!count)
+    {
+        return ICLBLAS_STATUS_INVALID_VALUE;
+    }
+    return iclblas::exception_to_iclblas_status([&]
+    {
+        *count = static_cast<int>(iclgpu::ocl_engine::get_device_names().size());
+    });
+}
+
+extern "C"
+iclblasStatus_t iclblasCreateWithDevice(iclblasHandle_t* handle, int device)
+{
+    if (!handle || device < 0 || static_cast<size_t>(device) >= iclgpu::ocl_engine::get_device_names().size())
+    {
+        return ICLBLAS_STATUS_INVALID_VALUE;
+    }
+    return iclblas::exception_to_iclblas_status([&]
+    {
+        *handle = new iclblasContext(static_cast<size_t>(device));
+    });
+}
+
+extern "C"
+iclblasStatus_t iclblasSetDevices(iclblasHandle_t handle, const int* devices, int count)
+{
+    iclblasContext::validate(handle);
+    if (count < 0 || (count > 0 && !devices))
+    {
+        return ICLBLAS_STATUS_INVALID_VALUE;
+    }
+    const auto devices_count = iclgpu::ocl_engine::get_device_names().size();
+    std::vector<size_t> indices;
+    for (int i = 0; i < count; ++i)
+    {
+        if (devices[i] < 0 || static_cast<size_t>(devices[i]) >= devices_count)
+        {
+            return ICLBLAS_STATUS_INVALID_VALUE;
+        }
+        indices.push_back(static_cast<size_t>(devices[i]));
+    }
+    return iclblas::exception_to_iclblas_status([&]
+    {
+        handle->get_iclgpuContext()->get<iclgpu::device_group>()->set_devices(indices);
+    });
+}
+
 extern "C"
 iclblasStatus_t iclblasDestroy(iclblasHandle_t handle)
 {
@@ -57,3 +373,464 @@ iclblasStatus_t iclblasDestroy(iclblasHandle_t handle)
     delete handle;
     return ICLBLAS_STATUS_SUCCESS;
 }
+
+extern "C"
+iclblasStatus_t iclblasWarmup(iclblasHandle_t handle, const char* const* functions, int flags)
+{
+    iclblasContext::validate(handle);
+    if (flags != ICLBLAS_WARMUP_ASYNC && flags != ICLBLAS_WARMUP_WAIT)
+        return ICLBLAS_STATUS_INVALID_VALUE;
+
+    auto known_functions = true;
+    auto status = iclblas::exception_to_iclblas_status([&]
+    {
+        std::vector<std::string> names;
+        for (auto f = functions; f != nullptr && *f != nullptr; ++f)
+        {
+            names.push_back(*f);
+        }
+        if (functions != nullptr && names.empty())
+            return;
+        known_functions = handle->warmup(names, flags == ICLBLAS_WARMUP_WAIT);
+    });
+    return status == ICLBLAS_STATUS_SUCCESS && !known_functions ? ICLBLAS_STATUS_INVALID_VALUE : status;
+}
+
+extern "C"
+iclblasStatus_t iclblasGetModuleBuildInfo(iclblasHandle_t handle, iclblasModuleBuildInfo_t* info, int* count)
+{
+    iclblasContext::validate(handle);
+    if (count == nullptr || (info != nullptr && *count < 0))
+        return ICLBLAS_STATUS_INVALID_VALUE;
+
+    return iclblas::exception_to_iclblas_status([&]
+    {
+        auto& build_info = handle->get_build_info();
+        if (info == nullptr)
+        {
+            *count = static_cast<int>(build_info.size());
+            return;
+        }
+
+        auto num = std::min(static_cast<size_t>(*count), build_info.size());
+        for (size_t i = 0; i < num; ++i)
+        {
+            info[i].module = build_info[i].module.c_str();
+            info[i].origin = static_cast<iclblasModuleOrigin_t>(build_info[i].origin);
+            info[i].background = build_info[i].background ? 1 : 0;
+            info[i].build_time = build_info[i].duration.count() / 1e6;
+        }
+        *count = static_cast<int>(num);
+    });
+}
+
+extern "C"
+iclblasStatus_t iclblasGetBufferPoolStats(iclblasHandle_t handle, iclblasBufferPoolStats_t* stats)
+{
+    iclblasContext::validate(handle);
+    if (stats == nullptr)
+        return ICLBLAS_STATUS_INVALID_VALUE;
+
+    return iclblas::exception_to_iclblas_status([&]
+    {
+        auto engine = handle->get_iclgpuContext()->get_engine();
+        auto pool_stats = engine->get_buffer_pool_stats();
+        stats->requests = pool_stats.requests;
+        stats->hits = pool_stats.hits;
+        stats->allocations = pool_stats.allocations;
+        stats->cached_buffers = pool_stats.cached_buffers;
+        stats->cached_bytes = pool_stats.cached_bytes;
+        stats->high_water_mark = pool_stats.high_water_mark;
+    });
+}
+
+extern "C"
+iclblasStatus_t iclblasTrimBufferPool(iclblasHandle_t handle)
+{
+    iclblasContext::validate(handle);
+    return iclblas::exception_to_iclblas_status([&]
+    {
+        handle->get_iclgpuContext()->get_engine()->trim_buffer_pool();
+    });
+}
+
+extern "C"
+iclblasStatus_t iclblasHostRegister(iclblasHandle_t handle, void* ptr, size_t size)
+{
+    iclblasContext::validate(handle);
+    if (ptr == nullptr || size == 0)
+        return ICLBLAS_STATUS_INVALID_VALUE;
+
+    return iclblas::exception_to_iclblas_status([&]
+    {
+        handle->get_iclgpuContext()->get_engine()->register_host_memory(ptr, size);
+    });
+}
+
+extern "C"
+iclblasStatus_t iclblasHostUnregister(iclblasHandle_t handle, void* ptr)
+{
+    iclblasContext::validate(handle);
+    if (ptr == nullptr)
+        return ICLBLAS_STATUS_INVALID_VALUE;
+
+    return iclblas::exception_to_iclblas_status([&]
+    {
+        handle->get_iclgpuContext()->get_engine()->unregister_host_memory(ptr);
+    });
+}
+
+extern "C"
+iclblasStatus_t iclblasHostSync(iclblasHandle_t handle, void* ptr, size_t size)
+{
+    iclblasContext::validate(handle);
+    if (ptr == nullptr)
+        return ICLBLAS_STATUS_INVALID_VALUE;
+
+    return iclblas::exception_to_iclblas_status([&]
+    {
+        handle->get_iclgpuContext()->get_engine()->sync_host_memory(ptr, size);
+    });
+}
+
+extern "C"
+iclblasStatus_t iclblasAlloc(iclblasHandle_t handle, size_t size, void** ptr)
+{
+    iclblasContext::validate(handle);
+    if (ptr == nullptr || size == 0)
+        return ICLBLAS_STATUS_INVALID_VALUE;
+
+    try
+    {
+        auto engine = handle->get_iclgpuContext()->get_engine();
+        *ptr = iclgpu::device_memory::add(engine->create_buffer(size, nullptr, iclgpu::buffer_init::uninitialized), handle);
+    }
+    catch (...)
+    {
+        return ICLBLAS_STATUS_ALLOC_FAILED;
+    }
+    return ICLBLAS_STATUS_SUCCESS;
+}
+
+extern "C"
+iclblasStatus_t iclblasFree(iclblasHandle_t handle, void* ptr)
+{
+    iclblasContext::validate(handle);
+    if (ptr == nullptr)
+        return ICLBLAS_STATUS_SUCCESS;
+    return iclgpu::device_memory::remove(ptr, handle) ? ICLBLAS_STATUS_SUCCESS : ICLBLAS_STATUS_INVALID_VALUE;
+}
+
+namespace
+{
+// Row of the transfer is a single element for vectors and a column for matrices
+iclblasStatus_t transfer_rect(iclblasHandle_t handle, bool to_device, const void* device_ptr, size_t device_pitch,
+                              void* host_ptr, size_t host_pitch, size_t row_size, size_t rows)
+{
+    iclblasContext::validate(handle);
+    auto device = iclgpu::device_memory::find(device_ptr);
+    if (!device.first || host_ptr == nullptr)
+        return ICLBLAS_STATUS_INVALID_VALUE;
+    if (rows == 0 || row_size == 0)
+        return ICLBLAS_STATUS_SUCCESS;
+
+    return iclblas::exception_to_iclblas_status([&]
+    {
+        if (to_device)
+            device.first->write_rect(device.second, device_pitch, host_ptr, host_pitch, row_size, rows);
+        else
+            device.first->read_rect(device.second, device_pitch, host_ptr, host_pitch, row_size, rows);
+    });
+}
+}
+
+extern "C"
+iclblasStatus_t iclblasSetVector(iclblasHandle_t handle, int n, int elemSize, const void* x, int incx, void* y, int incy)
+{
+    if (n < 0 || elemSize <= 0 || incx <= 0 || incy <= 0)
+        return ICLBLAS_STATUS_INVALID_VALUE;
+    return transfer_rect(handle, true, y, size_t(incy) * elemSize, const_cast<void*>(x), size_t(incx) * elemSize, elemSize, n);
+}
+
+extern "C"
+iclblasStatus_t iclblasGetVector(iclblasHandle_t handle, int n, int elemSize, const void* x, int incx, void* y, int incy)
+{
+    if (n < 0 || elemSize <= 0 || incx <= 0 || incy <= 0)
+        return ICLBLAS_STATUS_INVALID_VALUE;
+    return transfer_rect(handle, false, x, size_t(incx) * elemSize, y, size_t(incy) * elemSize, elemSize, n);
+}
+
+extern "C"
+iclblasStatus_t iclblasSetMatrix(iclblasHandle_t handle, int rows, int cols, int elemSize, const void* A, int lda, void* B, int ldb)
+{
+    if (rows < 0 || cols < 0 || elemSize <= 0 || lda < std::max(1, rows) || ldb < std::max(1, rows))
+        return ICLBLAS_STATUS_INVALID_VALUE;
+    return transfer_rect(handle, true, B, size_t(ldb) * elemSize, const_cast<void*>(A), size_t(lda) * elemSize,
+                         size_t(rows) * elemSize, cols);
+}
+
+extern "C"
+iclblasStatus_t iclblasGetMatrix(iclblasHandle_t handle, int rows, int cols, int elemSize, const void* A, int lda, void* B, int ldb)
+{
+    if (rows < 0 || cols < 0 || elemSize <= 0 || lda < std::max(1, rows) || ldb < std::max(1, rows))
+        return ICLBLAS_STATUS_INVALID_VALUE;
+    return transfer_rect(handle, false, A, size_t(lda) * elemSize, B, size_t(ldb) * elemSize,
+                         size_t(rows) * elemSize, cols);
+}
+
+extern "C"
+iclblasStatus_t iclblasSetPointerMode(iclblasHandle_t handle, iclblasPointerMode_t mode)
+{
+    iclblasContext::validate(handle);
+    if (mode != ICLBLAS_POINTER_MODE_HOST && mode != ICLBLAS_POINTER_MODE_DEVICE)
+        return ICLBLAS_STATUS_INVALID_VALUE;
+    handle->set_pointer_mode(mode);
+    return ICLBLAS_STATUS_SUCCESS;
+}
+
+extern "C"
+iclblasStatus_t iclblasGetPointerMode(iclblasHandle_t handle, iclblasPointerMode_t* mode)
+{
+    iclblasContext::validate(handle);
+    if (mode == nullptr)
+        return ICLBLAS_STATUS_INVALID_VALUE;
+    *mode = handle->get_pointer_mode();
+    return ICLBLAS_STATUS_SUCCESS;
+}
+
+extern "C"
+iclblasStatus_t iclblasSetProfiling(iclblasHandle_t handle, int enabled)
+{
+    iclblasContext::validate(handle);
+    return iclblas::exception_to_iclblas_status([=]
+    {
+        handle->get_iclgpuContext()->get_engine()->set_profiling(enabled != 0);
+    });
+}
+
+extern "C"
+iclblasStatus_t iclblasGetProfiling(iclblasHandle_t handle, int* enabled)
+{
+    iclblasContext::validate(handle);
+    if (enabled == nullptr)
+        return ICLBLAS_STATUS_INVALID_VALUE;
+    return iclblas::exception_to_iclblas_status([=]
+    {
+        *enabled = handle->get_iclgpuContext()->get_engine()->is_profiling_enabled() ? 1 : 0;
+    });
+}
+
+extern "C"
+iclblasStatus_t iclblasSetTuning(iclblasHandle_t handle, int enabled)
+{
+    iclblasContext::validate(handle);
+    return iclblas::exception_to_iclblas_status([=]
+    {
+        handle->get_iclgpuContext()->get<iclgpu::performance_db>()->set_enabled(enabled != 0);
+    });
+}
+
+extern "C"
+iclblasStatus_t iclblasGetTuning(iclblasHandle_t handle, int* enabled)
+{
+    iclblasContext::validate(handle);
+    if (enabled == nullptr)
+        return ICLBLAS_STATUS_INVALID_VALUE;
+    return iclblas::exception_to_iclblas_status([=]
+    {
+        *enabled = handle->get_iclgpuContext()->get<iclgpu::performance_db>()->is_enabled() ? 1 : 0;
+    });
+}
+
+extern "C"
+iclblasStatus_t iclblasStreamCreate(iclblasHandle_t handle, iclblasStream_t* stream)
+{
+    iclblasContext::validate(handle);
+    if (stream == nullptr)
+        return ICLBLAS_STATUS_INVALID_VALUE;
+    *stream = new iclblasStream(handle->get_iclgpuContext());
+    return ICLBLAS_STATUS_SUCCESS;
+}
+
+extern "C"
+iclblasStatus_t iclblasStreamDestroy(iclblasStream_t stream)
+{
+    iclblasStream::validate(stream);
+    auto status = iclblas::exception_to_iclblas_status([&]
+    {
+        stream->synchronize();
+    });
+    delete stream;
+    return status;
+}
+
+extern "C"
+iclblasStatus_t iclblasSetStream(iclblasHandle_t handle, iclblasStream_t stream)
+{
+    iclblasContext::validate(handle);
+    if (stream != nullptr)
+    {
+        iclblasStream::validate(stream);
+        if (stream->get_iclgpuContext() != handle->get_iclgpuContext())
+            return ICLBLAS_STATUS_INVALID_VALUE;
+    }
+    handle->set_stream(stream);
+    return ICLBLAS_STATUS_SUCCESS;
+}
+
+extern "C"
+iclblasStatus_t iclblasGetStream(iclblasHandle_t handle, iclblasStream_t* stream)
+{
+    iclblasContext::validate(handle);
+    if (stream == nullptr)
+        return ICLBLAS_STATUS_INVALID_VALUE;
+    *stream = handle->get_stream();
+    return ICLBLAS_STATUS_SUCCESS;
+}
+
+extern "C"
+iclblasStatus_t iclblasStreamSynchronize(iclblasStream_t stream)
+{
+    iclblasStream::validate(stream);
+    return iclblas::exception_to_iclblas_status([&]
+    {
+        stream->synchronize();
+    });
+}
+
+extern "C"
+iclblasStatus_t iclblasStreamWaitEvent(iclblasStream_t stream, iclblasEvent_t event)
+{
+    iclblasStream::validate(stream);
+    iclblasEvent::validate(event);
+    return iclblas::exception_to_iclblas_status([&]
+    {
+        stream->wait_event(event->get());
+    });
+}
+
+extern "C"
+iclblasStatus_t iclblasEventCreate(iclblasEvent_t* event)
+{
+    if (event == nullptr)
+        return ICLBLAS_STATUS_INVALID_VALUE;
+    *event = new iclblasEvent();
+    return ICLBLAS_STATUS_SUCCESS;
+}
+
+extern "C"
+iclblasStatus_t iclblasEventDestroy(iclblasEvent_t event)
+{
+    iclblasEvent::validate(event);
+    delete event;
+    return ICLBLAS_STATUS_SUCCESS;
+}
+
+extern "C"
+iclblasStatus_t iclblasEventRecord(iclblasEvent_t event, iclblasStream_t stream)
+{
+    iclblasEvent::validate(event);
+    iclblasStream::validate(stream);
+    event->set(stream->record());
+    return ICLBLAS_STATUS_SUCCESS;
+}
+
+extern "C"
+iclblasStatus_t iclblasEventSynchronize(iclblasEvent_t event)
+{
+    iclblasEvent::validate(event);
+    return iclblas::exception_to_iclblas_status([&]
+    {
+        if (auto evt = event->get())
+            evt->wait();
+    });
+}
+
+extern "C"
+iclblasStatus_t iclblasGraphBeginCapture(iclblasHandle_t handle)
+{
+    iclblasContext::validate(handle);
+    if (handle->is_capturing())
+        return ICLBLAS_STATUS_INVALID_VALUE;
+    return iclblas::exception_to_iclblas_status([&]
+    {
+        handle->begin_capture();
+    });
+}
+
+extern "C"
+iclblasStatus_t iclblasGraphEndCapture(iclblasHandle_t handle, iclblasGraph_t* graph)
+{
+    iclblasContext::validate(handle);
+    if (graph == nullptr || !handle->is_capturing())
+        return ICLBLAS_STATUS_INVALID_VALUE;
+    return iclblas::exception_to_iclblas_status([&]
+    {
+        *graph = new iclblasGraph(handle->get_iclgpuContext(), handle->end_capture());
+    });
+}
+
+extern "C"
+iclblasStatus_t iclblasGraphLaunch(iclblasHandle_t handle, iclblasGraph_t graph)
+{
+    iclblasContext::validate(handle);
+    iclblasGraph::validate(graph);
+    if (handle->is_capturing() || graph->get_iclgpuContext() != handle->get_iclgpuContext())
+        return ICLBLAS_STATUS_INVALID_VALUE;
+
+    return iclblas::exception_to_iclblas_status([&]
+    {
+        auto stream = handle->get_stream();
+        if (stream == nullptr)
+        {
+            graph->launch({})->wait();
+            return;
+        }
+        stream->submit([&](const iclblasStream::events_list& dependencies)
+        {
+            return graph->launch(dependencies);
+        });
+    });
+}
+
+extern "C"
+iclblasStatus_t iclblasGraphUpdatePointer(iclblasGraph_t graph, const void* oldPtr, void* newPtr)
+{
+    iclblasGraph::validate(graph);
+    if (oldPtr == nullptr || newPtr == nullptr)
+        return ICLBLAS_STATUS_INVALID_VALUE;
+    auto found = true;
+    auto status = iclblas::exception_to_iclblas_status([&]
+    {
+        found = graph->update_pointer(oldPtr, newPtr);
+    });
+    return status == ICLBLAS_STATUS_SUCCESS && !found ? ICLBLAS_STATUS_INVALID_VALUE : status;
+}
+
+extern "C"
+iclblasStatus_t iclblasGraphDestroy(iclblasGraph_t graph)
+{
+    iclblasGraph::validate(graph);
+    delete graph;
+    return ICLBLAS_STATUS_SUCCESS;
+}
+
+extern "C"
+iclblasStatus_t iclblasSetTracing(int enabled)
+{
+    iclgpu::tracer::enable(enabled != 0);
+    return ICLBLAS_STATUS_SUCCESS;
+}
+
+extern "C"
+iclblasStatus_t iclblasWriteTrace(const char* fileName)
+{
+    if (fileName == nullptr)
+        return ICLBLAS_STATUS_INVALID_VALUE;
+    auto written = true;
+    auto status = iclblas::exception_to_iclblas_status([&]
+    {
+        written = iclgpu::tracer::write(fileName);
+    });
+    return status == ICLBLAS_STATUS_SUCCESS && !written ? ICLBLAS_STATUS_INVALID_VALUE : status;
+}
@@ -18,20 +18,124 @@
 #include "context.hpp"
 #include "dispatcher.hpp"
 #include "errors.hpp"
+#include <algorithm>
+#include <atomic>
 #include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
 
 // The BLAS implementation
 // in global namespace, because it is definition fo C API opaque structure
 struct iclblasContext
 {
     iclblasContext();
+    /// @brief Creates context using OpenCL device @p device, see iclgpu::context::create(size_t)
+    explicit iclblasContext(size_t device);
     ~iclblasContext();
     std::shared_ptr<iclgpu::context> get_iclgpuContext() const { return _gen_cl_context; }
     static void validate(iclblasHandle_t handle);
+
+    /// @brief Starts building of modules used by functions. Empty list means all modules.
+    /// @returns false if a function name is unknown, nothing is built then.
+    bool warmup(const std::vector<std::string>& functions, bool wait);
+    /// @brief Returns build statistics, names are valid until the next call.
+    const std::vector<iclgpu::module_build_info>& get_build_info();
+
+    /// @brief Returns stream of asynchronous calls or NULL if calls are synchronous
+    iclblasStream_t get_stream() const { return _stream.load(); }
+    void set_stream(iclblasStream_t stream) { _stream.store(stream); }
+
+    /// @brief Returns where scalars and results are stored
+    iclblasPointerMode_t get_pointer_mode() const { return _pointer_mode.load(); }
+    void set_pointer_mode(iclblasPointerMode_t mode) { _pointer_mode.store(mode); }
+
+    /// @brief Returns true if calls are recorded into a graph instead of execution
+    bool is_capturing() const { return _capturing.load(); }
+    void begin_capture();
+    iclgpu::captured_commands end_capture();
 private:
     static const int tag_value = 0xB1A5;
     int _tag;
     std::shared_ptr<iclgpu::context> _gen_cl_context;
+    std::vector<iclgpu::module_build_info> _build_info;
+    // Calls of other threads sharing the handle may read the settings while they are changed
+    std::atomic<iclblasStream_t> _stream{nullptr};
+    std::atomic<iclblasPointerMode_t> _pointer_mode{ICLBLAS_POINTER_MODE_HOST};
+    std::atomic<bool> _capturing{false};
+
+    void initialize();
+    void print_build_report();
+};
+
+/// @brief Ordered sequence of asynchronous calls
+/// @details Each submission depends on the previous one, so calls are executed in submission order.
+struct iclblasStream
+{
+    using events_list = std::vector<std::shared_ptr<iclgpu::event>>;
+
+    explicit iclblasStream(const std::shared_ptr<iclgpu::context>& context);
+    ~iclblasStream();
+    const std::shared_ptr<iclgpu::context>& get_iclgpuContext() const { return _context; }
+    static void validate(iclblasStream_t stream);
+
+    /// @brief Submits work after all previous work of the stream
+    /// @param func Function enqueuing the work which depends on passed events, returns completion event
+    void submit(const std::function<std::shared_ptr<iclgpu::event>(const events_list&)>& func);
+
+    /// @brief Returns event of the last submitted work or NULL if there is nothing to wait
+    std::shared_ptr<iclgpu::event> record() const;
+
+    /// @brief Makes next submitted work wait for the @p event
+    void wait_event(const std::shared_ptr<iclgpu::event>& event);
+
+    /// @brief Waits for completion of all submitted work
+    void synchronize();
+private:
+    static const int tag_value = 0x57EA;
+    int _tag;
+    std::shared_ptr<iclgpu::context> _context;
+    mutable std::mutex _mutex;
+    // Pins commands and buffers of the last submission until it is completed
+    std::shared_ptr<iclgpu::event> _last;
+    events_list _waits;
+};
+
+/// @brief Recorded sequence of calls
+struct iclblasGraph
+{
+    iclblasGraph(const std::shared_ptr<iclgpu::context>& context, iclgpu::captured_commands&& commands);
+    ~iclblasGraph();
+    const std::shared_ptr<iclgpu::context>& get_iclgpuContext() const { return _context; }
+    static void validate(iclblasGraph_t graph);
+
+    /// @brief Submits recorded commands
+    std::shared_ptr<iclgpu::event> launch(const iclblasStream::events_list& dependencies);
+
+    /// @brief Binds host data at @p new_ptr to commands which used @p old_ptr
+    /// @returns false if no command used @p old_ptr
+    bool update_pointer(const void* old_ptr, void* new_ptr);
+private:
+    static const int tag_value = 0x6AF1;
+    int _tag;
+    std::shared_ptr<iclgpu::context> _context;
+    std::mutex _mutex;
+    iclgpu::captured_commands _commands;
+};
+
+struct iclblasEvent
+{
+    iclblasEvent();
+    ~iclblasEvent();
+    static void validate(iclblasEvent_t event);
+
+    std::shared_ptr<iclgpu::event> get() const;
+    void set(const std::shared_ptr<iclgpu::event>& event);
+private:
+    static const int tag_value = 0xE7E1;
+    int _tag;
+    mutable std::mutex _mutex;
+    std::shared_ptr<iclgpu::event> _event;
 };
 
 namespace iclblas {
@@ -72,13 +176,62 @@ inline iclblasStatus_t exception_to_iclblas_status(std::function<void()> func)
 #endif
 }
 
+/// @brief Returns value of the scalar parameter
+/// @details In device pointer mode scalars stored in device memory are read after completion of preceding calls.
+/// Throws error_unsupported for such scalars during graph capture: replay must not use the value read at capture.
+/// Handle is validated later by the call.
+template<typename T>
+T get_scalar(iclblasHandle_t handle, const T* ptr)
+{
+    if (handle != nullptr && handle->get_pointer_mode() == ICLBLAS_POINTER_MODE_DEVICE)
+    {
+        auto device = iclgpu::device_memory::find(ptr);
+        if (device.first)
+        {
+            if (handle->is_capturing())
+                throw iclgpu::error_unsupported("Scalar in device memory is read on the host, it cannot be captured");
+            T value;
+            device.first->read_rect(device.second, sizeof(T), &value, sizeof(T), sizeof(T), 1);
+            return value;
+        }
+    }
+    return *ptr;
+}
+
+/// @brief Returns true if the scalar parameter is stored in device memory, so kernels can read it directly
+template<typename T>
+bool is_device_scalar(iclblasHandle_t handle, const T* ptr)
+{
+    return handle != nullptr && handle->get_pointer_mode() == ICLBLAS_POINTER_MODE_DEVICE
+        && iclgpu::device_memory::find(ptr).first != nullptr;
+}
+
+/// @brief Stores result computed without calling the device
+template<typename T, typename V>
+void set_result(iclblasHandle_t handle, T* ptr, const V& result)
+{
+    iclblasContext::validate(handle);
+    const T value = result;
+    if (handle->get_pointer_mode() == ICLBLAS_POINTER_MODE_DEVICE)
+    {
+        auto device = iclgpu::device_memory::find(ptr);
+        if (device.first)
+        {
+            device.first->write_rect(device.second, sizeof(T), &value, sizeof(T), sizeof(T), 1);
+            return;
+        }
+    }
+    *ptr = value;
+}
 
 //////////////////////////////////////////////////////
 // Validation
 template<typename T, iclgpu::direction Dir>
 bool validate_blob(const iclgpu::blob<T, Dir>& blb)
 {
-    return static_cast<T*>(blb) != nullptr;
+    // Device memory is not mapped to host just for the check
+    auto binding = blb.get();
+    return binding && (binding->get_owning_engine() || binding->get_host_ptr() != nullptr);
 }
 
 #define DEFINE_HAS_MEMBER(member)                                        \
@@ -214,6 +367,13 @@ VALIDATE_MEMBER(AP)
     return true;
 }
 
+VALIDATE_MEMBER(batchCount)
+{
+    if(params.batchCount < 0)
+        throw std::invalid_argument("batchCount");
+    return params.batchCount > 0;
+}
+
 template<class Params>
 bool validate_params(const Params& params)
 {
@@ -229,7 +389,8 @@ bool validate_params(const Params& params)
         && validate_param_B(params)
         && validate_param_ldb(params)
         && validate_param_C(params)
-        && validate_param_ldc(params);
+        && validate_param_ldc(params)
+        && validate_param_batchCount(params);
 }
 
 // Generic template implementation for BLAS functions
@@ -240,8 +401,124 @@ template<typename Func> void iclblasTemplate_impl(iclblasHandle_t handle, typena
     iclblasContext::validate(handle);
     auto context = handle->get_iclgpuContext();
     auto dispatcher = context->get_dispatcher();
-    auto event = dispatcher->execute_function<Func>(params);
-    event->wait();
+    if (handle->is_capturing())
+    {
+        // Commands are recorded by the engine, the returned event is completed
+        dispatcher->execute_function<Func>(params);
+        return;
+    }
+
+    auto stream = handle->get_stream();
+    if (stream == nullptr)
+    {
+        auto event = dispatcher->execute_function<Func>(params);
+        event->wait();
+        return;
+    }
+
+    // Results are available when the stream is synchronized
+    stream->submit([&](const iclblasStream::events_list& dependencies)
+    {
+        return dispatcher->execute_function<Func>(params, dependencies);
+    });
+}
+
+//////////////////////////////////////////////////////
+// Batched functions
+
+/// @brief Returns true if @p count matrices of @p size elements are equally spaced in single device memory buffer
+/// @param[out] stride Distance in elements between consecutive matrices
+template<typename T>
+bool get_device_batch_stride(T* const ptrs[], size_t count, size_t size, int64_t& stride)
+{
+    auto first = iclgpu::device_memory::find(ptrs[0]);
+    auto last = iclgpu::device_memory::find(ptrs[count - 1]);
+    if (!first.first || last.first != first.first || last.second + size * sizeof(T) > last.first->size())
+        return false;
+
+    const auto distance = count > 1 ? reinterpret_cast<intptr_t>(ptrs[1]) - reinterpret_cast<intptr_t>(ptrs[0]) : 0;
+    if (distance < 0 || distance % sizeof(T) != 0)
+        return false;
+    for (size_t i = 2; i < count; ++i)
+    {
+        if (reinterpret_cast<intptr_t>(ptrs[i]) - reinterpret_cast<intptr_t>(ptrs[i - 1]) != distance)
+            return false;
+    }
+    stride = distance / sizeof(T);
+    return true;
+}
+
+/// @brief Copies @p size elements from host or device memory at @p src to host memory
+template<typename T>
+void load_elements(const T* src, T* dst, size_t size)
+{
+    auto device = iclgpu::device_memory::find(src);
+    if (device.first)
+        device.first->read_rect(device.second, size * sizeof(T), dst, size * sizeof(T), size * sizeof(T), 1);
+    else
+        std::copy(src, src + size, dst);
+}
+
+/// @brief Copies @p size elements from host memory to host or device memory at @p dst
+template<typename T>
+void store_elements(const T* src, T* dst, size_t size)
+{
+    auto device = iclgpu::device_memory::find(dst);
+    if (device.first)
+        device.first->write_rect(device.second, size * sizeof(T), src, size * sizeof(T), size * sizeof(T), 1);
+    else
+        std::copy(src, src + size, dst);
+}
+
+/// @brief Executes matrix products given by arrays of pointers as single strided-batched function call
+/// @details Matrices equally spaced in device memory are used in place. Otherwise matrices are gathered
+/// into contiguous host memory, the call is completed and results are copied back.
+template<typename Func, typename T>
+void gemm_batched_impl(iclblasHandle_t handle, typename Func::params& params, T* const A[], T* const B[], T* const C[])
+{
+    iclblasContext::validate(handle);
+    const size_t count = params.batchCount;
+    const size_t a_size = static_cast<size_t>(params.lda) * (params.transa == ICLBLAS_OP_N ? params.k : params.m);
+    const size_t b_size = static_cast<size_t>(params.ldb) * (params.transb == ICLBLAS_OP_N ? params.n : params.k);
+    const size_t c_size = static_cast<size_t>(params.ldc) * params.n;
+
+    if (get_device_batch_stride(A, count, a_size, params.strideA)
+        && get_device_batch_stride(B, count, b_size, params.strideB)
+        && get_device_batch_stride(C, count, c_size, params.strideC))
+    {
+        params.A = A[0];
+        params.B = B[0];
+        params.C = C[0];
+        iclblasTemplate_impl<Func>(handle, params);
+        return;
+    }
+
+    // Recorded commands would refer to released gathered matrices
+    if (handle->is_capturing())
+        throw iclgpu::error_unsupported("batch of matrices not equally spaced in device memory");
+
+    std::vector<T> packed_A(count * a_size);
+    std::vector<T> packed_B(count * b_size);
+    std::vector<T> packed_C(count * c_size);
+    for (size_t i = 0; i < count; ++i)
+    {
+        load_elements(A[i], &packed_A[i * a_size], a_size);
+        load_elements(B[i], &packed_B[i * b_size], b_size);
+        load_elements(C[i], &packed_C[i * c_size], c_size);
+    }
+
+    params.A = packed_A.data();
+    params.strideA = a_size;
+    params.B = packed_B.data();
+    params.strideB = b_size;
+    params.C = packed_C.data();
+    params.strideC = c_size;
+    iclblasTemplate_impl<Func>(handle, params);
+    if (auto stream = handle->get_stream())
+        stream->synchronize();
+
+    for (size_t i = 0; i < count; ++i)
+        store_elements(&packed_C[i * c_size], C[i], c_size);
 }
 
 }
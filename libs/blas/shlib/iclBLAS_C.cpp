@@ -42,6 +42,7 @@
 #include "functions/Ctbsv.hpp"
 #include "functions/Ctrsv.hpp"
 #include "functions/Cgemm.hpp"
+#include "functions/CgemmStridedBatched.hpp"
 #include "functions/Csymm.hpp"
 #include "functions/Csyr2k.hpp"
 #include "functions/Csyrk.hpp"
@@ -69,7 +70,7 @@ extern "C"
 iclblasStatus_t iclblasCscal(iclblasHandle_t handle, int n, const oclComplex_t* alpha, oclComplex_t* x, int incx)
 {
     return iclblas::exception_to_iclblas_status([=]() {
-        iclgpu::functions::Cscal::params params = { n, *iclblas::complex_cast(alpha), iclblas::complex_cast(x), incx };
+        iclgpu::functions::Cscal::params params = { n, iclblas::complex_cast(iclblas::get_scalar(handle, alpha)), iclblas::complex_cast(x), incx };
         iclblas::iclblasTemplate_impl<iclgpu::functions::Cscal>(handle, params);
     });
 }
@@ -78,7 +79,7 @@ extern "C"
 iclblasStatus_t iclblasCsscal(iclblasHandle_t handle, int n, const float* alpha, oclComplex_t* x, int incx)
 {
     return iclblas::exception_to_iclblas_status([=]() {
-        iclgpu::functions::Cscal::params params = { n, {*alpha, 0.f }, iclblas::complex_cast(x), incx };
+        iclgpu::functions::Cscal::params params = { n, {iclblas::get_scalar(handle, alpha), 0.f }, iclblas::complex_cast(x), incx };
         iclblas::iclblasTemplate_impl<iclgpu::functions::Cscal>(handle, params);
     });
 }
@@ -98,8 +99,9 @@ iclblasStatus_t iclblasCswap(iclblasHandle_t handle, int n, oclComplex_t * x, in
 extern "C"
 iclblasStatus_t iclblasCdotu(iclblasHandle_t handle, int n, oclComplex_t* x, int incx, oclComplex_t* y, int incy, oclComplex_t* result) {
     if (n <= 0) {
-        *result = 0.f;
-        return ICLBLAS_STATUS_SUCCESS;
+        return iclblas::exception_to_iclblas_status([=]() {
+            iclblas::set_result(handle, result, 0.f);
+        });
     }
 
     return iclblas::exception_to_iclblas_status([=]() {
@@ -123,8 +125,9 @@ iclblasStatus_t iclblasScnrm2(iclblasHandle_t handle, int n, oclComplex_t* x, in
 {
     if (n <= 0 || incx <= 0)
     {
-        *result = 0;
-        return ICLBLAS_STATUS_SUCCESS;
+        return iclblas::exception_to_iclblas_status([=]() {
+            iclblas::set_result(handle, result, 0);
+        });
     }
 
     return iclblas::exception_to_iclblas_status([=]() {
@@ -139,8 +142,9 @@ iclblasStatus_t iclblasIcamax(iclblasHandle_t handle, int n, oclComplex_t* x, in
 {
     if (n <= 0 || incx <= 0)
     {
-        *result = 0;
-        return ICLBLAS_STATUS_SUCCESS;
+        return iclblas::exception_to_iclblas_status([=]() {
+            iclblas::set_result(handle, result, 0);
+        });
     }
 
     return iclblas::exception_to_iclblas_status([=]() {
@@ -154,8 +158,9 @@ iclblasStatus_t iclblasIcamin(iclblasHandle_t handle, int n, oclComplex_t* x, in
 {
     if (n <= 0 || incx <= 0)
     {
-        *result = 0;
-        return ICLBLAS_STATUS_SUCCESS;
+        return iclblas::exception_to_iclblas_status([=]() {
+            iclblas::set_result(handle, result, 0);
+        });
     }
 
     return iclblas::exception_to_iclblas_status([=]() {
@@ -166,12 +171,15 @@ iclblasStatus_t iclblasIcamin(iclblasHandle_t handle, int n, oclComplex_t* x, in
 
 extern "C"
 iclblasStatus_t iclblasCaxpy(iclblasHandle_t handle, int n, const oclComplex_t* alpha, oclComplex_t* x, int incx, oclComplex_t* y, int incy) {
-    if (n <= 0 || *alpha == 0.f) {
+    if (n <= 0) {
         return ICLBLAS_STATUS_SUCCESS;
     }
 
     return iclblas::exception_to_iclblas_status([=]() {
-        iclgpu::functions::Caxpy::params params = { n, iclblas::complex_cast(*alpha), iclblas::complex_cast(x), incx, iclblas::complex_cast(y), incy };
+        const auto alpha_value = iclblas::get_scalar(handle, alpha);
+        if (alpha_value == 0.f)
+            return;
+        iclgpu::functions::Caxpy::params params = { n, iclblas::complex_cast(alpha_value), iclblas::complex_cast(x), incx, iclblas::complex_cast(y), incy };
         iclblas::iclblasTemplate_impl<iclgpu::functions::Caxpy>(handle, params);
     });
 }
@@ -189,14 +197,18 @@ iclblasStatus_t iclblasCrotg(iclblasHandle_t handle, oclComplex_t* a, oclComplex
 extern "C"
 iclblasStatus_t iclblasCgbmv(iclblasHandle_t handle, iclblasOperation_t trans, int m, int n, int kl, int ku, const oclComplex_t* alpha, oclComplex_t * A, int lda, oclComplex_t * x, int incx, const oclComplex_t* beta, oclComplex_t * y, int incy)
 {
-    if (m == 0 || n == 0 || (*alpha == 0.f && *beta == 1.f))
+    if (m == 0 || n == 0)
         return ICLBLAS_STATUS_SUCCESS;
 
     if (m < 0 || n < 0 || incx == 0 || incy == 0)
         return ICLBLAS_STATUS_INVALID_VALUE;
 
     return iclblas::exception_to_iclblas_status([=]() {
-        iclgpu::functions::Cgbmv::params params = { trans, m, n, kl, ku, *iclblas::complex_cast(alpha), iclblas::complex_cast(A), lda, iclblas::complex_cast(x), incx, *iclblas::complex_cast(beta), iclblas::complex_cast(y), incy };
+        const auto alpha_value = iclblas::get_scalar(handle, alpha);
+        const auto beta_value = iclblas::get_scalar(handle, beta);
+        if (alpha_value == 0.f && beta_value == 1.f)
+            return;
+        iclgpu::functions::Cgbmv::params params = { trans, m, n, kl, ku, iclblas::complex_cast(alpha_value), iclblas::complex_cast(A), lda, iclblas::complex_cast(x), incx, iclblas::complex_cast(beta_value), iclblas::complex_cast(y), incy };
         iclblas::iclblasTemplate_impl<iclgpu::functions::Cgbmv>(handle, params);
     });
 
@@ -205,14 +217,17 @@ iclblasStatus_t iclblasCgbmv(iclblasHandle_t handle, iclblasOperation_t trans, i
 extern "C"
 iclblasStatus_t iclblasCgeru(iclblasHandle_t handle, int m, int n, const oclComplex_t* alpha, oclComplex_t * x, int incx, oclComplex_t * y, int incy, oclComplex_t * A, int lda)
 {
-    if (m == 0 || n == 0 || *alpha == 0.f )
+    if (m == 0 || n == 0)
         return ICLBLAS_STATUS_SUCCESS;
 
     if (m < 0 || n < 0 || incx == 0)
         return ICLBLAS_STATUS_INVALID_VALUE;
 
     return iclblas::exception_to_iclblas_status([=]() {
-        iclgpu::functions::Cgeru::params params = { m, n, *iclblas::complex_cast(alpha), iclblas::complex_cast(x), incx, iclblas::complex_cast(y), incy, iclblas::complex_cast(A), lda };
+        const auto alpha_value = iclblas::get_scalar(handle, alpha);
+        if (alpha_value == 0.f)
+            return;
+        iclgpu::functions::Cgeru::params params = { m, n, iclblas::complex_cast(alpha_value), iclblas::complex_cast(x), incx, iclblas::complex_cast(y), incy, iclblas::complex_cast(A), lda };
         iclblas::iclblasTemplate_impl<iclgpu::functions::Cgeru>(handle, params);
     });
 }
@@ -220,14 +235,17 @@ iclblasStatus_t iclblasCgeru(iclblasHandle_t handle, int m, int n, const oclComp
 extern "C"
 iclblasStatus_t iclblasCgerc(iclblasHandle_t handle, int m, int n, const oclComplex_t* alpha, oclComplex_t * x, int incx, oclComplex_t * y, int incy, oclComplex_t * A, int lda)
 {
-    if (m == 0 || n == 0 || *alpha == 0.f )
+    if (m == 0 || n == 0)
         return ICLBLAS_STATUS_SUCCESS;
 
     if (m < 0 || n < 0 || incx == 0)
         return ICLBLAS_STATUS_INVALID_VALUE;
 
     return iclblas::exception_to_iclblas_status([=]() {
-        iclgpu::functions::Cgerc::params params = { m, n, *iclblas::complex_cast(alpha), iclblas::complex_cast(x), incx, iclblas::complex_cast(y), incy, iclblas::complex_cast(A), lda };
+        const auto alpha_value = iclblas::get_scalar(handle, alpha);
+        if (alpha_value == 0.f)
+            return;
+        iclgpu::functions::Cgerc::params params = { m, n, iclblas::complex_cast(alpha_value), iclblas::complex_cast(x), incx, iclblas::complex_cast(y), incy, iclblas::complex_cast(A), lda };
         iclblas::iclblasTemplate_impl<iclgpu::functions::Cgerc>(handle, params);
     });
 }
@@ -235,14 +253,18 @@ iclblasStatus_t iclblasCgerc(iclblasHandle_t handle, int m, int n, const oclComp
 extern "C"
 iclblasStatus_t iclblasCgemv(iclblasHandle_t handle, iclblasOperation_t trans, int m, int n, const oclComplex_t* alpha, oclComplex_t* A, int lda, oclComplex_t* x, int incx, const oclComplex_t* beta, oclComplex_t* y, int incy)
 {
-    if (m == 0 || n == 0 || (*alpha == 0.f && *beta == 1.f))
+    if (m == 0 || n == 0)
         return ICLBLAS_STATUS_SUCCESS;
 
     if (m < 0 || n < 0 || incx == 0 || incy == 0)
         return ICLBLAS_STATUS_INVALID_VALUE;
 
     return iclblas::exception_to_iclblas_status([=]() {
-        iclgpu::functions::Cgemv::params params = { trans, m, n, *iclblas::complex_cast(alpha), iclblas::complex_cast(A), lda, iclblas::complex_cast(x), incx, *iclblas::complex_cast(beta), iclblas::complex_cast(y), incy };
+        const auto alpha_value = iclblas::get_scalar(handle, alpha);
+        const auto beta_value = iclblas::get_scalar(handle, beta);
+        if (alpha_value == 0.f && beta_value == 1.f)
+            return;
+        iclgpu::functions::Cgemv::params params = { trans, m, n, iclblas::complex_cast(alpha_value), iclblas::complex_cast(A), lda, iclblas::complex_cast(x), incx, iclblas::complex_cast(beta_value), iclblas::complex_cast(y), incy };
         iclblas::iclblasTemplate_impl<iclgpu::functions::Cgemv>(handle, params);
     });
 }
@@ -250,14 +272,17 @@ iclblasStatus_t iclblasCgemv(iclblasHandle_t handle, iclblasOperation_t trans, i
 extern "C"
 iclblasStatus_t iclblasCher(iclblasHandle_t handle, iclblasFillMode_t uplo, int n, const float* alpha, oclComplex_t* x, int incx, oclComplex_t* A, int lda)
 {
-    if (n == 0 || *alpha == 0.f)
+    if (n == 0)
         return ICLBLAS_STATUS_SUCCESS;
 
     if (n < 0 || incx == 0)
         return ICLBLAS_STATUS_INVALID_VALUE;
 
     return iclblas::exception_to_iclblas_status([=]() {
-        iclgpu::functions::Cher::params params = {uplo,  n, *alpha, iclblas::complex_cast(x), incx, iclblas::complex_cast(A), lda };
+        const auto alpha_value = iclblas::get_scalar(handle, alpha);
+        if (alpha_value == 0.f)
+            return;
+        iclgpu::functions::Cher::params params = {uplo,  n, alpha_value, iclblas::complex_cast(x), incx, iclblas::complex_cast(A), lda };
         iclblas::iclblasTemplate_impl<iclgpu::functions::Cher>(handle, params);
     });
 }
@@ -265,14 +290,18 @@ iclblasStatus_t iclblasCher(iclblasHandle_t handle, iclblasFillMode_t uplo, int
 extern "C"
 iclblasStatus_t iclblasChemv(iclblasHandle_t handle, iclblasFillMode_t uplo, int n, const oclComplex_t* alpha, oclComplex_t* A, int lda, oclComplex_t* x, int incx, const oclComplex_t* beta, oclComplex_t* y, int incy)
 {
-    if (n == 0 || (*alpha == 0.f && *beta == 1.f))
+    if (n == 0)
         return ICLBLAS_STATUS_SUCCESS;
 
     if (n < 0 || incx == 0 || incy == 0)
         return ICLBLAS_STATUS_INVALID_VALUE;
 
     return iclblas::exception_to_iclblas_status([=]() {
-        iclgpu::functions::Chemv::params params = { uplo, n, *iclblas::complex_cast(alpha), iclblas::complex_cast(A), lda, iclblas::complex_cast(x), incx, *iclblas::complex_cast(beta), iclblas::complex_cast(y), incy };
+        const auto alpha_value = iclblas::get_scalar(handle, alpha);
+        const auto beta_value = iclblas::get_scalar(handle, beta);
+        if (alpha_value == 0.f && beta_value == 1.f)
+            return;
+        iclgpu::functions::Chemv::params params = { uplo, n, iclblas::complex_cast(alpha_value), iclblas::complex_cast(A), lda, iclblas::complex_cast(x), incx, iclblas::complex_cast(beta_value), iclblas::complex_cast(y), incy };
         iclblas::iclblasTemplate_impl<iclgpu::functions::Chemv>(handle, params);
     });
 }
@@ -296,8 +325,9 @@ iclblasStatus_t iclblasCtrmv(iclblasHandle_t handle, iclblasFillMode_t uplo, icl
 extern "C"
 iclblasStatus_t iclblasCdotc(iclblasHandle_t handle, int n, oclComplex_t* x, int incx, oclComplex_t* y, int incy, oclComplex_t* result) {
     if (n <= 0) {
-        *result = 0.f;
-        return ICLBLAS_STATUS_SUCCESS;
+        return iclblas::exception_to_iclblas_status([=]() {
+            iclblas::set_result(handle, result, 0.f);
+        });
     }
 
     return iclblas::exception_to_iclblas_status([=]() {
@@ -310,11 +340,15 @@ iclblasStatus_t iclblasCdotc(iclblasHandle_t handle, int n, oclComplex_t* x, int
 extern "C"
 iclblasStatus_t iclblasCrot(iclblasHandle_t handle, int n, oclComplex_t* x, int incx, oclComplex_t* y, int incy, const float* c, const oclComplex_t* s)
 {
-    if (n <= 0 || (*c == 1 && *s == 0.f))
+    if (n <= 0)
         return ICLBLAS_STATUS_SUCCESS;
 
     return iclblas::exception_to_iclblas_status([=]() {
-        iclgpu::functions::Crot::params params = { n, iclblas::complex_cast(x), incx, iclblas::complex_cast(y), incy, *c, iclblas::complex_cast(*s) };
+        const auto c_value = iclblas::get_scalar(handle, c);
+        const auto s_value = iclblas::get_scalar(handle, s);
+        if (c_value == 1 && s_value == 0.f)
+            return;
+        iclgpu::functions::Crot::params params = { n, iclblas::complex_cast(x), incx, iclblas::complex_cast(y), incy, c_value, iclblas::complex_cast(s_value) };
         iclblas::iclblasTemplate_impl<iclgpu::functions::Crot>(handle, params);
     });
 }
@@ -323,11 +357,15 @@ iclblasStatus_t iclblasCrot(iclblasHandle_t handle, int n, oclComplex_t* x, int
 extern "C"
 iclblasStatus_t iclblasCsrot(iclblasHandle_t handle, int n, oclComplex_t* x, int incx, oclComplex_t* y, int incy, const float* c, const float* s)
 {
-    if (n <= 0 || (*c == 1 && *s == 0))
+    if (n <= 0)
         return ICLBLAS_STATUS_SUCCESS;
 
     return iclblas::exception_to_iclblas_status([=]() {
-        iclgpu::functions::Csrot::params params = { n, iclblas::complex_cast(x), incx, iclblas::complex_cast(y), incy, *c, *s };
+        const auto c_value = iclblas::get_scalar(handle, c);
+        const auto s_value = iclblas::get_scalar(handle, s);
+        if (c_value == 1 && s_value == 0)
+            return;
+        iclgpu::functions::Csrot::params params = { n, iclblas::complex_cast(x), incx, iclblas::complex_cast(y), incy, c_value, s_value };
         iclblas::iclblasTemplate_impl<iclgpu::functions::Csrot>(handle, params);
     });
 }
@@ -335,14 +373,17 @@ iclblasStatus_t iclblasCsrot(iclblasHandle_t handle, int n, oclComplex_t* x, int
 extern "C"
 iclblasStatus_t iclblasCher2(iclblasHandle_t handle, iclblasFillMode_t uplo, int n, const oclComplex_t* alpha, oclComplex_t* x, int incx, oclComplex_t* y, int incy, oclComplex_t* A, int lda)
 {
-    if (n == 0 || *alpha == 0.f )
+    if (n == 0)
         return ICLBLAS_STATUS_SUCCESS;
 
     if (n < 0 || incx == 0 || incy == 0)
         return ICLBLAS_STATUS_INVALID_VALUE;
 
     return iclblas::exception_to_iclblas_status([=]() {
-        iclgpu::functions::Cher2::params params = { uplo, n, iclblas::complex_cast(*alpha), iclblas::complex_cast(x), incx, iclblas::complex_cast(y), incy, iclblas::complex_cast(A), lda };
+        const auto alpha_value = iclblas::get_scalar(handle, alpha);
+        if (alpha_value == 0.f)
+            return;
+        iclgpu::functions::Cher2::params params = { uplo, n, iclblas::complex_cast(alpha_value), iclblas::complex_cast(x), incx, iclblas::complex_cast(y), incy, iclblas::complex_cast(A), lda };
         iclblas::iclblasTemplate_impl<iclgpu::functions::Cher2>(handle, params);
     });
 }
@@ -350,15 +391,19 @@ iclblasStatus_t iclblasCher2(iclblasHandle_t handle, iclblasFillMode_t uplo, int
 extern "C"
 iclblasStatus_t iclblasChpmv(iclblasHandle_t handle, iclblasFillMode_t uplo, int n, const oclComplex_t* alpha, oclComplex_t* AP, oclComplex_t* x, int incx, const oclComplex_t* beta, oclComplex_t* y, int incy)
 {
-    if (n == 0 || (*alpha == 0.f && *beta == 1.f))
+    if (n == 0)
         return ICLBLAS_STATUS_SUCCESS;
 
     if (n < 0 || incx == 0 || incy == 0)
         return ICLBLAS_STATUS_INVALID_VALUE;
 
     return iclblas::exception_to_iclblas_status([=]() {
-        iclgpu::functions::Chpmv::params params = { uplo, n, iclblas::complex_cast(*alpha), iclblas::complex_cast(AP), iclblas::complex_cast(x), incx,
-            iclblas::complex_cast(*beta), iclblas::complex_cast(y), incy };
+        const auto alpha_value = iclblas::get_scalar(handle, alpha);
+        const auto beta_value = iclblas::get_scalar(handle, beta);
+        if (alpha_value == 0.f && beta_value == 1.f)
+            return;
+        iclgpu::functions::Chpmv::params params = { uplo, n, iclblas::complex_cast(alpha_value), iclblas::complex_cast(AP), iclblas::complex_cast(x), incx,
+            iclblas::complex_cast(beta_value), iclblas::complex_cast(y), incy };
         iclblas::iclblasTemplate_impl<iclgpu::functions::Chpmv>(handle, params);
     });
 }
@@ -366,14 +411,17 @@ iclblasStatus_t iclblasChpmv(iclblasHandle_t handle, iclblasFillMode_t uplo, int
 extern "C"
 iclblasStatus_t iclblasChpr(iclblasHandle_t handle, iclblasFillMode_t uplo, int n, const float* alpha, oclComplex_t*x, int incx, oclComplex_t* AP)
 {
-    if (n == 0 || *alpha == 0.f)
+    if (n == 0)
         return ICLBLAS_STATUS_SUCCESS;
 
     if (n < 0 || incx == 0)
         return ICLBLAS_STATUS_INVALID_VALUE;
 
     return iclblas::exception_to_iclblas_status([=]() {
-        iclgpu::functions::Chpr::params params = { uplo, n, *alpha, iclblas::complex_cast(x), incx, iclblas::complex_cast(AP) };
+        const auto alpha_value = iclblas::get_scalar(handle, alpha);
+        if (alpha_value == 0.f)
+            return;
+        iclgpu::functions::Chpr::params params = { uplo, n, alpha_value, iclblas::complex_cast(x), incx, iclblas::complex_cast(AP) };
         iclblas::iclblasTemplate_impl<iclgpu::functions::Chpr>(handle, params);
     });
 }
@@ -381,14 +429,17 @@ iclblasStatus_t iclblasChpr(iclblasHandle_t handle, iclblasFillMode_t uplo, int
 extern "C"
 iclblasStatus_t iclblasChpr2(iclblasHandle_t handle, iclblasFillMode_t uplo, int n, const oclComplex_t* alpha, oclComplex_t* x, int incx, oclComplex_t* y, int incy, oclComplex_t* AP)
 {
-    if (n == 0 || *alpha == 0.f )
+    if (n == 0)
         return ICLBLAS_STATUS_SUCCESS;
 
     if (n < 0 || incx == 0 || incy == 0)
         return ICLBLAS_STATUS_INVALID_VALUE;
 
     return iclblas::exception_to_iclblas_status([=]() {
-        iclgpu::functions::Chpr2::params params = { uplo, n, iclblas::complex_cast(*alpha), iclblas::complex_cast(x), incx, iclblas::complex_cast(y), incy, iclblas::complex_cast(AP) };
+        const auto alpha_value = iclblas::get_scalar(handle, alpha);
+        if (alpha_value == 0.f)
+            return;
+        iclgpu::functions::Chpr2::params params = { uplo, n, iclblas::complex_cast(alpha_value), iclblas::complex_cast(x), incx, iclblas::complex_cast(y), incy, iclblas::complex_cast(AP) };
         iclblas::iclblasTemplate_impl<iclgpu::functions::Chpr2>(handle, params);
     });
 }
@@ -463,46 +514,88 @@ iclblasStatus_t iclblasCgemm(iclblasHandle_t handle, iclblasOperation_t transa,
         return ICLBLAS_STATUS_INVALID_VALUE;
 
     return iclblas::exception_to_iclblas_status([=]() {
-        iclgpu::functions::Cgemm::params params = { transa, transb, m, n, k, iclblas::complex_cast(*alpha), iclblas::complex_cast(A), lda, iclblas::complex_cast(B), ldb, iclblas::complex_cast(*beta), iclblas::complex_cast(C), ldc };
+        iclgpu::functions::Cgemm::params params = { transa, transb, m, n, k, iclblas::complex_cast(iclblas::get_scalar(handle, alpha)), iclblas::complex_cast(A), lda, iclblas::complex_cast(B), ldb, iclblas::complex_cast(iclblas::get_scalar(handle, beta)), iclblas::complex_cast(C), ldc };
         iclblas::iclblasTemplate_impl<iclgpu::functions::Cgemm>(handle, params);
     });
 }
 
+extern "C"
+iclblasStatus_t iclblasCgemmStridedBatched(iclblasHandle_t handle, iclblasOperation_t transa, iclblasOperation_t transb, int m, int n, int k, const oclComplex_t* alpha, oclComplex_t* A, int lda, long long strideA, oclComplex_t* B, int ldb, long long strideB, const oclComplex_t* beta, oclComplex_t* C, int ldc, long long strideC, int batchCount)
+{
+    if (m < 0 || n < 0 || k < 0 || batchCount < 0 || strideA < 0 || strideB < 0 || strideC < 0)
+        return ICLBLAS_STATUS_INVALID_VALUE;
+
+    return iclblas::exception_to_iclblas_status([=]() {
+        iclgpu::functions::CgemmStridedBatched::params params = { transa, transb, m, n, k, iclblas::complex_cast(iclblas::get_scalar(handle, alpha)), iclblas::complex_cast(A), lda, strideA,
+            iclblas::complex_cast(B), ldb, strideB, iclblas::complex_cast(iclblas::get_scalar(handle, beta)), iclblas::complex_cast(C), ldc, strideC, batchCount };
+        iclblas::iclblasTemplate_impl<iclgpu::functions::CgemmStridedBatched>(handle, params);
+    });
+}
+
+extern "C"
+iclblasStatus_t iclblasCgemmBatched(iclblasHandle_t handle, iclblasOperation_t transa, iclblasOperation_t transb, int m, int n, int k, const oclComplex_t* alpha, oclComplex_t* const Aarray[], int lda, oclComplex_t* const Barray[], int ldb, const oclComplex_t* beta, oclComplex_t* const Carray[], int ldc, int batchCount)
+{
+    if (m < 0 || n < 0 || k < 0 || batchCount < 0)
+        return ICLBLAS_STATUS_INVALID_VALUE;
+    if (m == 0 || n == 0 || batchCount == 0)
+        return ICLBLAS_STATUS_SUCCESS;
+    if (Aarray == nullptr || Barray == nullptr || Carray == nullptr)
+        return ICLBLAS_STATUS_INVALID_VALUE;
+
+    return iclblas::exception_to_iclblas_status([=]() {
+        iclgpu::functions::CgemmStridedBatched::params params = { transa, transb, m, n, k, iclblas::complex_cast(iclblas::get_scalar(handle, alpha)), iclblas::complex_cast(Aarray[0]), lda, 0,
+            iclblas::complex_cast(Barray[0]), ldb, 0, iclblas::complex_cast(iclblas::get_scalar(handle, beta)), iclblas::complex_cast(Carray[0]), ldc, 0, batchCount };
+        iclblas::gemm_batched_impl<iclgpu::functions::CgemmStridedBatched>(handle, params, Aarray, Barray, Carray);
+    });
+}
+
 extern "C"
 iclblasStatus_t iclblasCsymm(iclblasHandle_t handle, iclblasSideMode_t side, iclblasFillMode_t uplo, int m, int n, const oclComplex_t* alpha, oclComplex_t* A, int lda, oclComplex_t* B, int ldb, const oclComplex_t* beta, oclComplex_t* C, int ldc) {
-    if (n == 0 || m == 0 || (*alpha == 0.f && *beta == 1.f)) {
+    if (n == 0 || m == 0) {
         return ICLBLAS_STATUS_SUCCESS;
     }
 
     return iclblas::exception_to_iclblas_status([=]() {
-        iclgpu::functions::Csymm::params params = { side, uplo, m, n, iclblas::complex_cast(*alpha), iclblas::complex_cast(A), lda,
-            iclblas::complex_cast(B), ldb, iclblas::complex_cast(*beta), iclblas::complex_cast(C), ldc };
+        const auto alpha_value = iclblas::get_scalar(handle, alpha);
+        const auto beta_value = iclblas::get_scalar(handle, beta);
+        if (alpha_value == 0.f && beta_value == 1.f)
+            return;
+        iclgpu::functions::Csymm::params params = { side, uplo, m, n, iclblas::complex_cast(alpha_value), iclblas::complex_cast(A), lda,
+            iclblas::complex_cast(B), ldb, iclblas::complex_cast(beta_value), iclblas::complex_cast(C), ldc };
         iclblas::iclblasTemplate_impl<iclgpu::functions::Csymm>(handle, params);
     });
 }
 
 extern "C"
 iclblasStatus_t iclblasCsyr2k(iclblasHandle_t handle, iclblasFillMode_t uplo, iclblasOperation_t trans, int n, int k, const oclComplex_t* alpha, oclComplex_t* A, int lda, oclComplex_t* B, int ldb, const oclComplex_t* beta, oclComplex_t* C, int ldc) {
-    if (n == 0 || k == 0 || (*alpha == 0.f && *beta == 1.f)) {
+    if (n == 0 || k == 0) {
         return ICLBLAS_STATUS_SUCCESS;
     }
 
     return iclblas::exception_to_iclblas_status([=]() {
-        iclgpu::functions::Csyr2k::params params = { uplo, trans, n, k, iclblas::complex_cast(*alpha), iclblas::complex_cast(A), lda,
-            iclblas::complex_cast(B), ldb, iclblas::complex_cast(*beta), iclblas::complex_cast(C), ldc };
+        const auto alpha_value = iclblas::get_scalar(handle, alpha);
+        const auto beta_value = iclblas::get_scalar(handle, beta);
+        if (alpha_value == 0.f && beta_value == 1.f)
+            return;
+        iclgpu::functions::Csyr2k::params params = { uplo, trans, n, k, iclblas::complex_cast(alpha_value), iclblas::complex_cast(A), lda,
+            iclblas::complex_cast(B), ldb, iclblas::complex_cast(beta_value), iclblas::complex_cast(C), ldc };
         iclblas::iclblasTemplate_impl<iclgpu::functions::Csyr2k>(handle, params);
     });
 }
 
 extern "C"
 iclblasStatus_t iclblasCsyrk(iclblasHandle_t handle, iclblasFillMode_t uplo, iclblasOperation_t trans, int n, int k, const oclComplex_t* alpha, oclComplex_t* A, int lda, const oclComplex_t* beta, oclComplex_t* C, int ldc) {
-    if (n == 0 || k == 0 || (*alpha == 0.f && *beta == 1.f)) {
+    if (n == 0 || k == 0) {
         return ICLBLAS_STATUS_SUCCESS;
     }
 
     return iclblas::exception_to_iclblas_status([=]() {
-        iclgpu::functions::Csyrk::params params = { uplo, trans, n, k, iclblas::complex_cast(*alpha), iclblas::complex_cast(A), lda,
-            iclblas::complex_cast(*beta), iclblas::complex_cast(C), ldc };
+        const auto alpha_value = iclblas::get_scalar(handle, alpha);
+        const auto beta_value = iclblas::get_scalar(handle, beta);
+        if (alpha_value == 0.f && beta_value == 1.f)
+            return;
+        iclgpu::functions::Csyrk::params params = { uplo, trans, n, k, iclblas::complex_cast(alpha_value), iclblas::complex_cast(A), lda,
+            iclblas::complex_cast(beta_value), iclblas::complex_cast(C), ldc };
         iclblas::iclblasTemplate_impl<iclgpu::functions::Csyrk>(handle, params);
     });
 }
@@ -529,7 +622,7 @@ iclblasStatus_t iclblasCtrsm(iclblasHandle_t handle, iclblasSideMode_t side, icl
     }
 
     return iclblas::exception_to_iclblas_status([=]() {
-        iclgpu::functions::Ctrsm::params params = { side, uplo, trans, diag, m, n, iclblas::complex_cast(*alpha), iclblas::complex_cast(A), lda, iclblas::complex_cast(B), ldb };
+        iclgpu::functions::Ctrsm::params params = { side, uplo, trans, diag, m, n, iclblas::complex_cast(iclblas::get_scalar(handle, alpha)), iclblas::complex_cast(A), lda, iclblas::complex_cast(B), ldb };
         iclblas::iclblasTemplate_impl<iclgpu::functions::Ctrsm>(handle, params);
     });
 }
@@ -542,7 +635,7 @@ iclblasStatus_t iclblasCherk(iclblasHandle_t handle, iclblasFillMode_t uplo, icl
         return ICLBLAS_STATUS_INVALID_VALUE;
 
     return iclblas::exception_to_iclblas_status([=]() {
-        iclgpu::functions::Cherk::params params = { uplo, trans, n, k, *alpha, iclblas::complex_cast(A), lda, *beta, iclblas::complex_cast(C), ldc };
+        iclgpu::functions::Cherk::params params = { uplo, trans, n, k, iclblas::get_scalar(handle, alpha), iclblas::complex_cast(A), lda, iclblas::get_scalar(handle, beta), iclblas::complex_cast(C), ldc };
         iclblas::iclblasTemplate_impl<iclgpu::functions::Cherk>(handle, params);
     });
 }
@@ -555,7 +648,7 @@ iclblasStatus_t iclblasCher2k(iclblasHandle_t handle, iclblasFillMode_t uplo, ic
         return ICLBLAS_STATUS_INVALID_VALUE;
 
     return iclblas::exception_to_iclblas_status([=]() {
-        iclgpu::functions::Cher2k::params params = { uplo, trans, n, k, iclblas::complex_cast(*alpha), iclblas::complex_cast(A), lda, iclblas::complex_cast(B), ldb, *beta, iclblas::complex_cast(C), ldc };
+        iclgpu::functions::Cher2k::params params = { uplo, trans, n, k, iclblas::complex_cast(iclblas::get_scalar(handle, alpha)), iclblas::complex_cast(A), lda, iclblas::complex_cast(B), ldb, iclblas::get_scalar(handle, beta), iclblas::complex_cast(C), ldc };
         iclblas::iclblasTemplate_impl<iclgpu::functions::Cher2k>(handle, params);
     });
 }
@@ -569,20 +662,24 @@ iclblasStatus_t iclblasCtrmm(iclblasHandle_t handle, iclblasSideMode_t side, icl
         return ICLBLAS_STATUS_SUCCESS;
 
     return iclblas::exception_to_iclblas_status([=]() {
-        iclgpu::functions::Ctrmm::params params = { side, uplo, transa, diag, m, n, iclblas::complex_cast(*alpha), iclblas::complex_cast(A), lda, iclblas::complex_cast(B), ldb, iclblas::complex_cast(C), ldc };
+        iclgpu::functions::Ctrmm::params params = { side, uplo, transa, diag, m, n, iclblas::complex_cast(iclblas::get_scalar(handle, alpha)), iclblas::complex_cast(A), lda, iclblas::complex_cast(B), ldb, iclblas::complex_cast(C), ldc };
         iclblas::iclblasTemplate_impl<iclgpu::functions::Ctrmm>(handle, params);
     });
 }
 
 extern "C"
 iclblasStatus_t iclblasChemm(iclblasHandle_t handle, iclblasSideMode_t side, iclblasFillMode_t uplo, int m, int n, const oclComplex_t* alpha, oclComplex_t* A, int lda, oclComplex_t* B, int ldb, const oclComplex_t* beta, oclComplex_t* C, int ldc) {
-    if (m == 0 || n == 0 || (*alpha == 0.f && *beta == 1.f)) {
+    if (m == 0 || n == 0) {
         return ICLBLAS_STATUS_SUCCESS;
     }
 
     return iclblas::exception_to_iclblas_status([=]() {
-        iclgpu::functions::Chemm::params params = { side, uplo, m, n, iclblas::complex_cast(*alpha), iclblas::complex_cast(A), lda,
-            iclblas::complex_cast(B), ldb, iclblas::complex_cast(*beta), iclblas::complex_cast(C), ldc };
+        const auto alpha_value = iclblas::get_scalar(handle, alpha);
+        const auto beta_value = iclblas::get_scalar(handle, beta);
+        if (alpha_value == 0.f && beta_value == 1.f)
+            return;
+        iclgpu::functions::Chemm::params params = { side, uplo, m, n, iclblas::complex_cast(alpha_value), iclblas::complex_cast(A), lda,
+            iclblas::complex_cast(B), ldb, iclblas::complex_cast(beta_value), iclblas::complex_cast(C), ldc };
         iclblas::iclblasTemplate_impl<iclgpu::functions::Chemm>(handle, params);
     });
 }
@@ -590,28 +687,35 @@ iclblasStatus_t iclblasChemm(iclblasHandle_t handle, iclblasSideMode_t side, icl
 extern "C"
 iclblasStatus_t iclblasChbmv(iclblasHandle_t handle, iclblasFillMode_t uplo, int n, int k, const oclComplex_t* alpha, oclComplex_t* A, int lda, oclComplex_t* x, int incx, const oclComplex_t* beta, oclComplex_t* y, int incy)
 {
-    if (n == 0 || (*alpha == 0.f && *beta == 1.f))
+    if (n == 0)
         return ICLBLAS_STATUS_SUCCESS;
 
     if (n < 0 || k < 0 || incx == 0 || incy == 0)
         return ICLBLAS_STATUS_INVALID_VALUE;
 
     return iclblas::exception_to_iclblas_status([=]() {
-        iclgpu::functions::Chbmv::params params = { uplo, n, k, *iclblas::complex_cast(alpha), iclblas::complex_cast(A), lda, iclblas::complex_cast(x), incx, *iclblas::complex_cast(beta), iclblas::complex_cast(y), incy };
+        const auto alpha_value = iclblas::get_scalar(handle, alpha);
+        const auto beta_value = iclblas::get_scalar(handle, beta);
+        if (alpha_value == 0.f && beta_value == 1.f)
+            return;
+        iclgpu::functions::Chbmv::params params = { uplo, n, k, iclblas::complex_cast(alpha_value), iclblas::complex_cast(A), lda, iclblas::complex_cast(x), incx, iclblas::complex_cast(beta_value), iclblas::complex_cast(y), incy };
         iclblas::iclblasTemplate_impl<iclgpu::functions::Chbmv>(handle, params);
     });
 }
 
 extern "C"
 iclblasStatus_t iclblasCsyr(iclblasHandle_t handle, iclblasFillMode_t uplo, int n, const oclComplex_t* alpha, oclComplex_t* x, int incx, oclComplex_t* A, int lda) {
-    if (n == 0 || *alpha == 0.f)
+    if (n == 0)
         return ICLBLAS_STATUS_SUCCESS;
 
     if (n < 0 || incx == 0)
         return ICLBLAS_STATUS_INVALID_VALUE;
 
     return iclblas::exception_to_iclblas_status([=]() {
-        iclgpu::functions::Csyr::params params = { uplo, n, iclblas::complex_cast(*alpha), iclblas::complex_cast(x), incx, iclblas::complex_cast(A), lda };
+        const auto alpha_value = iclblas::get_scalar(handle, alpha);
+        if (alpha_value == 0.f)
+            return;
+        iclgpu::functions::Csyr::params params = { uplo, n, iclblas::complex_cast(alpha_value), iclblas::complex_cast(x), incx, iclblas::complex_cast(A), lda };
         iclblas::iclblasTemplate_impl<iclgpu::functions::Csyr>(handle, params);
     });
 }
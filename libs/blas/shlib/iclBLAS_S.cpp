@@ -15,7 +15,9 @@
 #include "iclBLAS.h"
 #include "functions/copy_interleave.hpp"
 #include "functions/Sscal.hpp"
+#include "functions/Sscal_device_scalar.hpp"
 #include "functions/Saxpy.hpp"
+#include "functions/Saxpy_device_scalar.hpp"
 #include "functions/Snrm2.hpp"
 #include "functions/Srotmg.hpp"
 #include "functions/Isamax.hpp"
@@ -46,6 +48,9 @@
 #include "functions/Ssymv.hpp"
 #include "functions/Sgemv.hpp"
 #include "functions/Sgemm.hpp"
+#include "functions/SgemmStridedBatched.hpp"
+#include "functions/SgemvStridedBatched.hpp"
+#include "functions/StrsvStridedBatched.hpp"
 #include "functions/Strsm.hpp"
 #include "functions/Strmm.hpp"
 
@@ -65,8 +70,17 @@ iclblasStatus_t iclblasScopy(iclblasHandle_t handle, int n, float* x, int incx,
 extern "C"
 iclblasStatus_t iclblasSscal(iclblasHandle_t handle, int n, const float* alpha, float *x, int incx)
 {
+    if (iclblas::is_device_scalar(handle, alpha))
+    {
+        // Scalar is read by the kernel, there is no need to wait for preceding calls
+        return iclblas::exception_to_iclblas_status([=]() {
+            iclgpu::functions::Sscal_device_scalar::params params = { n, const_cast<float*>(alpha), x, incx };
+            iclblas::iclblasTemplate_impl<iclgpu::functions::Sscal_device_scalar>(handle, params);
+        });
+    }
+
     return iclblas::exception_to_iclblas_status([=]() {
-        iclgpu::functions::Sscal::params params = { n, *alpha, x, incx };
+        iclgpu::functions::Sscal::params params = { n, iclblas::get_scalar(handle, alpha), x, incx };
         iclblas::iclblasTemplate_impl<iclgpu::functions::Sscal>(handle, params);
     });
 }
@@ -74,11 +88,23 @@ iclblasStatus_t iclblasSscal(iclblasHandle_t handle, int n, const float* alpha,
 extern "C"
 iclblasStatus_t iclblasSaxpy(iclblasHandle_t handle, int n, const float* alpha, float * x, int incx, float * y, int incy)
 {
-    if (n <= 0 || *alpha == 0.f)
+    if (n <= 0)
         return ICLBLAS_STATUS_SUCCESS;
 
+    if (iclblas::is_device_scalar(handle, alpha))
+    {
+        // Scalar is read by the kernel, there is no need to wait for preceding calls
+        return iclblas::exception_to_iclblas_status([=]() {
+            iclgpu::functions::Saxpy_device_scalar::params params = { n, const_cast<float*>(alpha), x, incx, y, incy };
+            iclblas::iclblasTemplate_impl<iclgpu::functions::Saxpy_device_scalar>(handle, params);
+        });
+    }
+
     return iclblas::exception_to_iclblas_status([=]() {
-        iclgpu::functions::Saxpy::params params = { n, *alpha, x, incx, y, incy };
+        const auto alpha_value = iclblas::get_scalar(handle, alpha);
+        if (alpha_value == 0.f)
+            return;
+        iclgpu::functions::Saxpy::params params = { n, alpha_value, x, incx, y, incy };
         iclblas::iclblasTemplate_impl<iclgpu::functions::Saxpy>(handle, params);
     });
 }
@@ -87,8 +113,9 @@ extern "C"
 iclblasStatus_t iclblasSnrm2(iclblasHandle_t handle, int n, float * x, int incx, float * result)
 {
     if (n <= 0 || incx <= 0) {
-        result[0] = 0.f;
-        return ICLBLAS_STATUS_SUCCESS;
+        return iclblas::exception_to_iclblas_status([=]() {
+            iclblas::set_result(handle, result, 0.f);
+        });
     }
 
     return iclblas::exception_to_iclblas_status([=]() {
@@ -138,8 +165,9 @@ iclblasStatus_t iclblasIsamax(iclblasHandle_t handle, int n, float* x, int incx,
 {
     if (n <= 0 || incx <= 0)
     {
-        *result = 0;
-        return ICLBLAS_STATUS_SUCCESS;
+        return iclblas::exception_to_iclblas_status([=]() {
+            iclblas::set_result(handle, result, 0);
+        });
     }
 
     return iclblas::exception_to_iclblas_status([=]() {
@@ -153,8 +181,9 @@ iclblasStatus_t iclblasIsamin(iclblasHandle_t handle, int n, float* x, int incx,
 {
     if (n <= 0 || incx <= 0)
     {
-        *result = 0;
-        return ICLBLAS_STATUS_SUCCESS;
+        return iclblas::exception_to_iclblas_status([=]() {
+            iclblas::set_result(handle, result, 0);
+        });
     }
 
     return iclblas::exception_to_iclblas_status([=]() {
@@ -205,8 +234,9 @@ iclblasStatus_t iclblasSasum(iclblasHandle_t handle, int n, float* x, int incx,
 {
     if (n <= 0 || incx <= 0)
     {
-        result[0] = 0.f;
-        return ICLBLAS_STATUS_SUCCESS;
+        return iclblas::exception_to_iclblas_status([=]() {
+            iclblas::set_result(handle, result, 0.f);
+        });
     }
 
     return iclblas::exception_to_iclblas_status([=]() {
@@ -250,6 +280,20 @@ iclblasStatus_t iclblasStrsv(iclblasHandle_t handle, iclblasFillMode_t uplo, icl
 
 }
 
+extern "C"
+iclblasStatus_t iclblasStrsvStridedBatched(iclblasHandle_t handle, iclblasFillMode_t uplo, iclblasOperation_t trans, iclblasDiagType_t diag, int n, float* A, int lda, long long strideA, float* x, int incx, long long stridex, int batchCount)
+{
+    if (n < 0 || incx <= 0 || batchCount < 0 || strideA < 0 || stridex < 0)
+        return ICLBLAS_STATUS_INVALID_VALUE;
+    if (n == 0 || batchCount == 0)
+        return ICLBLAS_STATUS_SUCCESS;
+
+    return iclblas::exception_to_iclblas_status([=]() {
+        iclgpu::functions::StrsvStridedBatched::params params = { uplo, trans, diag, n, A, lda, strideA, x, incx, stridex, batchCount };
+        iclblas::iclblasTemplate_impl<iclgpu::functions::StrsvStridedBatched>(handle, params);
+    });
+}
+
 extern "C"
 iclblasStatus_t iclblasStbsv(iclblasHandle_t handle, iclblasFillMode_t uplo, iclblasOperation_t trans, iclblasDiagType_t diag, int n, int k, float * A, int lda, float * x, int incx)
 {
@@ -277,12 +321,15 @@ iclblasStatus_t iclblasStpsv(iclblasHandle_t handle, iclblasFillMode_t uplo, icl
 
 extern "C"
 iclblasStatus_t iclblasSger(iclblasHandle_t handle, int m, int n, const float* alpha, float* x, int incx, float* y, int incy, float* A, int lda) {
-    if (m == 0 || n == 0 || alpha[0] == 0.f) return ICLBLAS_STATUS_SUCCESS;
+    if (m == 0 || n == 0) return ICLBLAS_STATUS_SUCCESS;
 
     if (m < 0 || n < 0 || incx == 0 || incy == 0) return ICLBLAS_STATUS_INVALID_VALUE;
 
     return iclblas::exception_to_iclblas_status([=]() {
-        iclgpu::functions::Sger::params params = { m, n, *alpha, x, incx, y, incy, A, lda };
+        const auto alpha_value = iclblas::get_scalar(handle, alpha);
+        if (alpha_value == 0.f)
+            return;
+        iclgpu::functions::Sger::params params = { m, n, alpha_value, x, incx, y, incy, A, lda };
         iclblas::iclblasTemplate_impl<iclgpu::functions::Sger>(handle, params);
     });
 }
@@ -290,12 +337,15 @@ iclblasStatus_t iclblasSger(iclblasHandle_t handle, int m, int n, const float* a
 extern "C"
 iclblasStatus_t iclblasSsyr(iclblasHandle_t handle, iclblasFillMode_t uplo, int n, const float* alpha, float * x, int incx, float * A, int lda)
 {
-    if (n == 0 || alpha[0] == 0.f) return ICLBLAS_STATUS_SUCCESS;
+    if (n == 0) return ICLBLAS_STATUS_SUCCESS;
 
     if (n < 0 || incx == 0) return ICLBLAS_STATUS_INVALID_VALUE;
 
     return iclblas::exception_to_iclblas_status([=]() {
-        iclgpu::functions::Ssyr::params params = { uplo, n, *alpha, x, incx, A, lda };
+        const auto alpha_value = iclblas::get_scalar(handle, alpha);
+        if (alpha_value == 0.f)
+            return;
+        iclgpu::functions::Ssyr::params params = { uplo, n, alpha_value, x, incx, A, lda };
         iclblas::iclblasTemplate_impl<iclgpu::functions::Ssyr>(handle, params);
     });
 }
@@ -330,12 +380,16 @@ iclblasStatus_t iclblasStbmv(iclblasHandle_t handle, iclblasFillMode_t uplo, icl
 
 extern "C"
 iclblasStatus_t iclblasSgbmv(iclblasHandle_t handle, iclblasOperation_t trans, int m, int n, int kl, int ku, const float* alpha, float* A, int lda, float* x, int incx, const float* beta, float* y, int incy) {
-    if (m == 0 || n == 0 || (alpha[0] == 0.f && beta[0] == 1.f)) return ICLBLAS_STATUS_SUCCESS;
+    if (m == 0 || n == 0) return ICLBLAS_STATUS_SUCCESS;
 
     if (m < 0 || n < 0 || incx == 0 || incy == 0 || ku < 0 || kl < 0) return ICLBLAS_STATUS_INVALID_VALUE;
 
     return iclblas::exception_to_iclblas_status([=]() {
-        iclgpu::functions::Sgbmv::params params = { trans, m, n, kl, ku, *alpha, A, lda, x, incx, *beta, y, incy };
+        const auto alpha_value = iclblas::get_scalar(handle, alpha);
+        const auto beta_value = iclblas::get_scalar(handle, beta);
+        if (alpha_value == 0.f && beta_value == 1.f)
+            return;
+        iclgpu::functions::Sgbmv::params params = { trans, m, n, kl, ku, alpha_value, A, lda, x, incx, beta_value, y, incy };
         iclblas::iclblasTemplate_impl<iclgpu::functions::Sgbmv>(handle, params);
     });
 
@@ -359,12 +413,16 @@ iclblasStatus_t iclblasStpmv(iclblasHandle_t handle, iclblasFillMode_t uplo, icl
 extern "C"
 iclblasStatus_t iclblasSsbmv(iclblasHandle_t handle, iclblasFillMode_t uplo, char n, char k, const float* alpha, float* A, int lda, float* x, int incx, const float* beta, float* y, int incy)
 {
-    if (n == 0 || (alpha[0] == 0.f && beta[0] == 1.f)) return ICLBLAS_STATUS_SUCCESS;
+    if (n == 0) return ICLBLAS_STATUS_SUCCESS;
 
     if (n < 0 || k < 0 || incx == 0 || incy == 0) return ICLBLAS_STATUS_INVALID_VALUE;
 
     return iclblas::exception_to_iclblas_status([=]() {
-        iclgpu::functions::Ssbmv::params params = { uplo, n, k, *alpha, A, lda, x, incx, *beta, y, incy };
+        const auto alpha_value = iclblas::get_scalar(handle, alpha);
+        const auto beta_value = iclblas::get_scalar(handle, beta);
+        if (alpha_value == 0.f && beta_value == 1.f)
+            return;
+        iclgpu::functions::Ssbmv::params params = { uplo, n, k, alpha_value, A, lda, x, incx, beta_value, y, incy };
         iclblas::iclblasTemplate_impl<iclgpu::functions::Ssbmv>(handle, params);
     });
 }
@@ -373,12 +431,16 @@ iclblasStatus_t iclblasSsbmv(iclblasHandle_t handle, iclblasFillMode_t uplo, cha
 extern "C"
 iclblasStatus_t iclblasSspmv(iclblasHandle_t handle, iclblasFillMode_t uplo, int n, const float* alpha, float* AP, float* x, int incx, const float* beta, float* y, int incy)
 {
-    if (n == 0 || (alpha[0] == 0.f && beta[0] == 1.f)) return ICLBLAS_STATUS_SUCCESS;
+    if (n == 0) return ICLBLAS_STATUS_SUCCESS;
 
     if (n < 0 || incx == 0 || incy == 0) return ICLBLAS_STATUS_INVALID_VALUE;
 
     return iclblas::exception_to_iclblas_status([=]() {
-        iclgpu::functions::Sspmv::params params = { uplo, n, *alpha, AP, x, incx, *beta, y, incy };
+        const auto alpha_value = iclblas::get_scalar(handle, alpha);
+        const auto beta_value = iclblas::get_scalar(handle, beta);
+        if (alpha_value == 0.f && beta_value == 1.f)
+            return;
+        iclgpu::functions::Sspmv::params params = { uplo, n, alpha_value, AP, x, incx, beta_value, y, incy };
         iclblas::iclblasTemplate_impl<iclgpu::functions::Sspmv>(handle, params);
     });
 }
@@ -386,22 +448,30 @@ iclblasStatus_t iclblasSspmv(iclblasHandle_t handle, iclblasFillMode_t uplo, int
 extern "C"
 iclblasStatus_t iclblasSsymm(iclblasHandle_t handle, iclblasSideMode_t side, iclblasFillMode_t uplo, int m, int n, const float* alpha, float * A, int lda, float * B, int ldb, const float* beta, float * C, int ldc)
 {
-    if (n == 0 || m == 0 || (*alpha == 0.f && *beta == 1.f))
+    if (n == 0 || m == 0)
         return ICLBLAS_STATUS_SUCCESS;
 
     return iclblas::exception_to_iclblas_status([=]() {
-        iclgpu::functions::Ssymm::params params = { side, uplo, m, n, *alpha, A, lda, B, ldb, *beta, C, ldc };
+        const auto alpha_value = iclblas::get_scalar(handle, alpha);
+        const auto beta_value = iclblas::get_scalar(handle, beta);
+        if (alpha_value == 0.f && beta_value == 1.f)
+            return;
+        iclgpu::functions::Ssymm::params params = { side, uplo, m, n, alpha_value, A, lda, B, ldb, beta_value, C, ldc };
         iclblas::iclblasTemplate_impl<iclgpu::functions::Ssymm>(handle, params);
     });
 }
 
 extern "C"
 iclblasStatus_t iclblasSsyrk(iclblasHandle_t handle, iclblasFillMode_t uplo, iclblasOperation_t trans, int n, int k, const float* alpha, float* A, int lda, const float* beta, float* C, int ldc) {
-    if (n == 0 || k == 0 || (*alpha == 0.f && *beta == 1.f))
+    if (n == 0 || k == 0)
         return ICLBLAS_STATUS_SUCCESS;
 
     return iclblas::exception_to_iclblas_status([=]() {
-        iclgpu::functions::Ssyrk::params params = { uplo, trans, n, k, *alpha, A, lda, *beta, C, ldc };
+        const auto alpha_value = iclblas::get_scalar(handle, alpha);
+        const auto beta_value = iclblas::get_scalar(handle, beta);
+        if (alpha_value == 0.f && beta_value == 1.f)
+            return;
+        iclgpu::functions::Ssyrk::params params = { uplo, trans, n, k, alpha_value, A, lda, beta_value, C, ldc };
         iclblas::iclblasTemplate_impl<iclgpu::functions::Ssyrk>(handle, params);
     });
 }
@@ -409,11 +479,15 @@ iclblasStatus_t iclblasSsyrk(iclblasHandle_t handle, iclblasFillMode_t uplo, icl
 extern "C"
 iclblasStatus_t iclblasSsyr2k(iclblasHandle_t handle, iclblasFillMode_t uplo, iclblasOperation_t trans, int n, int k, const float* alpha, float * A, int lda, float * B, int ldb, const float* beta, float * C, int ldc)
 {
-    if (n == 0 || k == 0 || (*alpha == 0.f && *beta == 1.f))
+    if (n == 0 || k == 0)
         return ICLBLAS_STATUS_SUCCESS;
 
     return iclblas::exception_to_iclblas_status([=]() {
-        iclgpu::functions::Ssyr2k::params params = { uplo, trans, n, k, *alpha, A, lda, B, ldb, *beta, C, ldc };
+        const auto alpha_value = iclblas::get_scalar(handle, alpha);
+        const auto beta_value = iclblas::get_scalar(handle, beta);
+        if (alpha_value == 0.f && beta_value == 1.f)
+            return;
+        iclgpu::functions::Ssyr2k::params params = { uplo, trans, n, k, alpha_value, A, lda, B, ldb, beta_value, C, ldc };
         iclblas::iclblasTemplate_impl<iclgpu::functions::Ssyr2k>(handle, params);
     });
 }
@@ -422,12 +496,15 @@ iclblasStatus_t iclblasSsyr2k(iclblasHandle_t handle, iclblasFillMode_t uplo, ic
 extern "C"
 iclblasStatus_t iclblasSspr2(iclblasHandle_t handle, iclblasFillMode_t uplo, int n, const float* alpha, float *x, int incx, float* y, int incy, float* AP)
 {
-    if (n == 0 || alpha[0] == 0.f) return ICLBLAS_STATUS_SUCCESS;
+    if (n == 0) return ICLBLAS_STATUS_SUCCESS;
 
     if (n < 0 || incx == 0 || incy == 0) return ICLBLAS_STATUS_INVALID_VALUE;
 
     return iclblas::exception_to_iclblas_status([=]() {
-        iclgpu::functions::Sspr2::params params = { uplo, n, *alpha, x, incx, y, incy, AP };
+        const auto alpha_value = iclblas::get_scalar(handle, alpha);
+        if (alpha_value == 0.f)
+            return;
+        iclgpu::functions::Sspr2::params params = { uplo, n, alpha_value, x, incx, y, incy, AP };
         iclblas::iclblasTemplate_impl<iclgpu::functions::Sspr2>(handle, params);
     });
 }
@@ -435,12 +512,15 @@ iclblasStatus_t iclblasSspr2(iclblasHandle_t handle, iclblasFillMode_t uplo, int
 extern "C"
 iclblasStatus_t iclblasSspr(iclblasHandle_t handle, iclblasFillMode_t uplo, int n, const float* alpha, float *x, int incx, float* AP) 
 {
-    if (n == 0 || alpha[0] == 0.f) return ICLBLAS_STATUS_SUCCESS;
+    if (n == 0) return ICLBLAS_STATUS_SUCCESS;
 
     if (n < 0 || incx == 0) return ICLBLAS_STATUS_INVALID_VALUE;
 
     return iclblas::exception_to_iclblas_status([=]() {
-        iclgpu::functions::Sspr::params params = { uplo, n, *alpha, x, incx, AP };
+        const auto alpha_value = iclblas::get_scalar(handle, alpha);
+        if (alpha_value == 0.f)
+            return;
+        iclgpu::functions::Sspr::params params = { uplo, n, alpha_value, x, incx, AP };
         iclblas::iclblasTemplate_impl<iclgpu::functions::Sspr>(handle, params);
     });
 }
@@ -449,24 +529,31 @@ iclblasStatus_t iclblasSspr(iclblasHandle_t handle, iclblasFillMode_t uplo, int
 extern "C"
 iclblasStatus_t iclblasSsymv(iclblasHandle_t handle, iclblasFillMode_t uplo, int n, const float* alpha, float *A, int lda, float *x, int incx, const float* beta, float *y, int incy)
 {
-    if (n == 0 || (alpha[0] == 0.f && beta[0] == 1.f)) return ICLBLAS_STATUS_SUCCESS;
+    if (n == 0) return ICLBLAS_STATUS_SUCCESS;
 
     if (n < 0 || incx == 0 || incy == 0) return ICLBLAS_STATUS_INVALID_VALUE;
 
     return iclblas::exception_to_iclblas_status([=]() {
-        iclgpu::functions::Ssymv::params params = { uplo, n, *alpha, A, lda, x, incx, *beta, y, incy };
+        const auto alpha_value = iclblas::get_scalar(handle, alpha);
+        const auto beta_value = iclblas::get_scalar(handle, beta);
+        if (alpha_value == 0.f && beta_value == 1.f)
+            return;
+        iclgpu::functions::Ssymv::params params = { uplo, n, alpha_value, A, lda, x, incx, beta_value, y, incy };
         iclblas::iclblasTemplate_impl<iclgpu::functions::Ssymv>(handle, params);
     });
 }
 
 extern "C"
 iclblasStatus_t iclblasSsyr2(iclblasHandle_t handle, iclblasFillMode_t uplo, int n, const float* alpha, float *x, int incx, float* y, int incy, float* A, int lda) {
-    if (n == 0 || alpha[0] == 0.f) return ICLBLAS_STATUS_SUCCESS;
+    if (n == 0) return ICLBLAS_STATUS_SUCCESS;
 
     if (n < 0 || incx == 0 || incy == 0) return ICLBLAS_STATUS_INVALID_VALUE;
 
     return iclblas::exception_to_iclblas_status([=]() {
-        iclgpu::functions::Ssyr2::params params = { uplo, n, *alpha, x, incx, y, incy, A, lda };
+        const auto alpha_value = iclblas::get_scalar(handle, alpha);
+        if (alpha_value == 0.f)
+            return;
+        iclgpu::functions::Ssyr2::params params = { uplo, n, alpha_value, x, incx, y, incy, A, lda };
         iclblas::iclblasTemplate_impl<iclgpu::functions::Ssyr2>(handle, params);
     });
 }
@@ -474,16 +561,35 @@ iclblasStatus_t iclblasSsyr2(iclblasHandle_t handle, iclblasFillMode_t uplo, int
 extern "C"
 iclblasStatus_t iclblasSgemv(iclblasHandle_t handle, iclblasOperation_t trans, int m, int n, const float* alpha, float *A, int lda, float *x, int incx, const float* beta, float *y, int incy)
 {
-    if (m == 0 || n == 0 || (alpha[0] == 0.f && beta[0] == 1.f)) return ICLBLAS_STATUS_SUCCESS;
+    if (m == 0 || n == 0) return ICLBLAS_STATUS_SUCCESS;
 
     if (m < 0 || n < 0 || incx == 0 || incy == 0) return ICLBLAS_STATUS_INVALID_VALUE;
 
     return iclblas::exception_to_iclblas_status([=]() {
-        iclgpu::functions::Sgemv::params params = { trans, m, n, *alpha, A, lda, x, incx, *beta, y, incy};
+        const auto alpha_value = iclblas::get_scalar(handle, alpha);
+        const auto beta_value = iclblas::get_scalar(handle, beta);
+        if (alpha_value == 0.f && beta_value == 1.f)
+            return;
+        iclgpu::functions::Sgemv::params params = { trans, m, n, alpha_value, A, lda, x, incx, beta_value, y, incy};
         iclblas::iclblasTemplate_impl<iclgpu::functions::Sgemv>(handle, params);
     });
 }
 
+extern "C"
+iclblasStatus_t iclblasSgemvStridedBatched(iclblasHandle_t handle, iclblasOperation_t trans, int m, int n, const float* alpha, float* A, int lda, long long strideA, float* x, int incx, long long stridex, const float* beta, float* y, int incy, long long stridey, int batchCount)
+{
+    if (m < 0 || n < 0 || incx <= 0 || incy <= 0 || batchCount < 0 || strideA < 0 || stridex < 0 || stridey < 0)
+        return ICLBLAS_STATUS_INVALID_VALUE;
+    if (m == 0 || n == 0 || batchCount == 0)
+        return ICLBLAS_STATUS_SUCCESS;
+
+    return iclblas::exception_to_iclblas_status([=]() {
+        iclgpu::functions::SgemvStridedBatched::params params = { trans, m, n, iclblas::get_scalar(handle, alpha), A, lda, strideA,
+            x, incx, stridex, iclblas::get_scalar(handle, beta), y, incy, stridey, batchCount };
+        iclblas::iclblasTemplate_impl<iclgpu::functions::SgemvStridedBatched>(handle, params);
+    });
+}
+
 // implement C API iclblasSgemm
 extern "C"
 iclblasStatus_t iclblasSgemm(iclblasHandle_t handle, iclblasOperation_t transa, iclblasOperation_t transb, int m, int n, int k, const float* alpha, float* A, int lda, float* B, int ldb, const float* beta, float* C, int ldc)
@@ -492,11 +598,41 @@ iclblasStatus_t iclblasSgemm(iclblasHandle_t handle, iclblasOperation_t transa,
         return ICLBLAS_STATUS_INVALID_VALUE;
 
     return iclblas::exception_to_iclblas_status([=]() {
-        iclgpu::functions::Sgemm::params params = { transa, transb, m, n,k, *alpha, A, lda, B, ldb, *beta, C, ldc };
+        iclgpu::functions::Sgemm::params params = { transa, transb, m, n,k, iclblas::get_scalar(handle, alpha), A, lda, B, ldb, iclblas::get_scalar(handle, beta), C, ldc };
         iclblas::iclblasTemplate_impl<iclgpu::functions::Sgemm>(handle, params);
     });
 }
 
+extern "C"
+iclblasStatus_t iclblasSgemmStridedBatched(iclblasHandle_t handle, iclblasOperation_t transa, iclblasOperation_t transb, int m, int n, int k, const float* alpha, float* A, int lda, long long strideA, float* B, int ldb, long long strideB, const float* beta, float* C, int ldc, long long strideC, int batchCount)
+{
+    if (m < 0 || n < 0 || k < 0 || batchCount < 0 || strideA < 0 || strideB < 0 || strideC < 0)
+        return ICLBLAS_STATUS_INVALID_VALUE;
+
+    return iclblas::exception_to_iclblas_status([=]() {
+        iclgpu::functions::SgemmStridedBatched::params params = { transa, transb, m, n, k, iclblas::get_scalar(handle, alpha), A, lda, strideA,
+            B, ldb, strideB, iclblas::get_scalar(handle, beta), C, ldc, strideC, batchCount };
+        iclblas::iclblasTemplate_impl<iclgpu::functions::SgemmStridedBatched>(handle, params);
+    });
+}
+
+extern "C"
+iclblasStatus_t iclblasSgemmBatched(iclblasHandle_t handle, iclblasOperation_t transa, iclblasOperation_t transb, int m, int n, int k, const float* alpha, float* const Aarray[], int lda, float* const Barray[], int ldb, const float* beta, float* const Carray[], int ldc, int batchCount)
+{
+    if (m < 0 || n < 0 || k < 0 || batchCount < 0)
+        return ICLBLAS_STATUS_INVALID_VALUE;
+    if (m == 0 || n == 0 || batchCount == 0)
+        return ICLBLAS_STATUS_SUCCESS;
+    if (Aarray == nullptr || Barray == nullptr || Carray == nullptr)
+        return ICLBLAS_STATUS_INVALID_VALUE;
+
+    return iclblas::exception_to_iclblas_status([=]() {
+        iclgpu::functions::SgemmStridedBatched::params params = { transa, transb, m, n, k, iclblas::get_scalar(handle, alpha), Aarray[0], lda, 0,
+            Barray[0], ldb, 0, iclblas::get_scalar(handle, beta), Carray[0], ldc, 0, batchCount };
+        iclblas::gemm_batched_impl<iclgpu::functions::SgemmStridedBatched>(handle, params, Aarray, Barray, Carray);
+    });
+}
+
 extern "C"
 iclblasStatus_t iclblasStrsm(iclblasHandle_t handle, iclblasSideMode_t side, iclblasFillMode_t uplo, iclblasOperation_t trans, iclblasDiagType_t diag, int m, int n, const float* alpha, float * A, int lda, float * B, int ldb)
 {
@@ -504,7 +640,7 @@ iclblasStatus_t iclblasStrsm(iclblasHandle_t handle, iclblasSideMode_t side, icl
         return ICLBLAS_STATUS_SUCCESS;
 
     return iclblas::exception_to_iclblas_status([=]() {
-        iclgpu::functions::Strsm::params params = { side, uplo, trans, diag, m, n, *alpha, A, lda, B, ldb };
+        iclgpu::functions::Strsm::params params = { side, uplo, trans, diag, m, n, iclblas::get_scalar(handle, alpha), A, lda, B, ldb };
         iclblas::iclblasTemplate_impl<iclgpu::functions::Strsm>(handle, params);
     });
 }
@@ -514,7 +650,7 @@ extern "C"
 iclblasStatus_t iclblasStrmm(iclblasHandle_t handle, iclblasSideMode_t side, iclblasFillMode_t uplo, iclblasOperation_t transa, iclblasDiagType_t diag, int m, int n, const float* alpha, float* A, int lda, float* B, int ldb, float* C, int ldc)
 {
     return iclblas::exception_to_iclblas_status([=]() {
-        iclgpu::functions::Strmm::params params = { side, uplo, transa, diag, m, n, *alpha, A, lda, B, ldb, C, ldc };
+        iclgpu::functions::Strmm::params params = { side, uplo, transa, diag, m, n, iclblas::get_scalar(handle, alpha), A, lda, B, ldb, C, ldc };
         iclblas::iclblasTemplate_impl<iclgpu::functions::Strmm>(handle, params);
     });
 }
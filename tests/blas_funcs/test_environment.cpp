@@ -15,6 +15,10 @@
 #include "test_helpers.hpp"
 #include <primitive_db.hpp>
 
+#ifdef BLAS_OCL_KERNELS_IL
+#include BLAS_OCL_KERNELS_IL
+#endif
+
 namespace iclgpu { namespace tests {
 
 decltype(iclgpu::context::create()) test_env::_ctx = nullptr;
@@ -22,9 +26,13 @@ decltype(iclgpu::context::create()) test_env::_ctx = nullptr;
 void test_env::SetUp()
 {
     _ctx = iclgpu::context::create();
-    _ctx->get_engine(engine_type::open_cl)->get_primitive_db()->insert({
+    auto db = _ctx->get_engine()->get_primitive_db();
+    db->insert({
     #include BLAS_OCL_KERNELS_DB
     });
+#ifdef BLAS_OCL_KERNELS_IL
+    db->insert_binaries(blas_ocl_kernels_il);
+#endif
 }
 
 void test_env::TearDown()
@@ -19,6 +19,10 @@
 
 #include "functions/Sgemm.hpp"
 #include "functions/Cgemm.hpp"
+#include "host/host_engine.hpp"
+
+#include <cstdio>
+#include <cstdlib>
 
 namespace iclgpu { namespace tests {
 
@@ -71,6 +75,64 @@ INSTANTIATE_TEST_CASE_P(
     testing::internal::DefaultParamName<test_Sgemm::ParamType>
 );
 
+// Host part of the hybrid implementation gets the last column blocks, the device part the rest.
+// The split is enabled regardless of the device, it needs at least two host threads.
+struct test_Sgemm_hybrid : test_Sgemm {};
+
+static void set_hybrid_env(const char* value)
+{
+#ifdef _WIN32
+    _putenv_s("ICLGPU_SGEMM_HYBRID", value);
+#else
+    if (value[0] == '\0')
+        unsetenv("ICLGPU_SGEMM_HYBRID");
+    else
+        setenv("ICLGPU_SGEMM_HYBRID", value, 1);
+#endif
+}
+
+TEST_P(test_Sgemm_hybrid, basic)
+{
+    if (test_env::get_context()->get<iclgpu::host_engine>()->concurrency() < 2)
+    {
+        std::printf("Single host thread, the hybrid split is not used\n");
+        return;
+    }
+
+    set_hybrid_env("1");
+    run_function<iclgpu::functions::Sgemm>(params, impl_name);
+    set_hybrid_env("");
+    ASSERT_FALSE(HasFatalFailure());
+
+    EXPECT_EQ(C.size(), C_ref.size());
+    size_t errors = 0;
+    for (size_t i = 0; i < C.size() && errors < 100; i++)
+    {
+        EXPECT_EQ(C[i], C_ref[i]);
+
+        if (C[i] != C_ref[i])
+            ++errors;
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(
+    s_m1024_n1100_k1024_hybrid,
+    test_Sgemm_hybrid,
+    Combine(
+        Values("hybrid"),                                   // impl_name
+        Values(ICLBLAS_OP_N),                               // transa
+        Values(ICLBLAS_OP_N),                               // transb
+        Values(1024),                                       // m
+        Values(1100),                                       // n
+        Values(1024),                                       // k
+        Values(0),                                          // lda_add
+        Values(0, 29),                                      // ldb_add
+        Values(false, true),                                // beta_zero
+        Values(0)                                           // ldc_add
+    ),
+    testing::internal::DefaultParamName<test_Sgemm_hybrid::ParamType>
+);
+
 template<>
 struct func_traits<iclgpu::functions::Cgemm>
 {
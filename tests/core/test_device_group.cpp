@@ -0,0 +1,91 @@
+// Copyright (c) 2017-2018 Intel Corporation
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//      http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <gtest/gtest.h>
+
+#include "device_group.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <numeric>
+#include <vector>
+
+namespace iclgpu { namespace tests {
+
+using namespace std;
+
+namespace {
+struct counted_event : event
+{
+    counted_event(const shared_ptr<engine>& engine, atomic<int>& waits, chrono::nanoseconds time)
+        : event(engine), _waits(waits), _time(time) {}
+
+    void wait() override { ++_waits; }
+    chrono::nanoseconds duration() override { return _time; }
+
+private:
+    atomic<int>& _waits;
+    chrono::nanoseconds _time;
+};
+}
+
+TEST(device_group, event_group_waits_all_events)
+{
+    atomic<int> waits{0};
+    vector<shared_ptr<event>> events = {
+        make_shared<counted_event>(nullptr, waits, chrono::nanoseconds(30)),
+        nullptr,
+        make_shared<counted_event>(nullptr, waits, chrono::nanoseconds(70)),
+    };
+
+    event_group group(nullptr, events);
+    group.wait();
+    EXPECT_EQ(2, waits.load());
+    EXPECT_EQ(70, group.duration().count());
+    EXPECT_EQ(3u, group.events().size());
+}
+
+TEST(device_group, split_covers_count_by_granularity)
+{
+    auto ctx = context::create(0);
+    auto group = ctx->get<device_group>();
+    group->set_devices({});
+    EXPECT_EQ(1u, group->size());
+    EXPECT_EQ(vector<size_t>{ 1000 }, group->split(1000, 64));
+
+    // Repeated context device adds members with own contexts
+    group->set_devices({ 0, 0, 0 });
+    ASSERT_EQ(3u, group->size());
+    EXPECT_EQ(ctx, group->get_context(0));
+    EXPECT_NE(ctx, group->get_context(1));
+    EXPECT_EQ(group->get_context(1), group->get_context(1));
+    EXPECT_EQ(1u, group->get_context(2)->get<device_group>()->size());
+
+    for (size_t count : { 0, 1, 63, 64, 1000, 4096 })
+    {
+        auto parts = group->split(count, 64);
+        ASSERT_EQ(3u, parts.size());
+        EXPECT_EQ(count, accumulate(parts.begin(), parts.end(), size_t(0)));
+        size_t begin = 0;
+        for (auto part : parts)
+        {
+            begin += part;
+            EXPECT_TRUE(begin % 64 == 0 || begin == count) << "count " << count;
+        }
+    }
+    EXPECT_THROW(group->get_context(3), std::invalid_argument);
+}
+
+} } // namespace iclgpu::tests
@@ -0,0 +1,236 @@
+// Copyright (c) 2017-2018 Intel Corporation
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//      http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <gtest/gtest.h>
+
+#include "dispatcher.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace iclgpu { namespace functions {
+
+/// Host-only function with the layout of generated functions
+struct Sfake
+{
+    static constexpr size_t params_num = 3;
+    static constexpr const char* name() { return "Sfake"; }
+
+    struct params
+    {
+        int32_t n;
+        blob<float, inout> x;
+        int32_t incx;
+    };
+
+    struct score : public function_score<params_num>
+    {
+        float& n;
+        float& x;
+        float& incx;
+
+        score() : function_score()
+            , n(_data[0])
+            , x(_data[1])
+            , incx(_data[2])
+        {}
+    };
+
+    static std::string shape(const params& p)
+    {
+        return shape_builder(name()).add(p.n).add(p.incx).str();
+    }
+
+    static constexpr bool selection_cached = true;
+    using selection_key = std::array<uint64_t, 3>;
+    static selection_key make_selection_key(const params& p)
+    {
+        return {{ selection_value(p.n), selection_value(p.x), selection_value(p.incx) }};
+    }
+
+    using impl = function_impl_execute<Sfake>;
+    using selector = selector_accept<Sfake>;
+};
+
+namespace implementations
+{
+std::atomic<int> accept_calls{0};
+
+/// Accepts calls with n divisible by @p Tile, tiled ones need unit stride and larger tiles have higher score
+template <int Tile>
+struct Sfake_tile : Sfake::impl
+{
+    using Sfake::impl::impl;
+    const char* name() const override { return names[Tile]; }
+    const char* full_name() const override { return names[Tile]; }
+    engine_type get_engine_type() const override { return engine_type::default_engine; }
+    bool accept(const Sfake::params& params, Sfake::score& score) override
+    {
+        ++accept_calls;
+        if (params.n % Tile != 0 || (Tile > 1 && params.incx != 1))
+            return false;
+        score.n = 1.f + Tile / 100.f;
+        return true;
+    }
+    event execute(const Sfake::params& params, const std::vector<event>&) override
+    {
+        float* x = params.x;
+        x[0] = static_cast<float>(Tile);
+        return nullptr;
+    }
+
+    static const char* const names[17];
+};
+
+template <int Tile>
+const char* const Sfake_tile<Tile>::names[17] = {
+    "", "tile1", "tile2", "", "tile4", "", "", "", "tile8", "", "", "", "", "", "", "", "tile16" };
+}
+
+template <>
+inline implementations_list<Sfake> get_implementations<Sfake>(const std::shared_ptr<context>& ctx)
+{
+    return {
+        ctx->get<implementations::Sfake_tile<1>>(),
+        ctx->get<implementations::Sfake_tile<2>>(),
+        ctx->get<implementations::Sfake_tile<4>>(),
+        ctx->get<implementations::Sfake_tile<8>>(),
+        ctx->get<implementations::Sfake_tile<16>>(),
+    };
+}
+
+} } // namespace iclgpu::functions
+
+namespace iclgpu { namespace tests {
+
+using functions::Sfake;
+using functions::implementations::accept_calls;
+
+static float run_fake(const std::shared_ptr<dispatcher>& disp, int n, int incx)
+{
+    float x[1] = { 0.f };
+    Sfake::params params = { n, { x, 1 }, incx };
+    disp->execute_function<Sfake>(params);
+    return x[0];
+}
+
+TEST(dispatcher, selection_is_memoized_by_key)
+{
+    auto ctx = context::create();
+    auto disp = ctx->get_dispatcher();
+
+    accept_calls = 0;
+    EXPECT_EQ(16.f, run_fake(disp, 32, 1));
+    EXPECT_EQ(5, accept_calls.load());
+
+    // Same key, different data: accept() is not called
+    EXPECT_EQ(16.f, run_fake(disp, 32, 1));
+    EXPECT_EQ(5, accept_calls.load());
+
+    EXPECT_EQ(4.f, run_fake(disp, 36, 1));
+    EXPECT_EQ(1.f, run_fake(disp, 32, 2));
+    EXPECT_EQ(15, accept_calls.load());
+    EXPECT_EQ(4.f, run_fake(disp, 36, 1));
+    EXPECT_EQ(15, accept_calls.load());
+}
+
+TEST(dispatcher, blob_alignment_is_part_of_key)
+{
+    alignas(256) float data[64] = {};
+    auto key = [&](float* ptr) { return Sfake::make_selection_key({ 16, { ptr, 1 }, 1 }); };
+
+    EXPECT_EQ(key(data), key(data + 32));
+    EXPECT_NE(key(data), key(data + 1));
+    EXPECT_NE(key(data + 1), key(data + 2));
+    EXPECT_EQ(key(data + 1), key(data + 3));
+}
+
+TEST(dispatcher, specialization_defines)
+{
+    auto defines = functions::specialization()
+        .add("alpha", 1.f)
+        .add("beta", 0.f)
+        .add("gamma", 0.5f)
+        .add("incx", 1)
+        .add("incy", 2)
+        .defines();
+
+    kernel_defines expected = { { "SPEC_alpha", "1.0f" }, { "SPEC_beta", "0.0f" }, { "SPEC_incx", "1" } };
+    EXPECT_EQ(expected, defines);
+    EXPECT_TRUE(functions::specialization().add("incx", -1).add("alpha", 2.f).defines().empty());
+}
+
+TEST(dispatcher, concurrent_dispatch_shares_selection)
+{
+    const int threads_count = 8;
+    const int iterations = 2000;
+    auto ctx = context::create();
+    auto disp = ctx->get_dispatcher();
+
+    std::atomic<int> errors{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threads_count; ++t)
+    {
+        threads.emplace_back([&, t]
+        {
+            for (int i = 0; i < iterations; ++i)
+            {
+                // Mixed keys: new entries are inserted while other threads look up
+                const int n = 16 * (1 + (i + t) % 5) + (i % 3 == 0 ? 2 : 0);
+                const float expected = n % 16 == 0 ? 16.f : 2.f;
+                if (run_fake(disp, n, 1) != expected || ctx->get_dispatcher() != disp)
+                    ++errors;
+            }
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+    EXPECT_EQ(0, errors.load());
+}
+
+/// Host time of the dispatch with and without memoized selection
+TEST(dispatcher, benchmark_dispatch_overhead)
+{
+    const int iterations = 100000;
+    auto ctx = context::create();
+    auto disp = ctx->get_dispatcher();
+    float x[1] = { 0.f };
+    Sfake::params params = { 1024, { x, 1 }, 1 };
+
+    auto measure = [&](bool cached)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i)
+        {
+            if (cached)
+                disp->select_cached<Sfake>(params);
+            else
+                disp->select<Sfake>(params);
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        return std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+    };
+
+    auto full = measure(false);
+    auto memoized = measure(true);
+    std::printf("dispatch selection: full %.0f ns, memoized %.0f ns\n", full, memoized);
+    EXPECT_EQ(disp->select<Sfake>(params)[0].second->name(), disp->select_cached<Sfake>(params)->at(0).second->name());
+}
+
+} } // namespace iclgpu::tests
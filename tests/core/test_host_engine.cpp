@@ -0,0 +1,149 @@
+// Copyright (c) 2017-2018 Intel Corporation
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//      http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <gtest/gtest.h>
+
+#include "host/host_engine.hpp"
+#include "functions_base.hpp"
+
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace iclgpu { namespace tests {
+
+using namespace std;
+
+TEST(host_engine, parallel_for_covers_range_once)
+{
+    auto ctx = context::create();
+    auto eng = ctx->get<host_engine>();
+
+    for (size_t grain : { 0, 1, 7, 1000, 5000 })
+    {
+        vector<atomic<int>> hits(4099);
+        for (auto& hit : hits)
+            hit = 0;
+        eng->parallel_for(3, hits.size(), grain, [&](size_t begin, size_t end)
+        {
+            ASSERT_LT(begin, end);
+            if (grain != 0)
+            {
+                ASSERT_TRUE(end - begin >= grain || end == hits.size());
+            }
+            for (auto i = begin; i < end; ++i)
+                ++hits[i];
+        });
+        for (size_t i = 0; i < hits.size(); ++i)
+            ASSERT_EQ(i < 3 ? 0 : 1, hits[i].load()) << "grain " << grain << ", index " << i;
+    }
+}
+
+TEST(host_engine, parallel_for_rethrows_exception)
+{
+    auto ctx = context::create();
+    auto eng = ctx->get<host_engine>();
+
+    atomic<size_t> done{0};
+    EXPECT_THROW(eng->parallel_for(0, 1000, 1, [&](size_t begin, size_t end)
+    {
+        if (begin <= 500 && 500 < end)
+            throw runtime_error("chunk failed");
+        done += end - begin;
+    }), runtime_error);
+    EXPECT_EQ(999u, done.load());
+
+    // The pool is usable after the failure
+    done = 0;
+    eng->parallel_for(0, 1000, 1, [&](size_t begin, size_t end) { done += end - begin; });
+    EXPECT_EQ(1000u, done.load());
+}
+
+TEST(host_engine, nested_and_concurrent_loops_complete)
+{
+    auto ctx = context::create();
+    auto eng = ctx->get<host_engine>();
+
+    auto run = [&](atomic<size_t>& sum)
+    {
+        eng->parallel_for(0, 16, 1, [&](size_t begin, size_t end)
+        {
+            for (auto i = begin; i < end; ++i)
+            {
+                eng->parallel_for(0, 100, 1, [&](size_t b, size_t e) { sum += e - b; });
+            }
+        });
+    };
+
+    atomic<size_t> sums[4];
+    vector<thread> threads;
+    for (auto& sum : sums)
+    {
+        sum = 0;
+        threads.emplace_back([&] { run(sum); });
+    }
+    for (auto& t : threads)
+        t.join();
+    for (auto& sum : sums)
+        EXPECT_EQ(1600u, sum.load());
+}
+
+TEST(host_engine, kernel_reads_arguments_and_buffers)
+{
+    auto ctx = context::create();
+    auto eng = ctx->get<host_engine>();
+
+    auto kernel = eng->get_kernel("host_engine_test_axpb", [](const host_kernel_args& args, size_t begin, size_t end)
+    {
+        auto a = args.scalar<int32_t>(0);
+        auto x = args.buffer<const int32_t>(1);
+        auto b = args.scalar<int64_t>(2);
+        auto res = args.buffer<int64_t>(3);
+        for (auto i = begin; i < end; ++i)
+            res[i] = a * x[i] + b;
+    });
+
+    const size_t count = 10000;
+    vector<int32_t> x(count);
+    iota(x.begin(), x.end(), 0);
+    vector<int64_t> res(count, 0);
+    blob<int32_t, input> x_blob(x.data(), count);
+    blob<int64_t, output> res_blob(res.data(), count);
+
+    kernel->set_arg(0, int32_t(3));
+    kernel->set_arg(1, x_blob.get());
+    kernel->set_arg(2, int64_t(1) << 40);
+    kernel->set_arg(3, res_blob.get());
+    kernel->set_options({ count });
+    auto evt = kernel->submit();
+    ASSERT_TRUE(evt);
+    evt->wait();
+
+    for (size_t i = 0; i < count; ++i)
+        ASSERT_EQ(3 * static_cast<int64_t>(i) + (int64_t(1) << 40), res[i]);
+
+    // Arguments of mismatched kind or size are reported
+    auto bad = eng->get_kernel("host_engine_test_bad", [](const host_kernel_args& args, size_t, size_t)
+    {
+        args.scalar<int64_t>(0);
+    });
+    bad->set_arg(0, int32_t(1));
+    bad->set_options({ 1 });
+    EXPECT_THROW(bad->submit(), std::invalid_argument);
+}
+
+} } // namespace iclgpu::tests
@@ -18,6 +18,8 @@
 #include "functions_base.hpp"
 #include "primitive_db.hpp"
 
+#include <chrono>
+#include <cstdio>
 #include <vector>
 #include <string>
 
@@ -43,6 +45,39 @@ __kernel void ocl_engine_test_include(int a, __global int* res)
     res[0] = a * 20;
 #endif
 }
+)__krnl"},
+
+{"ocl_engine_test_buffers",
+R"__krnl(
+__kernel void ocl_engine_test_fill(int value, __global int* buf)
+{
+    buf[get_global_id(0)] = value;
+}
+
+__kernel void ocl_engine_test_copy(__global int* src, __global int* dst)
+{
+    dst[get_global_id(0)] = src[get_global_id(0)];
+}
+
+__kernel void ocl_engine_test_spin(int iterations, __global float* buf)
+{
+    float value = buf[get_global_id(0)];
+    for (int i = 0; i < iterations; ++i)
+        value = value * 0.999f + 0.001f;
+    buf[get_global_id(0)] = value;
+}
+)__krnl"},
+
+{"ocl_engine_test_defines",
+R"__krnl(
+#ifndef SCALE
+#define SCALE 10
+#endif
+
+__kernel void ocl_engine_test_defines(int a, __global int* res)
+{
+    res[0] = a * SCALE;
+}
 )__krnl"}
 
 };
@@ -117,4 +152,231 @@ TEST_F(ocl_engine_test, include2)
     EXPECT_EQ(expected, actual);
 }
 
+TEST_F(ocl_engine_test, contexts_share_modules)
+{
+    int32_t a = 111;
+    auto run = [&](const std::shared_ptr<engine>& e)
+    {
+        int32_t actual = 0;
+        blob<int32_t, output> res(&actual, 1);
+        auto k = e->get_kernel("ocl_engine_test_include");
+        k->set_arg(0, a);
+        k->set_arg(1, res.get());
+        k->set_options({ 1 });
+        k->submit()->wait();
+        return actual;
+    };
+
+    EXPECT_EQ(a * 10, run(eng));
+
+    // Second context of the device gets the program built for the first one
+    auto other_ctx = context::create();
+    auto other_eng = other_ctx->get_engine(engine_type::open_cl);
+    EXPECT_EQ(eng->get_primitive_db(), other_eng->get_primitive_db());
+    EXPECT_EQ(a * 10, run(other_eng));
+    auto info = other_eng->get_build_info();
+    ASSERT_EQ(1u, info.size());
+    EXPECT_EQ("ocl_engine_test_include", info[0].module);
+    EXPECT_EQ(module_build_info::shared, info[0].origin);
+
+    // Replaced header is used by programs requested later
+    auto new_ctx = context::create();
+    auto new_eng = new_ctx->get_engine(engine_type::open_cl);
+    new_eng->get_primitive_db()->insert({ "use_value.h", "\n" });
+    EXPECT_EQ(a * 20, run(new_eng));
+    info = new_eng->get_build_info();
+    ASSERT_EQ(1u, info.size());
+    EXPECT_NE(module_build_info::shared, info[0].origin);
+}
+
+TEST_F(ocl_engine_test, defines_build_module_variants)
+{
+    int32_t a = 111;
+    int32_t actual = 0;
+    blob<int32_t, output> res(&actual, 1);
+
+    auto run = [&](const kernel_defines& defines)
+    {
+        kernel = eng->get_kernel("ocl_engine_test_defines", "ocl_engine_test_defines", defines);
+        kernel->set_arg(0, a);
+        kernel->set_arg(1, res.get());
+        kernel->set_options({ 1 });
+        kernel->submit()->wait();
+        return actual;
+    };
+
+    EXPECT_EQ(a * 10, run({}));
+    EXPECT_EQ(a * 30, run({ { "SCALE", "30" } }));
+    EXPECT_EQ(a * 10, run({}));
+    EXPECT_EQ(a * 30, run({ { "SCALE", "30" } }));
+
+    // Each variant is built once
+    size_t builds = 0;
+    for (auto& info : eng->get_build_info())
+        if (info.module.find("ocl_engine_test_defines") == 0)
+            ++builds;
+    EXPECT_EQ(2u, builds);
+}
+
+TEST_F(ocl_engine_test, specialized_kernel_waits_for_variant)
+{
+    int32_t a = 111;
+    int32_t actual = 0;
+    blob<int32_t, output> res(&actual, 1);
+
+    auto run = [&]()
+    {
+        kernel = eng->get_specialized_kernel("ocl_engine_test_defines", "ocl_engine_test_defines", { { "SCALE", "30" } });
+        kernel->set_arg(0, a);
+        kernel->set_arg(1, res.get());
+        kernel->set_options({ 1 });
+        kernel->submit()->wait();
+        return actual;
+    };
+
+    // Default module is used while the variant is built in background
+    EXPECT_EQ(a * 10, run());
+    eng->wait_warmup();
+    EXPECT_EQ(a * 30, run());
+
+    auto info = eng->get_build_info();
+    auto variant = std::find_if(info.begin(), info.end(), [](const module_build_info& i)
+    {
+        return i.module != "ocl_engine_test_defines" && i.module.find("ocl_engine_test_defines") == 0;
+    });
+    ASSERT_NE(info.end(), variant);
+    EXPECT_TRUE(variant->background);
+}
+
+TEST_F(ocl_engine_test, duration_requires_profiling)
+{
+    const size_t size = 1024;
+    auto run = [&]()
+    {
+        kernel = eng->get_kernel("ocl_engine_test_fill", "ocl_engine_test_buffers");
+        kernel->set_arg(0, 1);
+        kernel->set_arg(1, eng->get_temp_buffer<int32_t>(size));
+        kernel->set_options({ size });
+        return kernel->submit();
+    };
+
+    eng->set_profiling(false);
+    EXPECT_FALSE(eng->is_profiling_enabled());
+    EXPECT_THROW(run()->duration(), error_unsupported);
+
+    eng->set_profiling(true);
+    EXPECT_TRUE(eng->is_profiling_enabled());
+    EXPECT_GT(run()->duration().count(), 0);
+    eng->set_profiling(false);
+}
+
+TEST_F(ocl_engine_test, zero_initialized_temp_buffer)
+{
+    const size_t size = 1024;
+
+    // Dirty buffer goes back to the pool and is likely reused below
+    {
+        auto dirty = eng->get_temp_buffer<int32_t>(size);
+        kernel = eng->get_kernel("ocl_engine_test_fill", "ocl_engine_test_buffers");
+        kernel->set_arg(0, 7);
+        kernel->set_arg(1, dirty);
+        kernel->set_options({ size });
+        kernel->submit()->wait();
+    }
+
+    auto zeroed = eng->get_temp_buffer<int32_t>(size, buffer_init::zero);
+    vector<int32_t> actual(size, -1);
+    blob<int32_t, output> res(actual.data(), size);
+    execute_kernel("ocl_engine_test_copy", { size }, zeroed, res.get());
+
+    for (auto v : actual)
+        EXPECT_EQ(0, v);
+}
+
+TEST_F(ocl_engine_test, parallel_commands_results)
+{
+    const size_t size = 256;
+    const int commands = 6;
+    vector<vector<int32_t>> actual(commands, vector<int32_t>(size, -1));
+    vector<shared_ptr<command>> kernels;
+    for (int i = 0; i < commands; ++i)
+    {
+        blob<int32_t, output> res(actual[i].data(), size);
+        auto krnl = eng->get_kernel("ocl_engine_test_fill", "ocl_engine_test_buffers");
+        krnl->set_arg(0, i);
+        krnl->set_arg(1, res.get());
+        krnl->set_options({ size });
+        kernels.push_back(krnl);
+    }
+
+    eng->get_commands_parallel(kernels)->submit()->wait();
+
+    for (int i = 0; i < commands; ++i)
+        for (auto v : actual[i])
+            EXPECT_EQ(i, v);
+}
+
+/// Independent single work-group kernels executed one by one and as parallel commands
+TEST_F(ocl_engine_test, benchmark_parallel_commands)
+{
+    const size_t size = 16;
+    const int commands = 4;
+    const int iterations = 1 << 20;
+    vector<shared_ptr<command>> kernels;
+    for (int i = 0; i < commands; ++i)
+    {
+        auto krnl = eng->get_kernel("ocl_engine_test_spin", "ocl_engine_test_buffers");
+        krnl->set_arg(0, iterations);
+        krnl->set_arg(1, eng->get_temp_buffer<float>(size, buffer_init::zero));
+        krnl->set_options({ size, size });
+        kernels.push_back(krnl);
+    }
+
+    auto measure = [&](const shared_ptr<command>& cmd)
+    {
+        auto start = chrono::steady_clock::now();
+        cmd->submit()->wait();
+        return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count() / 1e6;
+    };
+
+    auto serial = eng->get_commands_sequence(kernels);
+    auto parallel = eng->get_commands_parallel(kernels);
+    // Warm up: builds the module
+    measure(serial);
+
+    auto serial_time = measure(serial);
+    auto parallel_time = measure(parallel);
+    std::printf("%d independent kernels: %.3f ms serial, %.3f ms parallel\n", commands, serial_time, parallel_time);
+}
+
+/// Temp buffer creation with and without zero-fill followed by kernel overwriting the buffer
+TEST_F(ocl_engine_test, benchmark_uninitialized_temp_buffer)
+{
+    const size_t size = 4 * 1024 * 1024;
+    const int iterations = 20;
+    auto measure = [&](buffer_init init)
+    {
+        auto start = chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i)
+        {
+            auto temp = eng->get_temp_buffer<int32_t>(size, init);
+            kernel = eng->get_kernel("ocl_engine_test_fill", "ocl_engine_test_buffers");
+            kernel->set_arg(0, i);
+            kernel->set_arg(1, temp);
+            kernel->set_options({ size });
+            kernel->submit()->wait();
+        }
+        auto time = chrono::steady_clock::now() - start;
+        return chrono::duration_cast<chrono::nanoseconds>(time).count() / double(iterations);
+    };
+
+    // Warm up: builds the module and fills the buffer pool
+    measure(buffer_init::uninitialized);
+
+    auto zeroed = measure(buffer_init::zero);
+    auto uninitialized = measure(buffer_init::uninitialized);
+    std::printf("temp buffer + kernel per call: %.3f ms zero-filled, %.3f ms uninitialized\n",
+                zeroed / 1e6, uninitialized / 1e6);
+}
+
 }}
@@ -0,0 +1,176 @@
+// Copyright (c) 2017-2018 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "engine.hpp"
+#include "functions_base.hpp"
+#include "primitive_db.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace iclgpu { namespace tests {
+
+using namespace std;
+
+static const vector<pair<string,string>> pool_kernels {
+{"ocl_kernel_pool_test",
+R"__krnl(
+__kernel void ocl_kernel_pool_mul(int a, int b, __global int* res)
+{
+    res[get_global_id(0)] = a * b;
+}
+
+__kernel void ocl_kernel_pool_add(int a, int b, __global int* res)
+{
+    res[get_global_id(0)] = a + b;
+}
+)__krnl"}
+
+};
+
+static void set_kernel_pool_env(const char* value)
+{
+#ifdef _WIN32
+    _putenv_s("ICLGPU_KERNEL_POOL", value);
+#else
+    if (value[0] == '\0')
+        unsetenv("ICLGPU_KERNEL_POOL");
+    else
+        setenv("ICLGPU_KERNEL_POOL", value, 1);
+#endif
+}
+
+static shared_ptr<engine> create_engine(shared_ptr<context>& ctx)
+{
+    ctx = context::create();
+    auto eng = ctx->get_engine(engine_type::open_cl);
+    eng->get_primitive_db()->insert_range(pool_kernels.begin(), pool_kernels.end());
+    return eng;
+}
+
+static shared_ptr<kernel_command> prepare(const shared_ptr<engine>& eng, const string& name, int32_t a, int32_t b,
+                                          const blob<int32_t, output>& res, size_t count)
+{
+    auto kernel = eng->get_kernel(name, "ocl_kernel_pool_test");
+    kernel->set_arg(0, a);
+    kernel->set_arg(1, b);
+    kernel->set_arg(2, res.get());
+    kernel->set_options({ count });
+    return kernel;
+}
+
+TEST(ocl_kernel_pool, interleaved_kernels_keep_own_arguments)
+{
+    shared_ptr<context> ctx;
+    auto eng = create_engine(ctx);
+
+    int32_t res1[4] = {};
+    int32_t res2[4] = {};
+    blob<int32_t, output> blob1(res1, 4);
+    blob<int32_t, output> blob2(res2, 4);
+
+    // Both commands are alive at the same time, so they must not share kernel object
+    auto k1 = prepare(eng, "ocl_kernel_pool_mul", 3, 5, blob1, 4);
+    auto k2 = prepare(eng, "ocl_kernel_pool_mul", 7, 11, blob2, 4);
+    k1->submit()->wait();
+    k2->submit()->wait();
+    for (int i = 0; i < 4; ++i)
+    {
+        EXPECT_EQ(15, res1[i]);
+        EXPECT_EQ(77, res2[i]);
+    }
+
+    // Released kernel objects are reused with new arguments
+    k1.reset();
+    k2.reset();
+    for (int32_t n = 0; n < 10; ++n)
+    {
+        prepare(eng, "ocl_kernel_pool_add", n, 100, blob1, 4)->submit()->wait();
+        prepare(eng, "ocl_kernel_pool_mul", n, 100, blob2, 4)->submit()->wait();
+        EXPECT_EQ(n + 100, res1[3]);
+        EXPECT_EQ(n * 100, res2[3]);
+    }
+}
+
+TEST(ocl_kernel_pool, concurrent_threads)
+{
+    shared_ptr<context> ctx;
+    auto eng = create_engine(ctx);
+
+    const int threads_count = 4;
+    const int iterations = 50;
+    vector<int> errors(threads_count, 0);
+    vector<thread> threads;
+    for (int t = 0; t < threads_count; ++t)
+    {
+        threads.emplace_back([&, t]
+        {
+            int32_t res[16] = {};
+            blob<int32_t, output> res_blob(res, 16);
+            for (int32_t n = 0; n < iterations; ++n)
+            {
+                prepare(eng, "ocl_kernel_pool_mul", t + 1, n, res_blob, 16)->submit()->wait();
+                for (auto r : res)
+                    if (r != (t + 1) * n)
+                        ++errors[t];
+            }
+        });
+    }
+    for (auto& t : threads)
+        t.join();
+
+    for (auto e : errors)
+        EXPECT_EQ(0, e);
+}
+
+/// Host overhead of get_kernel + set_arg + set_options, with and without kernel object pool
+TEST(ocl_kernel_pool, benchmark_host_overhead)
+{
+    const int iterations = 2000;
+
+    auto measure = [&](const char* pool_env)
+    {
+        set_kernel_pool_env(pool_env);
+        shared_ptr<context> ctx;
+        auto eng = create_engine(ctx);
+        set_kernel_pool_env("");
+
+        int32_t res[4] = {};
+        blob<int32_t, output> res_blob(res, 4);
+        // Builds the program, so it is not counted in the loop
+        prepare(eng, "ocl_kernel_pool_mul", 1, 1, res_blob, 4)->submit()->wait();
+
+        auto start = chrono::steady_clock::now();
+        for (int32_t n = 0; n < iterations; ++n)
+        {
+            prepare(eng, "ocl_kernel_pool_mul", n, 2, res_blob, 4);
+        }
+        auto time = chrono::steady_clock::now() - start;
+        return chrono::duration_cast<chrono::nanoseconds>(time).count() / double(iterations);
+    };
+
+    auto unpooled = measure("0");
+    auto pooled = measure("1");
+
+    std::printf("get_kernel + set_arg per call: %.2f us without pool, %.2f us with pool\n",
+                unpooled / 1e3, pooled / 1e3);
+}
+
+}}
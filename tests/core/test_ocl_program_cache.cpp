@@ -0,0 +1,251 @@
+// Copyright (c) 2017-2018 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "engine.hpp"
+#include "functions_base.hpp"
+#include "primitive_db.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <process.h>
+#else
+#include <dirent.h>
+#include <unistd.h>
+#endif
+
+namespace iclgpu { namespace tests {
+
+using namespace std;
+
+static const vector<pair<string,string>> cache_kernels {
+{"cache_test_value.h",
+R"__krnl(
+#define CACHE_TEST_VALUE 10
+)__krnl"},
+
+{"ocl_program_cache_test",
+R"__krnl(
+#include "cache_test_value.h"
+
+__kernel void ocl_program_cache_test(int a, __global int* res)
+{
+    int acc = 0;
+    #pragma unroll
+    for (int i = 0; i < 64; ++i)
+    {
+        acc += (a * CACHE_TEST_VALUE + i) % (i + 7);
+        acc ^= (acc << 3) + i;
+    }
+    res[0] = a * CACHE_TEST_VALUE;
+    res[1] = acc;
+}
+)__krnl"}
+
+};
+
+static void set_env(const char* name, const string& value)
+{
+#ifdef _WIN32
+    _putenv_s(name, value.c_str());
+#else
+    setenv(name, value.c_str(), 1);
+#endif
+}
+
+static void unset_env(const char* name)
+{
+#ifdef _WIN32
+    _putenv_s(name, "");
+#else
+    unsetenv(name);
+#endif
+}
+
+static bool get_env(const char* name, string& value)
+{
+#ifdef _WIN32
+    char* buf = nullptr;
+    size_t len = 0;
+    if (_dupenv_s(&buf, &len, name) != 0 || buf == nullptr)
+        return false;
+    value = buf;
+    free(buf);
+    return true;
+#else
+    auto env = getenv(name);
+    if (env == nullptr)
+        return false;
+    value = env;
+    return true;
+#endif
+}
+
+static vector<string> list_files(const string& dir)
+{
+    vector<string> result;
+#ifdef _WIN32
+    WIN32_FIND_DATAA data;
+    auto handle = FindFirstFileA((dir + "\\*").c_str(), &data);
+    if (handle == INVALID_HANDLE_VALUE)
+        return result;
+    do
+    {
+        if (!(data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
+            result.push_back(dir + "\\" + data.cFileName);
+    } while (FindNextFileA(handle, &data));
+    FindClose(handle);
+#else
+    auto d = opendir(dir.c_str());
+    if (d == nullptr)
+        return result;
+    while (auto entry = readdir(d))
+    {
+        string name = entry->d_name;
+        if (name != "." && name != "..")
+            result.push_back(dir + "/" + name);
+    }
+    closedir(d);
+#endif
+    return result;
+}
+
+struct ocl_program_cache_test : public ::testing::Test
+{
+    void SetUp() override
+    {
+#ifdef _WIN32
+        char tmp[MAX_PATH];
+        GetTempPathA(MAX_PATH, tmp);
+        cache_dir = string(tmp) + "iclgpu_cache_test_" + to_string(_getpid());
+        entries_dir = cache_dir + "\\v1";
+#else
+        cache_dir = "/tmp/iclgpu_cache_test_" + to_string(getpid());
+        entries_dir = cache_dir + "/v1";
+#endif
+        had_old_value = get_env("ICLGPU_CACHE_DIR", old_value);
+        set_env("ICLGPU_CACHE_DIR", cache_dir);
+        remove_cache();
+    }
+
+    void TearDown() override
+    {
+        remove_cache();
+        if (had_old_value)
+            set_env("ICLGPU_CACHE_DIR", old_value);
+        else
+            unset_env("ICLGPU_CACHE_DIR");
+    }
+
+    void remove_cache()
+    {
+        for (auto& f : list_files(entries_dir))
+            std::remove(f.c_str());
+#ifdef _WIN32
+        RemoveDirectoryA(entries_dir.c_str());
+        RemoveDirectoryA(cache_dir.c_str());
+#else
+        rmdir(entries_dir.c_str());
+        rmdir(cache_dir.c_str());
+#endif
+    }
+
+    /// Runs kernel in a fresh context, so the program is built (or loaded) on the first call
+    chrono::nanoseconds first_call(int32_t a, int32_t& actual, const string& header = string())
+    {
+        auto ctx = context::create();
+        auto eng = ctx->get_engine(engine_type::open_cl);
+        eng->get_primitive_db()->insert_range(cache_kernels.begin(), cache_kernels.end());
+        if (!header.empty())
+            eng->get_primitive_db()->insert({ "cache_test_value.h", header });
+
+        int32_t res[2] = { 0, 0 };
+        blob<int32_t, output> res_blob(res, 2);
+
+        auto start = chrono::steady_clock::now();
+        auto kernel = eng->get_kernel("ocl_program_cache_test");
+        kernel->set_arg(0, a);
+        kernel->set_arg(1, res_blob.get());
+        kernel->set_options({ 1 });
+        kernel->submit()->wait();
+        auto time = chrono::steady_clock::now() - start;
+
+        actual = res[0];
+        return chrono::duration_cast<chrono::nanoseconds>(time);
+    }
+
+    string cache_dir;
+    string entries_dir;
+    bool had_old_value = false;
+    string old_value;
+};
+
+TEST_F(ocl_program_cache_test, warm_first_call_uses_cache)
+{
+    int32_t a = 111;
+    int32_t actual = 0;
+
+    auto cold = first_call(a, actual);
+    EXPECT_EQ(a * 10, actual);
+    ASSERT_EQ(1u, list_files(entries_dir).size());
+
+    actual = 0;
+    auto warm = first_call(a, actual);
+    EXPECT_EQ(a * 10, actual);
+    EXPECT_EQ(1u, list_files(entries_dir).size());
+
+    std::printf("first call: cold %.3f ms, warm %.3f ms\n", cold.count() / 1e6, warm.count() / 1e6);
+}
+
+TEST_F(ocl_program_cache_test, header_change_invalidates_entry)
+{
+    int32_t a = 111;
+    int32_t actual = 0;
+
+    first_call(a, actual);
+    EXPECT_EQ(a * 10, actual);
+
+    first_call(a, actual, "#define CACHE_TEST_VALUE 20\n");
+    EXPECT_EQ(a * 20, actual);
+    EXPECT_EQ(2u, list_files(entries_dir).size());
+}
+
+TEST_F(ocl_program_cache_test, corrupted_entry_is_rebuilt)
+{
+    int32_t a = 111;
+    int32_t actual = 0;
+
+    first_call(a, actual);
+    auto files = list_files(entries_dir);
+    ASSERT_EQ(1u, files.size());
+
+    {
+        ofstream file(files[0], ios::binary | ios::trunc);
+        file << "garbage";
+    }
+
+    actual = 0;
+    first_call(a, actual);
+    EXPECT_EQ(a * 10, actual);
+}
+
+}}
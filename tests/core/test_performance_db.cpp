@@ -0,0 +1,93 @@
+// Copyright (c) 2017-2018 Intel Corporation
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//      http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <gtest/gtest.h>
+
+#include "performance_db.hpp"
+#include "functions_base.hpp"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace iclgpu { namespace tests {
+
+using std::chrono::nanoseconds;
+
+TEST(performance_db, shape_buckets)
+{
+    auto key = [](int n, int inc, float alpha) { return functions::shape_builder("Sfoo").add(n).add(inc).add(alpha).str(); };
+
+    EXPECT_EQ("Sfoo:1:-1:o", key(1, -1, 1.f));
+    EXPECT_EQ(key(1000, 1, 0.f), key(1023, 1, 0.f));
+    EXPECT_NE(key(1023, 1, 0.f), key(1024, 1, 0.f));
+    EXPECT_NE(key(1000, 1, 2.f), key(-1000, 1, 2.f));
+    EXPECT_NE(key(100, 1, 2.f), key(100, 2, 2.f));
+    EXPECT_EQ(key(100, 1, 2.f), key(100, 1, -3.f));
+    EXPECT_NE(key(100, 1, 0.f), key(100, 1, 1.f));
+}
+
+TEST(performance_db, measures_each_then_selects_fastest)
+{
+    auto db = context::create()->get<performance_db>();
+    std::vector<const char*> impls = { "naive", "simd", "async" };
+    const nanoseconds times[] = { nanoseconds(300), nanoseconds(100), nanoseconds(200) };
+
+    bool measure = false;
+    for (size_t i = 0; i < impls.size(); ++i)
+    {
+        for (unsigned s = 0; s < performance_db::samples_count; ++s)
+        {
+            auto index = db->select("Sfoo:p10", impls, measure);
+            ASSERT_EQ(i, index);
+            ASSERT_TRUE(measure);
+            // First call is slow as it includes kernel build
+            db->record("Sfoo:p10", impls[index], s == 0 ? times[index] * 100 : times[index]);
+        }
+    }
+
+    EXPECT_EQ(1u, db->select("Sfoo:p10", impls, measure));
+    EXPECT_FALSE(measure);
+
+    // Other shapes are measured separately
+    EXPECT_EQ(0u, db->select("Sfoo:p20", impls, measure));
+    EXPECT_TRUE(measure);
+
+    // Single implementation is never measured
+    EXPECT_EQ(0u, db->select("Sfoo:p30", { "naive" }, measure));
+    EXPECT_FALSE(measure);
+}
+
+TEST(performance_db, serialize_round_trip)
+{
+    auto db = context::create()->get<performance_db>();
+    std::vector<const char*> impls = { "naive", "simd" };
+    for (unsigned s = 0; s < performance_db::samples_count; ++s)
+    {
+        db->record("Sfoo:p10", "naive", nanoseconds(100));
+        db->record("Sfoo:p10", "simd", nanoseconds(500));
+    }
+
+    auto loaded = context::create()->get<performance_db>();
+    ASSERT_TRUE(loaded->deserialize(db->serialize()));
+    bool measure = true;
+    EXPECT_EQ(0u, loaded->select("Sfoo:p10", impls, measure));
+    EXPECT_FALSE(measure);
+
+    EXPECT_FALSE(loaded->deserialize("unknown format\nSfoo:p10 simd 3 1\n"));
+    EXPECT_EQ(0u, loaded->select("Sfoo:p10", impls, measure));
+}
+
+} } // namespace iclgpu::tests
@@ -0,0 +1,79 @@
+// Copyright (c) 2017-2018 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "primitive_db.hpp"
+
+namespace iclgpu { namespace tests {
+
+static const unsigned char module_a_il[] = { 0x03, 0x02, 0x23, 0x07 };
+static const unsigned char module_b_il[] = { 0x03, 0x02, 0x23, 0x07, 0x00 };
+
+static const primitive_db::binary_value_type test_binaries[] = {
+    {"module_a", module_a_il, sizeof(module_a_il)},
+    {"module_b", module_b_il, sizeof(module_b_il)},
+    {nullptr, nullptr, 0}
+};
+
+struct primitive_db_test : public ::testing::Test
+{
+    void SetUp() override
+    {
+        db.insert({
+            {"header.h", "#define VALUE 1\n"},
+            {"module_a", "__kernel void module_a() {}\n"},
+            {"module_b", "__kernel void module_b() {}\n"},
+        });
+        db.insert_binaries(test_binaries);
+    }
+
+    primitive_db db;
+};
+
+TEST_F(primitive_db_test, get_binary)
+{
+    auto a = db.get_binary("module_a");
+    ASSERT_NE(nullptr, a);
+    EXPECT_EQ(module_a_il, a->data);
+    EXPECT_EQ(sizeof(module_a_il), a->size);
+    EXPECT_EQ(nullptr, db.get_binary("module_c"));
+}
+
+TEST_F(primitive_db_test, same_source_keeps_binary)
+{
+    db.insert({"module_a", "__kernel void module_a() {}\n"});
+    db.insert({"header.h", "#define VALUE 1\n"});
+    EXPECT_NE(nullptr, db.get_binary("module_a"));
+    EXPECT_NE(nullptr, db.get_binary("module_b"));
+}
+
+TEST_F(primitive_db_test, source_override_drops_binary)
+{
+    db.insert({"module_a", "__kernel void module_a() { /* changed */ }\n"});
+    EXPECT_EQ(nullptr, db.get_binary("module_a"));
+    EXPECT_NE(nullptr, db.get_binary("module_b"));
+}
+
+TEST_F(primitive_db_test, header_override_drops_all_binaries)
+{
+    db.insert({"other.h", "#define OTHER 1\n"});
+    EXPECT_NE(nullptr, db.get_binary("module_a"));
+
+    db.insert({"header.h", "#define VALUE 2\n"});
+    EXPECT_EQ(nullptr, db.get_binary("module_a"));
+    EXPECT_EQ(nullptr, db.get_binary("module_b"));
+}
+
+}}
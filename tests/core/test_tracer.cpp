@@ -0,0 +1,102 @@
+// Copyright (c) 2017-2018 Intel Corporation
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//      http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <gtest/gtest.h>
+
+#include "tracer.hpp"
+
+#include <sstream>
+#include <string>
+
+namespace iclgpu { namespace tests {
+
+static std::string write_trace()
+{
+    std::ostringstream stream;
+    tracer::write(stream);
+    return stream.str();
+}
+
+static tracer::command_info make_command(const char* name, uint64_t start, uint64_t end)
+{
+    tracer::command_info info;
+    info.name = name;
+    info.work_size = nd_range(64, 4);
+    info.parallel_size = nd_range(16, 1);
+    info.queue = 2;
+    info.query = [=](bool, command_timestamps& timestamps)
+    {
+        timestamps = { 1000, 1500, start, end };
+        return true;
+    };
+    return info;
+}
+
+TEST(tracer, disabled_records_nothing)
+{
+    tracer::enable(false);
+    write_trace();
+    {
+        tracer::span span("function", "Sfoo");
+        span.set_detail("Sfoo_naive");
+    }
+    auto trace = write_trace();
+    EXPECT_EQ(std::string::npos, trace.find("Sfoo"));
+}
+
+TEST(tracer, spans_and_commands)
+{
+    tracer::enable(true);
+    write_trace();
+    {
+        tracer::span span("function", "Sbar");
+        span.set_detail("Sbar_simd16");
+        tracer::add_command(make_command("Sbar_kernel", 2000, 5000));
+    }
+    tracer::add_command(make_command("unattributed_kernel", 6000, 7000));
+    tracer::enable(false);
+
+    auto trace = write_trace();
+    EXPECT_EQ(0u, trace.find("{\"displayTimeUnit\""));
+    EXPECT_NE(std::string::npos, trace.find("\"name\":\"Sbar\",\"cat\":\"function\""));
+    EXPECT_NE(std::string::npos, trace.find("\"implementation\":\"Sbar_simd16\""));
+    EXPECT_NE(std::string::npos, trace.find("\"name\":\"Sbar_kernel\",\"cat\":\"kernel\""));
+    EXPECT_NE(std::string::npos, trace.find("\"function\":\"Sbar\""));
+    EXPECT_NE(std::string::npos, trace.find("\"global_size\":\"64, 4\",\"local_size\":\"16, 1\""));
+    EXPECT_NE(std::string::npos, trace.find("\"dur\":3.000"));
+    EXPECT_NE(std::string::npos, trace.find("\"name\":\"unattributed_kernel\""));
+    EXPECT_NE(std::string::npos, trace.find("\"args\":{\"name\":\"queue 2\"}"));
+
+    // Written events are cleared
+    EXPECT_EQ(std::string::npos, write_trace().find("Sbar"));
+}
+
+TEST(tracer, pending_commands_are_waited)
+{
+    tracer::enable(true);
+    write_trace();
+    auto info = make_command("late_kernel", 2000, 2500);
+    auto query = info.query;
+    info.query = [=](bool wait, command_timestamps& timestamps)
+    {
+        return wait && query(wait, timestamps);
+    };
+    tracer::add_command(std::move(info));
+    tracer::enable(false);
+
+    EXPECT_NE(std::string::npos, write_trace().find("late_kernel"));
+}
+
+} } // namespace iclgpu::tests
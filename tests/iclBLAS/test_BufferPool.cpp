@@ -0,0 +1,68 @@
+// Copyright (c) 2017-2018 Intel Corporation
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//      http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <iclBLAS.h>
+#include <vector>
+
+TEST(BufferPool, repeated_calls_reuse_buffers)
+{
+    const int num = 100000;
+    std::vector<float> x(num + 1, 1.f);
+    std::vector<float> y(num + 1, 2.f);
+    float result = 0.f;
+
+    iclblasHandle_t handle;
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasCreate(&handle));
+
+    // Unaligned pointers: operands are copied to device buffers
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSdot(handle, num, x.data() + 1, 1, y.data() + 1, 1, &result));
+    EXPECT_FLOAT_EQ(2.f * num, result);
+
+    iclblasBufferPoolStats_t first;
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasGetBufferPoolStats(handle, &first));
+    EXPECT_GT(first.requests, 0u);
+    EXPECT_GT(first.allocations, 0u);
+    EXPECT_GT(first.cached_buffers, 0u);
+
+    const int calls = 10;
+    for (int i = 0; i < calls; ++i)
+    {
+        result = 0.f;
+        ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSdot(handle, num, x.data() + 1, 1, y.data() + 1, 1, &result));
+        EXPECT_FLOAT_EQ(2.f * num, result);
+    }
+
+    iclblasBufferPoolStats_t stats;
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasGetBufferPoolStats(handle, &stats));
+    EXPECT_EQ(first.allocations, stats.allocations);
+    EXPECT_EQ(first.requests * (calls + 1), stats.requests);
+    EXPECT_EQ(stats.requests - stats.allocations, stats.hits);
+    EXPECT_LE(stats.cached_bytes, stats.high_water_mark);
+
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasTrimBufferPool(handle));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasGetBufferPoolStats(handle, &stats));
+    EXPECT_EQ(0u, stats.cached_buffers);
+    EXPECT_EQ(0u, stats.cached_bytes);
+
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasDestroy(handle));
+}
+
+TEST(BufferPool, invalid_arguments)
+{
+    iclblasHandle_t handle;
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasCreate(&handle));
+    EXPECT_EQ(ICLBLAS_STATUS_INVALID_VALUE, iclblasGetBufferPoolStats(handle, nullptr));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasDestroy(handle));
+}
@@ -0,0 +1,118 @@
+// Copyright (c) 2017-2018 Intel Corporation
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//      http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <gtest/gtest.h>
+#include <iclBLAS.h>
+#include <complex>
+#include <vector>
+
+namespace
+{
+std::complex<float> op(iclblasOperation_t trans, const oclComplex_t* M, int ld, int row, int col)
+{
+    if (trans == ICLBLAS_OP_N)
+        return M[col * ld + row];
+    return trans == ICLBLAS_OP_C ? std::conj(M[row * ld + col]) : M[row * ld + col];
+}
+
+void test_strided(iclblasOperation_t transa, iclblasOperation_t transb, int m, int n, int k, int batch)
+{
+    const int lda = transa == ICLBLAS_OP_N ? m : k;
+    const int ldb = transb == ICLBLAS_OP_N ? k : n;
+    const int ldc = m;
+    const long long stride_a = lda * (transa == ICLBLAS_OP_N ? k : m);
+    const long long stride_b = ldb * (transb == ICLBLAS_OP_N ? n : k);
+    const long long stride_c = ldc * n;
+    const oclComplex_t alpha = { 1.f, 0.5f };
+    const oclComplex_t beta = { 0.5f, -1.f };
+
+    std::vector<oclComplex_t> A(stride_a * batch), B(stride_b * batch), C(stride_c * batch);
+    for (size_t i = 0; i < A.size(); ++i)
+        A[i] = { 0.25f * (i % 7), -0.5f * (i % 3) };
+    for (size_t i = 0; i < B.size(); ++i)
+        B[i] = { 0.5f * (i % 5), 0.25f * (i % 4) };
+    for (size_t i = 0; i < C.size(); ++i)
+        C[i] = { 1.f * (i % 3), 1.f };
+
+    auto ref_C = C;
+    for (int b = 0; b < batch; ++b)
+        for (int j = 0; j < n; ++j)
+            for (int i = 0; i < m; ++i)
+            {
+                std::complex<float> value = 0.f;
+                for (int l = 0; l < k; ++l)
+                    value += op(transa, &A[b * stride_a], lda, i, l) * op(transb, &B[b * stride_b], ldb, l, j);
+                auto& c = ref_C[b * stride_c + j * ldc + i];
+                c = alpha * value + beta * c;
+            }
+
+    iclblasHandle_t handle;
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasCreate(&handle));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasCgemmStridedBatched(handle, transa, transb, m, n, k, &alpha,
+                                                                 A.data(), lda, stride_a, B.data(), ldb, stride_b,
+                                                                 &beta, C.data(), ldc, stride_c, batch));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasDestroy(handle));
+
+    for (size_t i = 0; i < C.size(); ++i)
+    {
+        EXPECT_NEAR(ref_C[i].real(), C[i].real(), 1e-3f * std::abs(ref_C[i]) + 1e-3f) << "at " << i;
+        EXPECT_NEAR(ref_C[i].imag(), C[i].imag(), 1e-3f * std::abs(ref_C[i]) + 1e-3f) << "at " << i;
+    }
+}
+}
+
+TEST(CgemmBatched, strided)
+{
+    test_strided(ICLBLAS_OP_N, ICLBLAS_OP_N, 4, 3, 5, 6);
+    test_strided(ICLBLAS_OP_C, ICLBLAS_OP_T, 3, 4, 2, 3);
+    test_strided(ICLBLAS_OP_T, ICLBLAS_OP_C, 5, 2, 3, 4);
+}
+
+TEST(CgemmBatched, pointers_to_host_matrices)
+{
+    const int size = 2;
+    const oclComplex_t alpha = { 0.f, 1.f };
+    const oclComplex_t beta = { 0.f, 0.f };
+    // Identity times diagonal matrix with index on the diagonal
+    oclComplex_t A[3][4], B[3][4], C[3][4] = {};
+    oclComplex_t* a_ptrs[3];
+    oclComplex_t* b_ptrs[3];
+    oclComplex_t* c_ptrs[3];
+    for (int i = 0; i < 3; ++i)
+    {
+        const float v = static_cast<float>(i + 1);
+        A[i][0] = { 1.f, 0.f }; A[i][1] = { 0.f, 0.f }; A[i][2] = { 0.f, 0.f }; A[i][3] = { 1.f, 0.f };
+        B[i][0] = { v, 0.f };   B[i][1] = { 0.f, 0.f }; B[i][2] = { 0.f, 0.f }; B[i][3] = { v, v };
+        a_ptrs[i] = A[i];
+        b_ptrs[i] = B[i];
+        c_ptrs[2 - i] = C[i];
+    }
+
+    iclblasHandle_t handle;
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasCreate(&handle));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasCgemmBatched(handle, ICLBLAS_OP_N, ICLBLAS_OP_N, size, size, size, &alpha,
+                                                          a_ptrs, size, b_ptrs, size, &beta, c_ptrs, size, 3));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasDestroy(handle));
+
+    for (int i = 0; i < 3; ++i)
+    {
+        const float v = static_cast<float>(3 - i);
+        EXPECT_FLOAT_EQ(0.f, C[i][0].real());
+        EXPECT_FLOAT_EQ(v, C[i][0].imag());
+        EXPECT_FLOAT_EQ(-v, C[i][3].real());
+        EXPECT_FLOAT_EQ(v, C[i][3].imag());
+        EXPECT_FLOAT_EQ(0.f, std::abs(std::complex<float>(C[i][1])));
+    }
+}
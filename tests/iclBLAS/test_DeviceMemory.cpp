@@ -0,0 +1,213 @@
+// Copyright (c) 2017-2018 Intel Corporation
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//      http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <iclBLAS.h>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+struct DeviceMemory : public ::testing::Test
+{
+    void SetUp() override
+    {
+        ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasCreate(&handle));
+    }
+
+    void TearDown() override
+    {
+        ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasDestroy(handle));
+    }
+
+    float* alloc(size_t num)
+    {
+        void* ptr = nullptr;
+        EXPECT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasAlloc(handle, num * sizeof(float), &ptr));
+        return static_cast<float*>(ptr);
+    }
+
+    iclblasHandle_t handle;
+};
+
+TEST_F(DeviceMemory, vector_transfer)
+{
+    const int n = 100;
+    std::vector<float> x(2 * n);
+    for (int i = 0; i < 2 * n; ++i)
+        x[i] = static_cast<float>(i);
+
+    auto d_x = alloc(3 * n);
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSetVector(handle, n, sizeof(float), x.data(), 2, d_x, 3));
+
+    std::vector<float> y(n, -1.f);
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasGetVector(handle, n, sizeof(float), d_x, 3, y.data(), 1));
+    for (int i = 0; i < n; ++i)
+        EXPECT_FLOAT_EQ(2.f * i, y[i]);
+
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasFree(handle, d_x));
+}
+
+TEST_F(DeviceMemory, matrix_transfer)
+{
+    const int rows = 5;
+    const int cols = 4;
+    const int lda = 7;
+    const int ldb = 6;
+    std::vector<float> A(lda * cols);
+    for (size_t i = 0; i < A.size(); ++i)
+        A[i] = static_cast<float>(i);
+
+    auto d_B = alloc(ldb * cols);
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSetMatrix(handle, rows, cols, sizeof(float), A.data(), lda, d_B, ldb));
+
+    std::vector<float> C(rows * cols, -1.f);
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasGetMatrix(handle, rows, cols, sizeof(float), d_B, ldb, C.data(), rows));
+    for (int j = 0; j < cols; ++j)
+        for (int i = 0; i < rows; ++i)
+            EXPECT_FLOAT_EQ(A[j * lda + i], C[j * rows + i]);
+
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasFree(handle, d_B));
+}
+
+TEST_F(DeviceMemory, gemm_chain_on_device)
+{
+    const int n = 64;
+    std::vector<float> A(n * n, 0.f);
+    std::vector<float> B(n * n);
+    for (int i = 0; i < n; ++i)
+        A[i * n + i] = 2.f;
+    for (size_t i = 0; i < B.size(); ++i)
+        B[i] = static_cast<float>(i % 13);
+
+    auto d_A = alloc(n * n);
+    auto d_B = alloc(n * n);
+    auto d_C = alloc(n * n);
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSetMatrix(handle, n, n, sizeof(float), A.data(), n, d_A, n));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSetMatrix(handle, n, n, sizeof(float), B.data(), n, d_B, n));
+
+    // C = A * B, B = A * C: result stays on the device between calls
+    float alpha = 1.f;
+    float beta = 0.f;
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSgemm(handle, ICLBLAS_OP_N, ICLBLAS_OP_N, n, n, n, &alpha, d_A, n, d_B, n, &beta, d_C, n));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSgemm(handle, ICLBLAS_OP_N, ICLBLAS_OP_N, n, n, n, &alpha, d_A, n, d_C, n, &beta, d_B, n));
+
+    std::vector<float> result(n * n);
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasGetMatrix(handle, n, n, sizeof(float), d_B, n, result.data(), n));
+    for (size_t i = 0; i < B.size(); ++i)
+        EXPECT_FLOAT_EQ(4.f * B[i], result[i]);
+
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasFree(handle, d_A));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasFree(handle, d_B));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasFree(handle, d_C));
+}
+
+TEST_F(DeviceMemory, interior_pointer)
+{
+    const int n = 256;
+    // 32 floats = 128 bytes is sub-buffer alignment of most of devices
+    const int offset = 32;
+    std::vector<float> x(n, 1.f);
+    std::vector<float> y(n, 2.f);
+    auto d_x = alloc(n);
+    auto d_y = alloc(n);
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSetVector(handle, n, sizeof(float), x.data(), 1, d_x, 1));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSetVector(handle, n, sizeof(float), y.data(), 1, d_y, 1));
+
+    float alpha = 3.f;
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSaxpy(handle, n - offset, &alpha, d_x + offset, 1, d_y + offset, 1));
+
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasGetVector(handle, n, sizeof(float), d_y, 1, y.data(), 1));
+    for (int i = 0; i < n; ++i)
+        EXPECT_FLOAT_EQ(i < offset ? 2.f : 5.f, y[i]) << i;
+
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasFree(handle, d_x));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasFree(handle, d_y));
+}
+
+TEST_F(DeviceMemory, invalid_arguments)
+{
+    void* ptr = nullptr;
+    float host[4] = {};
+    EXPECT_EQ(ICLBLAS_STATUS_INVALID_VALUE, iclblasAlloc(handle, 0, &ptr));
+    EXPECT_EQ(ICLBLAS_STATUS_INVALID_VALUE, iclblasAlloc(handle, 16, nullptr));
+    EXPECT_EQ(ICLBLAS_STATUS_INVALID_VALUE, iclblasFree(handle, host));
+    // Host pointer passed as device one
+    EXPECT_EQ(ICLBLAS_STATUS_INVALID_VALUE, iclblasSetVector(handle, 4, sizeof(float), host, 1, host, 1));
+    EXPECT_EQ(ICLBLAS_STATUS_INVALID_VALUE, iclblasSetMatrix(handle, 4, 1, sizeof(float), host, 2, host, 4));
+}
+
+TEST_F(DeviceMemory, free_with_other_handle)
+{
+    auto d_x = alloc(16);
+    iclblasHandle_t other;
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasCreate(&other));
+    EXPECT_EQ(ICLBLAS_STATUS_INVALID_VALUE, iclblasFree(other, d_x));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasDestroy(other));
+
+    // The memory is still valid
+    float x[16] = {};
+    EXPECT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSetVector(handle, 16, sizeof(float), x, 1, d_x, 1));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasFree(handle, d_x));
+}
+
+/// Chain of GEMMs with operands transferred on every call vs kept in device memory
+TEST_F(DeviceMemory, benchmark_gemm_chain)
+{
+    const int n = 512;
+    const int chain = 8;
+    float alpha = 1.f;
+    float beta = 0.f;
+    std::vector<float> A(n * n, 0.001f);
+    std::vector<std::vector<float>> C(chain + 1, std::vector<float>(n * n, 1.f));
+
+    // Warm up: builds kernels
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSgemm(handle, ICLBLAS_OP_N, ICLBLAS_OP_N, n, n, n, &alpha,
+                                                   A.data(), n, C[0].data(), n, &beta, C[1].data(), n));
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < chain; ++i)
+    {
+        ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSgemm(handle, ICLBLAS_OP_N, ICLBLAS_OP_N, n, n, n, &alpha,
+                                                       A.data(), n, C[i].data(), n, &beta, C[i + 1].data(), n));
+    }
+    auto host_time = std::chrono::steady_clock::now() - start;
+
+    std::vector<float*> d_C(chain + 1);
+    auto d_A = alloc(n * n);
+    for (auto& c : d_C)
+        c = alloc(n * n);
+
+    start = std::chrono::steady_clock::now();
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSetMatrix(handle, n, n, sizeof(float), A.data(), n, d_A, n));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSetMatrix(handle, n, n, sizeof(float), C[0].data(), n, d_C[0], n));
+    for (int i = 0; i < chain; ++i)
+    {
+        ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSgemm(handle, ICLBLAS_OP_N, ICLBLAS_OP_N, n, n, n, &alpha,
+                                                       d_A, n, d_C[i], n, &beta, d_C[i + 1], n));
+    }
+    std::vector<float> result(n * n);
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasGetMatrix(handle, n, n, sizeof(float), d_C[chain], n, result.data(), n));
+    auto device_time = std::chrono::steady_clock::now() - start;
+
+    for (size_t i = 0; i < result.size(); i += 997)
+        EXPECT_NEAR(C[chain][i], result[i], 1e-3f * C[chain][i]);
+
+    using ms = std::chrono::duration<double, std::milli>;
+    std::printf("%d chained %dx%d Sgemm: %.3f ms host memory, %.3f ms device memory\n", chain, n, n,
+                ms(host_time).count(), ms(device_time).count());
+
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasFree(handle, d_A));
+    for (auto c : d_C)
+        ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasFree(handle, c));
+}
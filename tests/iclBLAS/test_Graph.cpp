@@ -0,0 +1,238 @@
+// Copyright (c) 2017-2018 Intel Corporation
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//      http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <gtest/gtest.h>
+#include <iclBLAS.h>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+struct Graph : public ::testing::Test
+{
+    void SetUp() override
+    {
+        ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasCreate(&handle));
+    }
+
+    void TearDown() override
+    {
+        ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasDestroy(handle));
+    }
+
+    iclblasHandle_t handle;
+};
+
+TEST_F(Graph, replay_uses_current_host_data)
+{
+    // Odd size is not zero-copy: host data is copied on every launch
+    const int n = 37;
+    std::vector<float> x(n, 1.f);
+    std::vector<float> y(n, 2.f);
+    float two = 2.f;
+    float half = .5f;
+
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasGraphBeginCapture(handle));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSaxpy(handle, n, &two, x.data(), 1, y.data(), 1));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSscal(handle, n, &half, y.data(), 1));
+    iclblasGraph_t graph;
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasGraphEndCapture(handle, &graph));
+
+    // Nothing is executed during capture
+    for (auto v : y)
+        EXPECT_FLOAT_EQ(2.f, v);
+
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasGraphLaunch(handle, graph));
+    for (auto v : y)
+        EXPECT_FLOAT_EQ(2.f, v);
+
+    for (auto& v : x)
+        v = 3.f;
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasGraphLaunch(handle, graph));
+    for (auto v : y)
+        EXPECT_FLOAT_EQ(4.f, v);
+
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasGraphDestroy(graph));
+}
+
+TEST_F(Graph, update_pointer)
+{
+    const int n = 64;
+    std::vector<float> x1(n, 1.f), y1(n, 1.f);
+    std::vector<float> x2(n, 2.f), y2(n + 5, 10.f);
+    float alpha = 1.f;
+
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasGraphBeginCapture(handle));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSaxpy(handle, n, &alpha, x1.data(), 1, y1.data(), 1));
+    iclblasGraph_t graph;
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasGraphEndCapture(handle, &graph));
+
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasGraphUpdatePointer(graph, x1.data(), x2.data()));
+    // Unaligned pointer gets a copied buffer instead of the host memory
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasGraphUpdatePointer(graph, y1.data(), y2.data() + 1));
+    EXPECT_EQ(ICLBLAS_STATUS_INVALID_VALUE, iclblasGraphUpdatePointer(graph, y1.data(), y2.data()));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasGraphLaunch(handle, graph));
+
+    for (int i = 0; i < n; ++i)
+    {
+        EXPECT_FLOAT_EQ(1.f, y1[i]);
+        EXPECT_FLOAT_EQ(12.f, y2[i + 1]);
+    }
+    EXPECT_FLOAT_EQ(10.f, y2[0]);
+    EXPECT_FLOAT_EQ(10.f, y2[n + 1]);
+
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasGraphDestroy(graph));
+}
+
+TEST_F(Graph, zero_filled_buffers_on_every_launch)
+{
+    // Upper triangle of ones in packed format
+    const int n = 4;
+    std::vector<float> AP(n * (n + 1) / 2, 1.f);
+    std::vector<float> x(n, 1.f);
+
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasGraphBeginCapture(handle));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasStpmv(handle, ICLBLAS_FILL_MODE_UPPER, ICLBLAS_OP_N, ICLBLAS_DIAG_NON_UNIT,
+                                                   n, AP.data(), x.data(), 1));
+    iclblasGraph_t graph;
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasGraphEndCapture(handle, &graph));
+
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasGraphLaunch(handle, graph));
+    const float first[n] = { 4.f, 3.f, 2.f, 1.f };
+    for (int i = 0; i < n; ++i)
+        EXPECT_FLOAT_EQ(first[i], x[i]);
+
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasGraphLaunch(handle, graph));
+    const float second[n] = { 10.f, 6.f, 3.f, 1.f };
+    for (int i = 0; i < n; ++i)
+        EXPECT_FLOAT_EQ(second[i], x[i]);
+
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasGraphDestroy(graph));
+}
+
+TEST_F(Graph, invalid_capture_state)
+{
+    iclblasGraph_t graph;
+    EXPECT_EQ(ICLBLAS_STATUS_INVALID_VALUE, iclblasGraphEndCapture(handle, &graph));
+
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasGraphBeginCapture(handle));
+    EXPECT_EQ(ICLBLAS_STATUS_INVALID_VALUE, iclblasGraphBeginCapture(handle));
+    EXPECT_EQ(ICLBLAS_STATUS_INVALID_VALUE, iclblasGraphEndCapture(handle, nullptr));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasGraphEndCapture(handle, &graph));
+
+    // Empty graph
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasGraphLaunch(handle, graph));
+
+    iclblasGraph_t nested;
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasGraphBeginCapture(handle));
+    EXPECT_EQ(ICLBLAS_STATUS_INVALID_VALUE, iclblasGraphLaunch(handle, graph));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasGraphEndCapture(handle, &nested));
+
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasGraphDestroy(nested));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasGraphDestroy(graph));
+}
+
+TEST_F(Graph, device_scalar_not_captured)
+{
+    const int n = 2;
+    std::vector<float> A(n * n, 1.f);
+    std::vector<float> x(n, 1.f);
+    std::vector<float> y(n, 1.f);
+    const float scalars[] = { 2.f, 0.5f };
+
+    void* ptr = nullptr;
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasAlloc(handle, 2 * sizeof(float), &ptr));
+    auto d_scalars = static_cast<float*>(ptr);
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSetVector(handle, 2, sizeof(float), scalars, 1, d_scalars, 1));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSetPointerMode(handle, ICLBLAS_POINTER_MODE_DEVICE));
+
+    // Value read on the host at capture would be stale at replay
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasGraphBeginCapture(handle));
+    EXPECT_EQ(ICLBLAS_STATUS_NOT_SUPPORTED, iclblasSgemv(handle, ICLBLAS_OP_N, n, n, d_scalars, A.data(), n, x.data(), 1,
+                                                         d_scalars + 1, y.data(), 1));
+    iclblasGraph_t graph;
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasGraphEndCapture(handle, &graph));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasGraphDestroy(graph));
+
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasFree(handle, d_scalars));
+}
+
+/// Per-iteration host time of a sequence of small calls on device memory enqueued to a stream
+TEST_F(Graph, benchmark_replay)
+{
+    const int n = 1024;
+    const int calls = 30;
+    const int iterations = 50;
+    std::vector<float> host(n, 1.f);
+    void* x = nullptr;
+    void* y = nullptr;
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasAlloc(handle, n * sizeof(float), &x));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasAlloc(handle, n * sizeof(float), &y));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSetVector(handle, n, sizeof(float), host.data(), 1, x, 1));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSetVector(handle, n, sizeof(float), host.data(), 1, y, 1));
+
+    iclblasStream_t stream;
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasStreamCreate(handle, &stream));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSetStream(handle, stream));
+
+    float alpha = 1e-3f;
+    float scale = .999f;
+    auto sequence = [&]()
+    {
+        for (int i = 0; i < calls / 2; ++i)
+        {
+            ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSaxpy(handle, n, &alpha, static_cast<float*>(x), 1, static_cast<float*>(y), 1));
+            ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSscal(handle, n, &scale, static_cast<float*>(y), 1));
+        }
+    };
+
+    using ms = std::chrono::duration<double, std::milli>;
+    // Warm up: builds the kernels
+    sequence();
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasStreamSynchronize(stream));
+
+    ms direct(0);
+    for (int i = 0; i < iterations; ++i)
+    {
+        auto start = std::chrono::steady_clock::now();
+        sequence();
+        direct += std::chrono::steady_clock::now() - start;
+        ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasStreamSynchronize(stream));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasGraphBeginCapture(handle));
+    sequence();
+    iclblasGraph_t graph;
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasGraphEndCapture(handle, &graph));
+    ms capture = std::chrono::steady_clock::now() - start;
+
+    ms replay(0);
+    for (int i = 0; i < iterations; ++i)
+    {
+        start = std::chrono::steady_clock::now();
+        ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasGraphLaunch(handle, graph));
+        replay += std::chrono::steady_clock::now() - start;
+        ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasStreamSynchronize(stream));
+    }
+
+    std::printf("%d calls per iteration, host time: direct %.3f ms, replay %.3f ms (capture %.3f ms)\n", calls,
+                direct.count() / iterations, replay.count() / iterations, capture.count());
+
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSetStream(handle, nullptr));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasGraphDestroy(graph));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasStreamDestroy(stream));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasFree(handle, x));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasFree(handle, y));
+}
@@ -0,0 +1,126 @@
+// Copyright (c) 2017-2018 Intel Corporation
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//      http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <iclBLAS.h>
+#include <vector>
+
+struct HostRegister : public ::testing::Test
+{
+    void SetUp() override
+    {
+        ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasCreate(&handle));
+    }
+
+    void TearDown() override
+    {
+        ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasDestroy(handle));
+    }
+
+    unsigned long long pool_requests()
+    {
+        iclblasBufferPoolStats_t stats;
+        EXPECT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasGetBufferPoolStats(handle, &stats));
+        return stats.requests;
+    }
+
+    iclblasHandle_t handle;
+};
+
+TEST_F(HostRegister, registered_operands_create_no_buffers)
+{
+    const int num = 1000;
+    std::vector<float> x(num + 1, 1.f);
+    std::vector<float> y(num + 1, 0.f);
+    float alpha = 2.f;
+
+    // Unaligned ranges get device copies
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasHostRegister(handle, x.data() + 1, num * sizeof(float)));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasHostRegister(handle, y.data() + 1, num * sizeof(float)));
+
+    auto requests = pool_requests();
+    for (int i = 1; i <= 5; ++i)
+    {
+        ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSaxpy(handle, num, &alpha, x.data() + 1, 1, y.data() + 1, 1));
+        EXPECT_FLOAT_EQ(2.f * i, y[1]);
+        EXPECT_FLOAT_EQ(2.f * i, y[num]);
+    }
+    EXPECT_EQ(requests, pool_requests());
+
+    // Host modification is visible after sync
+    x[1] = 10.f;
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasHostSync(handle, x.data() + 1, sizeof(float)));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSaxpy(handle, num, &alpha, x.data() + 1, 1, y.data() + 1, 1));
+    EXPECT_FLOAT_EQ(30.f, y[1]);
+    EXPECT_FLOAT_EQ(12.f, y[2]);
+
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasHostUnregister(handle, x.data() + 1));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasHostUnregister(handle, y.data() + 1));
+}
+
+TEST_F(HostRegister, interior_pointers)
+{
+    const int num = 1024;
+    std::vector<float> x(num);
+    for (int i = 0; i < num; ++i)
+        x[i] = static_cast<float>(i);
+    std::vector<float> y(num, 1.f);
+
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasHostRegister(handle, x.data(), num * sizeof(float)));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasHostRegister(handle, y.data(), num * sizeof(float)));
+
+    // Offsets aligned for sub-buffers and unaligned ones
+    for (int offset : { 0, 1, 64, 255 })
+    {
+        const int n = 100;
+        float result = 0.f;
+        float expected = 0.f;
+        for (int i = 0; i < n; ++i)
+            expected += x[offset + i];
+        ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSdot(handle, n, x.data() + offset, 1, y.data() + offset, 1, &result));
+        EXPECT_FLOAT_EQ(expected, result) << "offset " << offset;
+    }
+
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasHostUnregister(handle, x.data()));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasHostUnregister(handle, y.data()));
+}
+
+TEST_F(HostRegister, output_of_interior_pointer_is_used_by_next_call)
+{
+    const int num = 256;
+    std::vector<float> x(num, 1.f);
+    std::vector<float> y(num, 1.f);
+    float alpha = 1.f;
+
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasHostRegister(handle, y.data(), num * sizeof(float)));
+
+    // Unaligned interior output goes through the host, registered device copy must be refreshed
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSaxpy(handle, 10, &alpha, x.data(), 1, y.data() + 3, 1));
+    EXPECT_FLOAT_EQ(2.f, y[3]);
+
+    float result = 0.f;
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSdot(handle, num, x.data(), 1, y.data(), 1, &result));
+    EXPECT_FLOAT_EQ(num + 10.f, result);
+
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasHostUnregister(handle, y.data()));
+}
+
+TEST_F(HostRegister, invalid_arguments)
+{
+    std::vector<float> x(100);
+    EXPECT_EQ(ICLBLAS_STATUS_INVALID_VALUE, iclblasHostRegister(handle, nullptr, 16));
+    EXPECT_EQ(ICLBLAS_STATUS_INVALID_VALUE, iclblasHostRegister(handle, x.data(), 0));
+    EXPECT_EQ(ICLBLAS_STATUS_INVALID_VALUE, iclblasHostUnregister(handle, nullptr));
+    EXPECT_EQ(ICLBLAS_STATUS_INVALID_VALUE, iclblasHostSync(handle, nullptr, 0));
+}
@@ -0,0 +1,135 @@
+// Copyright (c) 2017-2018 Intel Corporation
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//      http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <iclBLAS.h>
+#include <vector>
+
+namespace
+{
+/// Column-major C = alpha * op(A) * op(B) + beta * C
+void reference_gemm(bool transa, bool transb, int m, int n, int k, float alpha, const float* A, int lda,
+                    const float* B, int ldb, float beta, float* C, int ldc)
+{
+    for (int j = 0; j < n; ++j)
+    {
+        for (int i = 0; i < m; ++i)
+        {
+            double sum = 0;
+            for (int l = 0; l < k; ++l)
+                sum += double(transa ? A[i * lda + l] : A[l * lda + i]) * (transb ? B[l * ldb + j] : B[j * ldb + l]);
+            C[j * ldc + i] = static_cast<float>(alpha * sum + beta * C[j * ldc + i]);
+        }
+    }
+}
+
+std::vector<float> make_data(size_t size, int seed)
+{
+    std::vector<float> data(size);
+    for (size_t i = 0; i < size; ++i)
+        data[i] = static_cast<float>((i * 7 + seed) % 13) / 13.f - 0.5f;
+    return data;
+}
+}
+
+struct MultiDevice : public ::testing::Test
+{
+    void SetUp() override
+    {
+        ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasGetDeviceCount(&count));
+        if (count == 0)
+        {
+            EXPECT_EQ(ICLBLAS_STATUS_INVALID_VALUE, iclblasCreateWithDevice(&handle, 0));
+            return;
+        }
+        ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasCreateWithDevice(&handle, count - 1));
+        // Several contexts on the same device exercise the distribution without several devices
+        const int devices[] = { count - 1, count - 1, 0 };
+        ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSetDevices(handle, devices, 3));
+    }
+
+    void TearDown() override
+    {
+        if (handle != nullptr)
+        {
+            ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasDestroy(handle));
+        }
+    }
+
+    int count = 0;
+    iclblasHandle_t handle = nullptr;
+};
+
+TEST_F(MultiDevice, invalid_devices)
+{
+    EXPECT_EQ(ICLBLAS_STATUS_INVALID_VALUE, iclblasGetDeviceCount(nullptr));
+    EXPECT_EQ(ICLBLAS_STATUS_INVALID_VALUE, iclblasCreateWithDevice(&handle, count));
+    EXPECT_EQ(ICLBLAS_STATUS_INVALID_VALUE, iclblasCreateWithDevice(&handle, -1));
+    if (handle == nullptr)
+        return;
+    const int devices[] = { count };
+    EXPECT_EQ(ICLBLAS_STATUS_INVALID_VALUE, iclblasSetDevices(handle, devices, 1));
+    EXPECT_EQ(ICLBLAS_STATUS_INVALID_VALUE, iclblasSetDevices(handle, nullptr, 1));
+    EXPECT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSetDevices(handle, nullptr, 0));
+}
+
+TEST_F(MultiDevice, sgemm_column_panels)
+{
+    if (handle == nullptr)
+        return;
+
+    const int m = 300, n = 520, k = 270;
+    const float alpha = 1.5f, beta = 0.5f;
+    for (auto transb : { ICLBLAS_OP_N, ICLBLAS_OP_T })
+    {
+        const int lda = m + 3;
+        const int ldb = transb == ICLBLAS_OP_N ? k + 5 : n + 5;
+        const int ldc = m + 1;
+        auto A = make_data(size_t(lda) * k, 1);
+        auto B = make_data(size_t(ldb) * (transb == ICLBLAS_OP_N ? n : k), 2);
+        auto C = make_data(size_t(ldc) * n, 3);
+        auto expected = C;
+        reference_gemm(false, transb != ICLBLAS_OP_N, m, n, k, alpha, A.data(), lda, B.data(), ldb,
+                       beta, expected.data(), ldc);
+
+        ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSgemm(handle, ICLBLAS_OP_N, transb, m, n, k, &alpha, A.data(), lda,
+                                                       B.data(), ldb, &beta, C.data(), ldc));
+        for (size_t i = 0; i < C.size(); ++i)
+            ASSERT_NEAR(expected[i], C[i], 1e-3f) << "index " << i;
+    }
+}
+
+TEST_F(MultiDevice, sgemm_strided_batched)
+{
+    if (handle == nullptr)
+        return;
+
+    const int m = 128, n = 128, k = 128, batch = 11;
+    const int lda = m, ldb = k, ldc = m;
+    const long long stride = lda * k + 16;
+    const float alpha = 1.f, beta = 0.f;
+    auto A = make_data(size_t(stride) * batch, 4);
+    auto B = make_data(size_t(stride) * batch, 5);
+    std::vector<float> C(size_t(stride) * batch, 0.f);
+    auto expected = C;
+    for (int b = 0; b < batch; ++b)
+        reference_gemm(false, false, m, n, k, alpha, A.data() + b * stride, lda, B.data() + b * stride, ldb,
+                       beta, expected.data() + b * stride, ldc);
+
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSgemmStridedBatched(handle, ICLBLAS_OP_N, ICLBLAS_OP_N, m, n, k, &alpha,
+                                                                 A.data(), lda, stride, B.data(), ldb, stride,
+                                                                 &beta, C.data(), ldc, stride, batch));
+    for (size_t i = 0; i < C.size(); ++i)
+        ASSERT_NEAR(expected[i], C[i], 1e-3f) << "index " << i;
+}
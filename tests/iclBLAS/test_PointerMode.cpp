@@ -0,0 +1,124 @@
+// Copyright (c) 2017-2018 Intel Corporation
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//      http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <gtest/gtest.h>
+#include <iclBLAS.h>
+#include <vector>
+
+struct PointerMode : public ::testing::Test
+{
+    void SetUp() override
+    {
+        ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasCreate(&handle));
+    }
+
+    void TearDown() override
+    {
+        ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasDestroy(handle));
+    }
+
+    float* alloc(size_t num)
+    {
+        void* ptr = nullptr;
+        EXPECT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasAlloc(handle, num * sizeof(float), &ptr));
+        return static_cast<float*>(ptr);
+    }
+
+    iclblasHandle_t handle;
+};
+
+TEST_F(PointerMode, set_get)
+{
+    iclblasPointerMode_t mode = ICLBLAS_POINTER_MODE_DEVICE;
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasGetPointerMode(handle, &mode));
+    EXPECT_EQ(ICLBLAS_POINTER_MODE_HOST, mode);
+
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSetPointerMode(handle, ICLBLAS_POINTER_MODE_DEVICE));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasGetPointerMode(handle, &mode));
+    EXPECT_EQ(ICLBLAS_POINTER_MODE_DEVICE, mode);
+
+    EXPECT_EQ(ICLBLAS_STATUS_INVALID_VALUE, iclblasSetPointerMode(handle, static_cast<iclblasPointerMode_t>(42)));
+    EXPECT_EQ(ICLBLAS_STATUS_INVALID_VALUE, iclblasGetPointerMode(handle, nullptr));
+}
+
+TEST_F(PointerMode, dot_result_as_axpy_alpha)
+{
+    const int n = 64;
+    std::vector<float> x(n), y(n);
+    float dot = 0.f;
+    for (int i = 0; i < n; ++i)
+    {
+        x[i] = 1.f / (i + 1);
+        y[i] = 0.5f * i;
+        dot += x[i] * x[i];
+    }
+
+    auto d_x = alloc(n);
+    auto d_y = alloc(n);
+    auto d_alpha = alloc(1);
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSetVector(handle, n, sizeof(float), x.data(), 1, d_x, 1));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSetVector(handle, n, sizeof(float), y.data(), 1, d_y, 1));
+
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSetPointerMode(handle, ICLBLAS_POINTER_MODE_DEVICE));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSdot(handle, n, d_x, 1, d_x, 1, d_alpha));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSaxpy(handle, n, d_alpha, d_x, 1, d_y, 1));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSscal(handle, n, d_alpha, d_y, 1));
+
+    float alpha = 0.f;
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasGetVector(handle, 1, sizeof(float), d_alpha, 1, &alpha, 1));
+    EXPECT_NEAR(dot, alpha, 1e-4f);
+
+    std::vector<float> result(n);
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasGetVector(handle, n, sizeof(float), d_y, 1, result.data(), 1));
+    for (int i = 0; i < n; ++i)
+        EXPECT_NEAR(dot * (y[i] + dot * x[i]), result[i], 1e-3f);
+
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasFree(handle, d_alpha));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasFree(handle, d_y));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasFree(handle, d_x));
+}
+
+TEST_F(PointerMode, device_scalars_and_results)
+{
+    const int m = 3;
+    const int n = 2;
+    std::vector<float> A = { 1.f, 2.f, 3.f, 4.f, 5.f, 6.f };
+    std::vector<float> x = { 1.f, -1.f };
+    std::vector<float> y = { 1.f, 1.f, 1.f };
+    const float scalars[] = { 2.f, 0.5f };
+
+    auto d_scalars = alloc(2);
+    auto d_nrm = alloc(1);
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSetVector(handle, 2, sizeof(float), scalars, 1, d_scalars, 1));
+
+    // y = 2 * A * x + 0.5 * y with host matrices and device scalars
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSetPointerMode(handle, ICLBLAS_POINTER_MODE_DEVICE));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSgemv(handle, ICLBLAS_OP_N, m, n, d_scalars, A.data(), m, x.data(), 1,
+                                                   d_scalars + 1, y.data(), 1));
+    EXPECT_FLOAT_EQ(-5.5f, y[0]);
+    EXPECT_FLOAT_EQ(-5.5f, y[1]);
+    EXPECT_FLOAT_EQ(-5.5f, y[2]);
+
+    // Result of empty reduction is stored in device memory
+    const float one = 1.f;
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSetVector(handle, 1, sizeof(float), &one, 1, d_nrm, 1));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSnrm2(handle, 0, x.data(), 1, d_nrm));
+    float nrm = -1.f;
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasGetVector(handle, 1, sizeof(float), d_nrm, 1, &nrm, 1));
+    EXPECT_FLOAT_EQ(0.f, nrm);
+
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasFree(handle, d_nrm));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasFree(handle, d_scalars));
+}
@@ -0,0 +1,100 @@
+// Copyright (c) 2017-2018 Intel Corporation
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//      http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <gtest/gtest.h>
+#include <iclBLAS.h>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <vector>
+
+struct Profiling : public ::testing::Test
+{
+    void SetUp() override
+    {
+        ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasCreate(&handle));
+    }
+
+    void TearDown() override
+    {
+        ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasDestroy(handle));
+    }
+
+    iclblasHandle_t handle;
+};
+
+TEST_F(Profiling, toggle_keeps_results)
+{
+    float alpha = 2.f;
+    std::vector<float> x(64, 1.f);
+    std::vector<float> y(64, 1.f);
+
+    int enabled = -1;
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSetProfiling(handle, 0));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasGetProfiling(handle, &enabled));
+    EXPECT_EQ(0, enabled);
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSaxpy(handle, 64, &alpha, x.data(), 1, y.data(), 1));
+
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSetProfiling(handle, 1));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasGetProfiling(handle, &enabled));
+    EXPECT_NE(0, enabled);
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSaxpy(handle, 64, &alpha, x.data(), 1, y.data(), 1));
+
+    for (auto v : y)
+        EXPECT_FLOAT_EQ(5.f, v);
+    EXPECT_EQ(ICLBLAS_STATUS_INVALID_VALUE, iclblasGetProfiling(handle, nullptr));
+}
+
+/// Small level 1 calls dominated by submission overhead, with and without queue profiling
+TEST_F(Profiling, benchmark_level1_overhead)
+{
+    const int n = 256;
+    const int iterations = 500;
+    float alpha = 0.5f;
+    float result = 0.f;
+    std::vector<float> x(n, 1.f);
+    std::vector<float> y(n, 2.f);
+
+    auto measure = [&](const std::function<iclblasStatus_t()>& func)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i)
+            EXPECT_EQ(ICLBLAS_STATUS_SUCCESS, func());
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count()
+            / 1e3 / iterations;
+    };
+    struct
+    {
+        const char* name;
+        std::function<iclblasStatus_t()> func;
+    } calls[] = {
+        { "Saxpy", [&] { return iclblasSaxpy(handle, n, &alpha, x.data(), 1, y.data(), 1); } },
+        { "Sscal", [&] { return iclblasSscal(handle, n, &alpha, y.data(), 1); } },
+        { "Sdot",  [&] { return iclblasSdot(handle, n, x.data(), 1, y.data(), 1, &result); } },
+    };
+
+    for (auto& call : calls)
+    {
+        // Warm up: builds the modules
+        call.func();
+
+        ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSetProfiling(handle, 0));
+        auto plain = measure(call.func);
+        ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSetProfiling(handle, 1));
+        auto profiled = measure(call.func);
+        std::printf("%s n=%d: %.2f us per call, %.2f us with profiling\n", call.name, n, plain, profiled);
+    }
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSetProfiling(handle, 0));
+}
@@ -0,0 +1,238 @@
+// Copyright (c) 2017-2018 Intel Corporation
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//      http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <gtest/gtest.h>
+#include <iclBLAS.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <vector>
+
+namespace
+{
+// Column-major reference product of batch item
+void reference_gemm(bool transa, bool transb, int m, int n, int k, float alpha, const float* A, int lda,
+                    const float* B, int ldb, float beta, float* C, int ldc)
+{
+    for (int j = 0; j < n; ++j)
+        for (int i = 0; i < m; ++i)
+        {
+            float value = 0.f;
+            for (int l = 0; l < k; ++l)
+                value += (transa ? A[i * lda + l] : A[l * lda + i]) * (transb ? B[l * ldb + j] : B[j * ldb + l]);
+            C[j * ldc + i] = alpha * value + beta * C[j * ldc + i];
+        }
+}
+
+std::vector<float> sequence(size_t size, float scale)
+{
+    std::vector<float> result(size);
+    for (size_t i = 0; i < size; ++i)
+        result[i] = scale * static_cast<float>(i % 13) - 1.f;
+    return result;
+}
+}
+
+struct SgemmBatched : public ::testing::Test
+{
+    void SetUp() override
+    {
+        ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasCreate(&handle));
+    }
+
+    void TearDown() override
+    {
+        ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasDestroy(handle));
+    }
+
+    void test_strided(iclblasOperation_t transa, iclblasOperation_t transb, int m, int n, int k, int batch)
+    {
+        const int lda = transa == ICLBLAS_OP_N ? m : k;
+        const int ldb = transb == ICLBLAS_OP_N ? k : n;
+        const int ldc = m + 1;
+        const long long stride_a = lda * (transa == ICLBLAS_OP_N ? k : m);
+        const long long stride_b = ldb * (transb == ICLBLAS_OP_N ? n : k);
+        const long long stride_c = ldc * n;
+        const float alpha = 0.5f;
+        const float beta = 2.f;
+
+        auto A = sequence(stride_a * batch, 0.25f);
+        auto B = sequence(stride_b * batch, 0.5f);
+        auto C = sequence(stride_c * batch, 1.f);
+        auto ref_C = C;
+        for (int i = 0; i < batch; ++i)
+            reference_gemm(transa != ICLBLAS_OP_N, transb != ICLBLAS_OP_N, m, n, k, alpha, &A[i * stride_a], lda,
+                           &B[i * stride_b], ldb, beta, &ref_C[i * stride_c], ldc);
+
+        ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSgemmStridedBatched(handle, transa, transb, m, n, k, &alpha,
+                                                                     A.data(), lda, stride_a, B.data(), ldb, stride_b,
+                                                                     &beta, C.data(), ldc, stride_c, batch));
+        for (size_t i = 0; i < C.size(); ++i)
+            EXPECT_NEAR(ref_C[i], C[i], 1e-3f * std::abs(ref_C[i]) + 1e-3f) << "at " << i;
+    }
+
+    iclblasHandle_t handle;
+};
+
+TEST_F(SgemmBatched, strided_ntransAB)
+{
+    test_strided(ICLBLAS_OP_N, ICLBLAS_OP_N, 16, 8, 16, 20);
+    test_strided(ICLBLAS_OP_N, ICLBLAS_OP_N, 7, 5, 3, 9);
+}
+
+TEST_F(SgemmBatched, strided_trans)
+{
+    test_strided(ICLBLAS_OP_T, ICLBLAS_OP_N, 8, 8, 4, 10);
+    test_strided(ICLBLAS_OP_N, ICLBLAS_OP_T, 5, 9, 6, 3);
+    test_strided(ICLBLAS_OP_T, ICLBLAS_OP_T, 4, 3, 2, 5);
+}
+
+TEST_F(SgemmBatched, strided_invalid_arguments)
+{
+    float alpha = 1.f, beta = 0.f;
+    float A[4] = {}, B[4] = {}, C[4] = {};
+    EXPECT_EQ(ICLBLAS_STATUS_INVALID_VALUE, iclblasSgemmStridedBatched(handle, ICLBLAS_OP_N, ICLBLAS_OP_N, 2, 2, 2, &alpha,
+                                                                       A, 2, -4, B, 2, 4, &beta, C, 2, 4, 1));
+    EXPECT_EQ(ICLBLAS_STATUS_INVALID_VALUE, iclblasSgemmStridedBatched(handle, ICLBLAS_OP_N, ICLBLAS_OP_N, 2, 2, 2, &alpha,
+                                                                       A, 2, 4, B, 2, 4, &beta, C, 2, 4, -1));
+    EXPECT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSgemmStridedBatched(handle, ICLBLAS_OP_N, ICLBLAS_OP_N, 2, 2, 2, &alpha,
+                                                                 A, 2, 4, B, 2, 4, &beta, C, 2, 4, 0));
+}
+
+TEST_F(SgemmBatched, pointers_to_host_matrices)
+{
+    const int m = 6, n = 4, k = 5, batch = 7;
+    const float alpha = 1.5f, beta = -1.f;
+    std::vector<std::vector<float>> A, B, C, ref_C;
+    std::vector<float*> a_ptrs, b_ptrs, c_ptrs;
+    for (int i = 0; i < batch; ++i)
+    {
+        A.push_back(sequence(m * k, 0.1f * (i + 1)));
+        B.push_back(sequence(k * n, 0.2f));
+        C.push_back(sequence(m * n, 1.f));
+    }
+    ref_C = C;
+    for (int i = 0; i < batch; ++i)
+    {
+        reference_gemm(false, false, m, n, k, alpha, A[i].data(), m, B[i].data(), k, beta, ref_C[i].data(), m);
+        a_ptrs.push_back(A[i].data());
+        b_ptrs.push_back(B[i].data());
+        c_ptrs.push_back(C[i].data());
+    }
+
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSgemmBatched(handle, ICLBLAS_OP_N, ICLBLAS_OP_N, m, n, k, &alpha,
+                                                          a_ptrs.data(), m, b_ptrs.data(), k, &beta,
+                                                          c_ptrs.data(), m, batch));
+    for (int i = 0; i < batch; ++i)
+        for (int j = 0; j < m * n; ++j)
+            EXPECT_NEAR(ref_C[i][j], C[i][j], 1e-3f * std::abs(ref_C[i][j]) + 1e-3f);
+}
+
+TEST_F(SgemmBatched, pointers_to_device_matrices)
+{
+    const int m = 8, n = 8, k = 8, batch = 5;
+    const int size = m * n;
+    const float alpha = 1.f, beta = 0.f;
+    auto A = sequence(size * batch, 0.5f);
+    auto B = sequence(size * batch, 0.25f);
+    std::vector<float> ref_C(size * batch);
+    for (int i = 0; i < batch; ++i)
+        reference_gemm(false, false, m, n, k, alpha, &A[i * size], m, &B[i * size], k, beta, &ref_C[i * size], m);
+
+    void* d_A = nullptr;
+    void* d_B = nullptr;
+    void* d_C = nullptr;
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasAlloc(handle, A.size() * sizeof(float), &d_A));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasAlloc(handle, B.size() * sizeof(float), &d_B));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasAlloc(handle, ref_C.size() * sizeof(float), &d_C));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSetVector(handle, size * batch, sizeof(float), A.data(), 1, d_A, 1));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSetVector(handle, size * batch, sizeof(float), B.data(), 1, d_B, 1));
+
+    // Equally spaced matrices are used in place, reversed order of A is gathered
+    std::vector<float*> a_ptrs, b_ptrs, c_ptrs;
+    for (int i = 0; i < batch; ++i)
+    {
+        a_ptrs.push_back(static_cast<float*>(d_A) + i * size);
+        b_ptrs.push_back(static_cast<float*>(d_B) + i * size);
+        c_ptrs.push_back(static_cast<float*>(d_C) + i * size);
+    }
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSgemmBatched(handle, ICLBLAS_OP_N, ICLBLAS_OP_N, m, n, k, &alpha,
+                                                              a_ptrs.data(), m, b_ptrs.data(), k, &beta,
+                                                              c_ptrs.data(), m, batch));
+        std::vector<float> C(size * batch);
+        ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasGetVector(handle, size * batch, sizeof(float), d_C, 1, C.data(), 1));
+        for (int i = 0; i < batch; ++i)
+        {
+            const int ref = pass == 0 ? i : batch - 1 - i;
+            for (int j = 0; j < size; ++j)
+                EXPECT_NEAR(ref_C[ref * size + j], C[i * size + j], 1e-3f * std::abs(ref_C[ref * size + j]) + 1e-3f);
+        }
+
+        std::reverse(a_ptrs.begin(), a_ptrs.end());
+        std::reverse(b_ptrs.begin(), b_ptrs.end());
+    }
+
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasFree(handle, d_C));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasFree(handle, d_B));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasFree(handle, d_A));
+}
+
+/// Batch of small products computed by single call and by loop of Sgemm calls
+TEST_F(SgemmBatched, benchmark_strided_vs_loop)
+{
+    const int size = 32;
+    const int batch = 1000;
+    const long long stride = size * size;
+    const float alpha = 1.f, beta = 0.f;
+    auto A = sequence(stride * batch, 0.5f);
+    auto B = sequence(stride * batch, 0.25f);
+    std::vector<float> C(stride * batch);
+
+    auto batched = [&]
+    {
+        return iclblasSgemmStridedBatched(handle, ICLBLAS_OP_N, ICLBLAS_OP_N, size, size, size, &alpha,
+                                          A.data(), size, stride, B.data(), size, stride, &beta, C.data(), size, stride, batch);
+    };
+    auto loop = [&]
+    {
+        for (int i = 0; i < batch; ++i)
+        {
+            auto status = iclblasSgemm(handle, ICLBLAS_OP_N, ICLBLAS_OP_N, size, size, size, &alpha, &A[i * stride], size,
+                                       &B[i * stride], size, &beta, &C[i * stride], size);
+            if (status != ICLBLAS_STATUS_SUCCESS)
+                return status;
+        }
+        return ICLBLAS_STATUS_SUCCESS;
+    };
+    auto measure = [](const std::function<iclblasStatus_t()>& func)
+    {
+        auto start = std::chrono::steady_clock::now();
+        EXPECT_EQ(ICLBLAS_STATUS_SUCCESS, func());
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count() / 1e6;
+    };
+
+    // Warm up: builds the modules
+    measure(batched);
+    measure(loop);
+
+    auto batched_time = measure(batched);
+    auto loop_time = measure(loop);
+    std::printf("%d products %dx%d: %.3f ms batched, %.3f ms loop (%.1f GFLOPS batched)\n", batch, size, size,
+                batched_time, loop_time, 2. * size * size * size * batch / batched_time / 1e6);
+}
@@ -0,0 +1,143 @@
+// Copyright (c) 2017-2018 Intel Corporation
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//      http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <iclBLAS.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace
+{
+/// Mixed level 1, 2 and 3 calls with own data of the thread, returns number of wrong results
+int run_mixed_calls(iclblasHandle_t handle, int iterations, int seed)
+{
+    const int n = 64;
+    const float alpha = 1.f, beta = 0.f;
+    std::vector<float> x(n), y(n), A(n * n), B(n * n), C(n * n);
+    int errors = 0;
+    for (int i = 0; i < iterations; ++i)
+    {
+        const float value = static_cast<float>((seed + i) % 7 + 1);
+        std::fill(x.begin(), x.end(), value);
+        std::fill(y.begin(), y.end(), 1.f);
+        std::fill(A.begin(), A.end(), 1.f);
+        std::fill(B.begin(), B.end(), value);
+
+        float dot = 0.f;
+        if (iclblasSaxpy(handle, n, &alpha, x.data(), 1, y.data(), 1) != ICLBLAS_STATUS_SUCCESS
+            || iclblasSdot(handle, n, x.data(), 1, y.data(), 1, &dot) != ICLBLAS_STATUS_SUCCESS
+            || iclblasSgemv(handle, ICLBLAS_OP_N, n, n, &alpha, A.data(), n, x.data(), 1, &beta, y.data(), 1)
+                != ICLBLAS_STATUS_SUCCESS
+            || iclblasSgemm(handle, ICLBLAS_OP_N, ICLBLAS_OP_N, n, n, n, &alpha, A.data(), n, B.data(), n,
+                            &beta, C.data(), n) != ICLBLAS_STATUS_SUCCESS)
+        {
+            ++errors;
+            continue;
+        }
+
+        if (std::fabs(dot - n * value * (value + 1)) > 1e-3f * dot || y[n / 2] != n * value || C[n + 1] != n * value)
+            ++errors;
+    }
+    return errors;
+}
+}
+
+struct SharedHandle : public ::testing::Test
+{
+    void SetUp() override
+    {
+        ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasCreate(&handle));
+    }
+
+    void TearDown() override
+    {
+        ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasDestroy(handle));
+    }
+
+    /// Runs the calls on @p threads_count threads, returns calls per second
+    double run_threads(int threads_count, int iterations)
+    {
+        std::atomic<int> errors{0};
+        std::vector<std::thread> threads;
+        auto start = std::chrono::steady_clock::now();
+        for (int t = 0; t < threads_count; ++t)
+        {
+            threads.emplace_back([&, t]
+            {
+                errors += run_mixed_calls(handle, iterations, t);
+            });
+        }
+        for (auto& thread : threads)
+            thread.join();
+        auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        EXPECT_EQ(0, errors.load()) << threads_count << " threads";
+        return 4. * threads_count * iterations / elapsed;
+    }
+
+    iclblasHandle_t handle;
+};
+
+TEST_F(SharedHandle, concurrent_mixed_calls)
+{
+    run_threads(8, 50);
+}
+
+/// Host-side throughput of the handle shared by threads relative to single thread
+TEST_F(SharedHandle, benchmark_thread_scaling)
+{
+    const int iterations = 100;
+    const int max_threads = static_cast<int>(std::max(std::thread::hardware_concurrency(), 2u));
+
+    // The first calls build kernels
+    run_threads(1, 1);
+    const double single = run_threads(1, iterations);
+    for (int threads_count = 2; threads_count <= max_threads; threads_count *= 2)
+    {
+        const double rate = run_threads(threads_count, iterations);
+        std::printf("%d threads: %.0f calls/s, scaling %.2f\n", threads_count, rate, rate / single);
+    }
+}
+
+/// Handles of the device share OpenCL context and kernels, so creation of another handle is cheap
+TEST_F(SharedHandle, benchmark_handle_creation)
+{
+    const int handles_count = 10;
+    float alpha = 2.f;
+    float x[] = { 1.f, 2.f };
+    float y[] = { 1.f, 1.f };
+
+    std::vector<iclblasHandle_t> handles(handles_count);
+    std::vector<double> times(handles_count);
+    for (int i = 0; i < handles_count; ++i)
+    {
+        // The handle of the fixture stays alive, so the first created one already shares the device
+        auto start = std::chrono::steady_clock::now();
+        ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasCreate(&handles[i]));
+        ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSaxpy(handles[i], 2, &alpha, x, 1, y, 1));
+        times[i] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+    EXPECT_FLOAT_EQ(1.f + 2.f * handles_count, y[0]);
+    EXPECT_FLOAT_EQ(1.f + 4.f * handles_count, y[1]);
+
+    for (auto h : handles)
+        ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasDestroy(h));
+    std::sort(times.begin(), times.end());
+    std::printf("create and first call: min %.3f ms, median %.3f ms, max %.3f ms\n",
+                times.front(), times[handles_count / 2], times.back());
+}
@@ -0,0 +1,170 @@
+// Copyright (c) 2017-2018 Intel Corporation
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//      http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <gtest/gtest.h>
+#include <iclBLAS.h>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+struct Stream : public ::testing::Test
+{
+    void SetUp() override
+    {
+        ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasCreate(&handle));
+        ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasStreamCreate(handle, &stream));
+    }
+
+    void TearDown() override
+    {
+        ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasStreamDestroy(stream));
+        ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasDestroy(handle));
+    }
+
+    iclblasHandle_t handle;
+    iclblasStream_t stream;
+};
+
+TEST_F(Stream, get_set_stream)
+{
+    iclblasStream_t current = stream;
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasGetStream(handle, &current));
+    EXPECT_EQ(nullptr, current);
+
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSetStream(handle, stream));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasGetStream(handle, &current));
+    EXPECT_EQ(stream, current);
+
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSetStream(handle, nullptr));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasGetStream(handle, &current));
+    EXPECT_EQ(nullptr, current);
+}
+
+TEST_F(Stream, stream_of_other_handle)
+{
+    iclblasHandle_t other;
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasCreate(&other));
+    EXPECT_EQ(ICLBLAS_STATUS_INVALID_VALUE, iclblasSetStream(other, stream));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasDestroy(other));
+}
+
+TEST_F(Stream, host_results_feed_next_calls)
+{
+    // Odd size is not zero-copy: results are read back to host memory asynchronously
+    const int n = 37;
+    const int iterations = 10;
+    std::vector<float> x(n, 1.f);
+    std::vector<float> y(n, 0.f);
+    float alpha = 1.f;
+
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSetStream(handle, stream));
+    for (int i = 0; i < iterations; ++i)
+    {
+        ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSaxpy(handle, n, &alpha, x.data(), 1, y.data(), 1));
+        ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSaxpy(handle, n, &alpha, y.data(), 1, x.data(), 1));
+    }
+    float result = 0.f;
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSasum(handle, n, y.data(), 1, &result));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasStreamSynchronize(stream));
+
+    // Fibonacci numbers: y = F(2k), x = F(2k+1)
+    float fx = 1.f, fy = 0.f;
+    for (int i = 0; i < iterations; ++i)
+    {
+        fy += fx;
+        fx += fy;
+    }
+    for (int i = 0; i < n; ++i)
+    {
+        EXPECT_FLOAT_EQ(fy, y[i]);
+        EXPECT_FLOAT_EQ(fx, x[i]);
+    }
+    EXPECT_FLOAT_EQ(fy * n, result);
+}
+
+TEST_F(Stream, event_orders_streams)
+{
+    iclblasStream_t second;
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasStreamCreate(handle, &second));
+    iclblasEvent_t event;
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasEventCreate(&event));
+
+    // Not recorded event is completed
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasEventSynchronize(event));
+
+    const int n = 1024;
+    std::vector<float> x(n, 2.f);
+    float alpha = 3.f;
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSetStream(handle, stream));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSscal(handle, n, &alpha, x.data(), 1));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasEventRecord(event, stream));
+
+    float result = 0.f;
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasStreamWaitEvent(second, event));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSetStream(handle, second));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSasum(handle, n, x.data(), 1, &result));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasStreamSynchronize(second));
+    EXPECT_FLOAT_EQ(6.f * n, result);
+
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasEventSynchronize(event));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSetStream(handle, nullptr));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasEventDestroy(event));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasStreamDestroy(second));
+}
+
+TEST_F(Stream, invalid_arguments)
+{
+    EXPECT_EQ(ICLBLAS_STATUS_INVALID_VALUE, iclblasStreamCreate(handle, nullptr));
+    EXPECT_EQ(ICLBLAS_STATUS_INVALID_VALUE, iclblasGetStream(handle, nullptr));
+    EXPECT_EQ(ICLBLAS_STATUS_INVALID_VALUE, iclblasEventCreate(nullptr));
+}
+
+TEST_F(Stream, benchmark_gemm_sequence)
+{
+    const int n = 256;
+    const int calls = 16;
+    float alpha = 1.f;
+    float beta = 0.f;
+    std::vector<float> A(n * n, 1.f / n);
+    std::vector<float> B(n * n, 1.f);
+    std::vector<std::vector<float>> C(calls, std::vector<float>(n * n, 0.f));
+
+    // First call builds the kernels
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSgemm(handle, ICLBLAS_OP_N, ICLBLAS_OP_N, n, n, n,
+                                                   &alpha, A.data(), n, B.data(), n, &beta, C[0].data(), n));
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (auto& c : C)
+        ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSgemm(handle, ICLBLAS_OP_N, ICLBLAS_OP_N, n, n, n,
+                                                       &alpha, A.data(), n, B.data(), n, &beta, c.data(), n));
+    auto sync_time = std::chrono::high_resolution_clock::now() - start;
+
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSetStream(handle, stream));
+    start = std::chrono::high_resolution_clock::now();
+    for (auto& c : C)
+        ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSgemm(handle, ICLBLAS_OP_N, ICLBLAS_OP_N, n, n, n,
+                                                       &alpha, A.data(), n, B.data(), n, &beta, c.data(), n));
+    auto enqueue_time = std::chrono::high_resolution_clock::now() - start;
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasStreamSynchronize(stream));
+    auto stream_time = std::chrono::high_resolution_clock::now() - start;
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSetStream(handle, nullptr));
+
+    for (auto& c : C)
+        EXPECT_FLOAT_EQ(1.f, c[n * n - 1]);
+
+    using ms = std::chrono::duration<double, std::milli>;
+    std::printf("%d Sgemm %dx%d: synchronous %.3f ms, stream %.3f ms (enqueue %.3f ms)\n", calls, n, n,
+                ms(sync_time).count(), ms(stream_time).count(), ms(enqueue_time).count());
+}
@@ -0,0 +1,178 @@
+// Copyright (c) 2017-2018 Intel Corporation
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//      http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <gtest/gtest.h>
+#include <iclBLAS.h>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+std::vector<float> sequence(size_t size, float scale)
+{
+    std::vector<float> result(size);
+    for (size_t i = 0; i < size; ++i)
+        result[i] = scale * static_cast<float>(i % 11) - 1.f;
+    return result;
+}
+
+// Column-major reference of single batch item
+void reference_gemv(bool trans, int m, int n, float alpha, const float* A, int lda, const float* x, int incx,
+                    float beta, float* y, int incy)
+{
+    const int len_y = trans ? n : m;
+    const int len_x = trans ? m : n;
+    for (int i = 0; i < len_y; ++i)
+    {
+        float value = 0.f;
+        for (int j = 0; j < len_x; ++j)
+            value += (trans ? A[i * lda + j] : A[j * lda + i]) * x[j * incx];
+        y[i * incy] = alpha * value + beta * y[i * incy];
+    }
+}
+
+// Well conditioned triangular matrix with dominant diagonal
+std::vector<float> triangular(int n, int lda, bool lower, int seed)
+{
+    std::vector<float> A(lda * n, 0.f);
+    for (int j = 0; j < n; ++j)
+        for (int i = 0; i < n; ++i)
+        {
+            if (i == j)
+                A[j * lda + i] = 4.f + static_cast<float>((i + seed) % 3);
+            else if (lower == (i > j))
+                A[j * lda + i] = 0.5f / n * static_cast<float>((i * 7 + j + seed) % 5 - 2);
+        }
+    return A;
+}
+}
+
+struct StridedBatched : public ::testing::Test
+{
+    void SetUp() override
+    {
+        ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasCreate(&handle));
+    }
+
+    void TearDown() override
+    {
+        ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasDestroy(handle));
+    }
+
+    void test_gemv(iclblasOperation_t trans, int m, int n, int incx, int incy, int batch)
+    {
+        const bool t = trans != ICLBLAS_OP_N;
+        const int lda = m + 3;
+        const long long stride_a = lda * n;
+        const long long stride_x = (t ? m : n) * incx + 1;
+        const long long stride_y = (t ? n : m) * incy;
+        const float alpha = 0.75f;
+        const float beta = -0.5f;
+
+        auto A = sequence(stride_a * batch, 0.25f);
+        auto x = sequence(stride_x * batch, 0.5f);
+        auto y = sequence(stride_y * batch, 1.f);
+        auto ref_y = y;
+        for (int i = 0; i < batch; ++i)
+            reference_gemv(t, m, n, alpha, &A[i * stride_a], lda, &x[i * stride_x], incx, beta, &ref_y[i * stride_y], incy);
+
+        ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSgemvStridedBatched(handle, trans, m, n, &alpha, A.data(), lda, stride_a,
+                                                                     x.data(), incx, stride_x, &beta,
+                                                                     y.data(), incy, stride_y, batch));
+        for (size_t i = 0; i < y.size(); ++i)
+            EXPECT_NEAR(ref_y[i], y[i], 1e-3f * std::abs(ref_y[i]) + 1e-3f) << "at " << i;
+    }
+
+    void test_trsv(iclblasFillMode_t uplo, iclblasOperation_t trans, iclblasDiagType_t diag, int n, int incx, int batch)
+    {
+        const int lda = n + 1;
+        const long long stride_a = lda * n;
+        const long long stride_x = n * incx;
+
+        std::vector<float> A;
+        for (int i = 0; i < batch; ++i)
+        {
+            auto item = triangular(n, lda, uplo == ICLBLAS_FILL_MODE_LOWER, i);
+            A.insert(A.end(), item.begin(), item.end());
+        }
+        auto ref_x = sequence(stride_x * batch, 0.5f);
+
+        // Right-hand side computed from known solution
+        std::vector<float> b(ref_x.size());
+        for (int i = 0; i < batch; ++i)
+        {
+            auto a = &A[i * stride_a];
+            for (int r = 0; r < n; ++r)
+            {
+                float value = 0.f;
+                for (int c = 0; c < n; ++c)
+                {
+                    float elem = trans == ICLBLAS_OP_N ? a[c * lda + r] : a[r * lda + c];
+                    if (r == c && diag == ICLBLAS_DIAG_UNIT)
+                        elem = 1.f;
+                    value += elem * ref_x[i * stride_x + c * incx];
+                }
+                b[i * stride_x + r * incx] = value;
+            }
+        }
+
+        ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasStrsvStridedBatched(handle, uplo, trans, diag, n, A.data(), lda, stride_a,
+                                                                     b.data(), incx, stride_x, batch));
+        for (size_t i = 0; i < b.size(); ++i)
+            EXPECT_NEAR(ref_x[i], b[i], 1e-3f * std::abs(ref_x[i]) + 1e-3f) << "at " << i;
+    }
+
+    iclblasHandle_t handle;
+};
+
+TEST_F(StridedBatched, sgemv_small)
+{
+    test_gemv(ICLBLAS_OP_N, 5, 7, 1, 1, 30);
+    test_gemv(ICLBLAS_OP_T, 6, 3, 2, 1, 17);
+}
+
+TEST_F(StridedBatched, sgemv_simd16)
+{
+    test_gemv(ICLBLAS_OP_N, 20, 40, 1, 2, 12);
+    test_gemv(ICLBLAS_OP_T, 33, 18, 1, 1, 9);
+}
+
+TEST_F(StridedBatched, strsv_small)
+{
+    test_trsv(ICLBLAS_FILL_MODE_LOWER, ICLBLAS_OP_N, ICLBLAS_DIAG_NON_UNIT, 8, 1, 25);
+    test_trsv(ICLBLAS_FILL_MODE_UPPER, ICLBLAS_OP_T, ICLBLAS_DIAG_UNIT, 6, 2, 11);
+}
+
+TEST_F(StridedBatched, strsv_work_group_per_problem)
+{
+    test_trsv(ICLBLAS_FILL_MODE_LOWER, ICLBLAS_OP_N, ICLBLAS_DIAG_NON_UNIT, 64, 1, 8);
+    test_trsv(ICLBLAS_FILL_MODE_UPPER, ICLBLAS_OP_N, ICLBLAS_DIAG_UNIT, 50, 3, 5);
+}
+
+TEST_F(StridedBatched, invalid_arguments)
+{
+    float alpha = 1.f, beta = 0.f;
+    float A[4] = {}, x[2] = {}, y[2] = {};
+    EXPECT_EQ(ICLBLAS_STATUS_INVALID_VALUE, iclblasSgemvStridedBatched(handle, ICLBLAS_OP_N, 2, 2, &alpha, A, 2, -4,
+                                                                       x, 1, 2, &beta, y, 1, 2, 1));
+    EXPECT_EQ(ICLBLAS_STATUS_INVALID_VALUE, iclblasSgemvStridedBatched(handle, ICLBLAS_OP_N, 2, 2, &alpha, A, 2, 4,
+                                                                       x, 1, 2, &beta, y, 1, 2, -1));
+    EXPECT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSgemvStridedBatched(handle, ICLBLAS_OP_N, 2, 2, &alpha, A, 2, 4,
+                                                                 x, 1, 2, &beta, y, 1, 2, 0));
+    EXPECT_EQ(ICLBLAS_STATUS_INVALID_VALUE, iclblasStrsvStridedBatched(handle, ICLBLAS_FILL_MODE_LOWER, ICLBLAS_OP_N,
+                                                                       ICLBLAS_DIAG_UNIT, 2, A, 2, 4, x, 0, 2, 1));
+    EXPECT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasStrsvStridedBatched(handle, ICLBLAS_FILL_MODE_LOWER, ICLBLAS_OP_N,
+                                                                 ICLBLAS_DIAG_UNIT, 2, A, 2, 4, x, 1, 2, 0));
+}
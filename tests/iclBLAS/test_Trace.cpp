@@ -0,0 +1,52 @@
+// Copyright (c) 2017-2018 Intel Corporation
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//      http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <gtest/gtest.h>
+#include <iclBLAS.h>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+TEST(Trace, saxpy_dispatch_and_kernel)
+{
+    iclblasHandle_t handle;
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasCreate(&handle));
+
+    // Kernel times require profiling
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSetProfiling(handle, 1));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSetTracing(1));
+    float alpha = 2.f;
+    float x[] = { 1.f, 2.f, 3.f, 4.f };
+    float y[] = { 1.f, 1.f, 1.f, 1.f };
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSaxpy(handle, 4, &alpha, x, 1, y, 1));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSetTracing(0));
+
+    const char* file_name = "test_iclBLAS_trace.json";
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasWriteTrace(file_name));
+    std::ifstream file(file_name);
+    std::stringstream content;
+    content << file.rdbuf();
+    file.close();
+    std::remove(file_name);
+
+    auto trace = content.str();
+    EXPECT_NE(std::string::npos, trace.find("\"name\":\"Saxpy\",\"cat\":\"function\""));
+    EXPECT_NE(std::string::npos, trace.find("\"cat\":\"kernel\""));
+    EXPECT_NE(std::string::npos, trace.find("\"function\":\"Saxpy\""));
+
+    EXPECT_EQ(ICLBLAS_STATUS_INVALID_VALUE, iclblasWriteTrace(nullptr));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasDestroy(handle));
+}
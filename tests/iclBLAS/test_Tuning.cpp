@@ -0,0 +1,52 @@
+// Copyright (c) 2017-2018 Intel Corporation
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//      http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <gtest/gtest.h>
+#include <iclBLAS.h>
+#include <vector>
+
+TEST(Tuning, selection_keeps_results)
+{
+    iclblasHandle_t handle;
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasCreate(&handle));
+
+    int enabled = 0;
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSetTuning(handle, 1));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasGetTuning(handle, &enabled));
+    EXPECT_NE(0, enabled);
+
+    const int m = 64, n = 48, k = 32;
+    float alpha = 1.f;
+    float beta = 0.f;
+    std::vector<float> A(m * k, 1.f);
+    std::vector<float> B(k * n, 2.f);
+
+    // Enough calls to measure every implementation and then run the fastest one
+    for (int call = 0; call < 16; ++call)
+    {
+        std::vector<float> C(m * n, -1.f);
+        ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSgemm(handle, ICLBLAS_OP_N, ICLBLAS_OP_N, m, n, k,
+                                                       &alpha, A.data(), m, B.data(), k, &beta, C.data(), m));
+        for (auto v : C)
+            ASSERT_FLOAT_EQ(2.f * k, v) << "call " << call;
+    }
+
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSetTuning(handle, 0));
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasGetTuning(handle, &enabled));
+    EXPECT_EQ(0, enabled);
+    EXPECT_EQ(ICLBLAS_STATUS_INVALID_VALUE, iclblasGetTuning(handle, nullptr));
+
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasDestroy(handle));
+}
@@ -0,0 +1,95 @@
+// Copyright (c) 2017-2018 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <iclBLAS.h>
+#include <string>
+#include <vector>
+
+static std::vector<iclblasModuleBuildInfo_t> get_build_info(iclblasHandle_t handle)
+{
+    int count = 0;
+    EXPECT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasGetModuleBuildInfo(handle, nullptr, &count));
+    std::vector<iclblasModuleBuildInfo_t> info(count);
+    EXPECT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasGetModuleBuildInfo(handle, info.data(), &count));
+    info.resize(count);
+    return info;
+}
+
+TEST(Warmup, saxpy_modules_built_in_background)
+{
+    iclblasHandle_t handle;
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasCreate(&handle));
+
+    const char* functions[] = { "Saxpy", nullptr };
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasWarmup(handle, functions, ICLBLAS_WARMUP_WAIT));
+
+    auto info = get_build_info(handle);
+    EXPECT_FALSE(info.empty());
+    for (auto& i : info)
+    {
+        EXPECT_EQ(0u, std::string(i.module).find("Saxpy_"));
+        EXPECT_NE(0, i.background);
+        EXPECT_GE(i.build_time, 0.);
+    }
+
+    // Call should reuse warmed-up module, no new builds expected
+    float alpha = 2.f;
+    float x[] = { 1.f, 2.f, 3.f, 4.f };
+    float y[] = { 1.f, 1.f, 1.f, 1.f };
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSaxpy(handle, 4, &alpha, x, 1, y, 1));
+    EXPECT_FLOAT_EQ(3.f, y[0]);
+    EXPECT_FLOAT_EQ(9.f, y[3]);
+    EXPECT_EQ(info.size(), get_build_info(handle).size());
+
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasDestroy(handle));
+}
+
+TEST(Warmup, call_waits_for_background_build)
+{
+    iclblasHandle_t handle;
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasCreate(&handle));
+
+    const char* functions[] = { "iclblasSgemm", "Saxpy", nullptr };
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasWarmup(handle, functions, ICLBLAS_WARMUP_ASYNC));
+
+    float alpha = 2.f;
+    float x[] = { 1.f, 2.f };
+    float y[] = { 1.f, 1.f };
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasSaxpy(handle, 2, &alpha, x, 1, y, 1));
+    EXPECT_FLOAT_EQ(3.f, y[0]);
+    EXPECT_FLOAT_EQ(5.f, y[1]);
+
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasWarmup(handle, functions, ICLBLAS_WARMUP_WAIT));
+
+    // Every module is built exactly once
+    auto info = get_build_info(handle);
+    for (size_t i = 0; i < info.size(); ++i)
+        for (size_t j = i + 1; j < info.size(); ++j)
+            EXPECT_NE(std::string(info[i].module), std::string(info[j].module));
+
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasDestroy(handle));
+}
+
+TEST(Warmup, unknown_function)
+{
+    iclblasHandle_t handle;
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasCreate(&handle));
+
+    const char* functions[] = { "Sfoo", nullptr };
+    EXPECT_EQ(ICLBLAS_STATUS_INVALID_VALUE, iclblasWarmup(handle, functions, ICLBLAS_WARMUP_WAIT));
+    EXPECT_EQ(ICLBLAS_STATUS_INVALID_VALUE, iclblasWarmup(handle, nullptr, 42));
+
+    ASSERT_EQ(ICLBLAS_STATUS_SUCCESS, iclblasDestroy(handle));
+}